@@ -0,0 +1,184 @@
+/*!*****************************************************************************
+ * @file    XCAN_DescCRC_Bench.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN descriptors 9-bits CRC benchmark
+ * @details
+ * Standalone host program: check that every entry of the lookup tables (and
+ *   of the folding constants) equals the bitwise CRC of its index, check that
+ *   XCAN_ComputeDescCRC9() gives the same CRC as the bitwise reference
+ *   XCAN_ComputeDescCRC9_Bitwise() on random TX (8 words) and RX (4 words)
+ *   descriptors, then time both functions.
+ * The driver source is included to reach its static tables, build it alone
+ *   with the same Conf_XCAN.h as the target, e.g.:
+ *   cc -O2 -I<conf> -I.. XCAN_DescCRC_Bench.c
+ *   (add -DXCAN_DESC_CRC_USE_CLMUL -mpclmul to time the carry-less multiply)
+ * The program returns 0 if all the tables entries and CRCs are equal
+ ******************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "XCAN_DescCRC.c" // Include the source to check its static tables
+#include <stdio.h>
+#include <time.h>
+//-----------------------------------------------------------------------------
+
+#define XCAN_BENCH_DESC_COUNT   ( 1024u )  //!< Count of random descriptors of each size
+#define XCAN_BENCH_CHECK_COUNT  ( 100000u ) //!< Count of random descriptors compared with the reference
+#define XCAN_BENCH_LOOPS        ( 2000u )  //!< Count of passes over the descriptors for the timing
+#define XCAN_BENCH_MAX_WORDS    ( 8u )     //!< Words of the largest descriptor
+
+//! CRC function under test
+typedef uint16_t (*XCAN_BenchCRC_Func)(const uint32_t* data, size_t count);
+
+static uint32_t XCAN_BenchDesc[XCAN_BENCH_DESC_COUNT][XCAN_BENCH_MAX_WORDS];
+static volatile uint16_t XCAN_BenchSink; //!< Keep the computed CRCs alive
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// [STATIC] Get a pseudo random word (xorshift32)
+//=============================================================================
+static uint32_t __XCAN_BenchRandom(void)
+{
+  static uint32_t State = 0x2545F491u;
+  State ^= State << 13;
+  State ^= State >> 17;
+  State ^= State << 5;
+  return State;
+}
+
+
+
+//=============================================================================
+// [STATIC] Fill a descriptor with random words, the CRC bit field cleared
+//=============================================================================
+static void __XCAN_BenchFillDesc(uint32_t* pDesc, size_t count)
+{
+  for (size_t zWord = 0; zWord < count; ++zWord) pDesc[zWord] = __XCAN_BenchRandom();
+  pDesc[0] &= ~XCAN_DESC_CRC9_Mask;                                                        // The CRC field of the first word shall be 0
+}
+
+
+
+//=============================================================================
+// [STATIC] Compare the CRC function with the reference on random descriptors
+//=============================================================================
+static size_t __XCAN_BenchCheck(size_t count)
+{
+  uint32_t Desc[XCAN_BENCH_MAX_WORDS];
+  size_t Errors = 0;
+  for (size_t zDesc = 0; zDesc < XCAN_BENCH_CHECK_COUNT; ++zDesc)
+  {
+    __XCAN_BenchFillDesc(&Desc[0], count);
+    if (XCAN_ComputeDescCRC9(&Desc[0], count) != XCAN_ComputeDescCRC9_Bitwise(&Desc[0], count)) ++Errors;
+  }
+  for (uint32_t zBit = 0; zBit < (count * 32u); ++zBit)                                   // Single bit descriptors, each bit of each word
+  {
+    for (size_t zWord = 0; zWord < count; ++zWord) Desc[zWord] = 0;
+    Desc[zBit / 32u] = (1u << (zBit % 32u));
+    if (XCAN_ComputeDescCRC9(&Desc[0], count) != XCAN_ComputeDescCRC9_Bitwise(&Desc[0], count)) ++Errors;
+  }
+  return Errors;
+}
+
+
+
+//=============================================================================
+// [STATIC] Check each entry of a lookup table with the bitwise CRC of its index
+//=============================================================================
+static size_t __XCAN_BenchCheckTable(const uint16_t* pTable, size_t bytePos)
+{
+  size_t Errors = 0;
+  for (uint32_t zIdx = 0; zIdx < 256u; ++zIdx)
+  {
+    uint32_t Desc[2] = { 0, 0 };                                                             // Tk[i] = (i.x^(8k+9)) mod P: the index at byte k from the end of a 2 words descriptor
+    Desc[1u - (bytePos / 4u)] = (zIdx << ((bytePos % 4u) * 8u));
+    if (pTable[zIdx] != XCAN_ComputeDescCRC9_Bitwise(&Desc[0], 2)) ++Errors;
+  }
+  printf("TABLE%u: %u mismatch\n", (unsigned)bytePos, (unsigned)Errors);
+  return Errors;
+}
+
+
+
+#ifdef XCAN_DESC_CRC_CLMUL_AVAILABLE
+//=============================================================================
+// [STATIC] Check the folding constants with the bitwise CRC of x^(32p)
+//=============================================================================
+static size_t __XCAN_BenchCheckFold(void)
+{
+  uint32_t Desc[XCAN_DESC_CRC_CLMUL_MAX_WORDS] = { 1u };                                   // FOLD[p] = x^(32p+9) mod P: a 1 followed by p zero words
+  size_t Errors = 0;
+  for (size_t zPos = 0; zPos < XCAN_DESC_CRC_CLMUL_MAX_WORDS; ++zPos)
+    if (XCAN_DESC_CRC9_FOLD[zPos] != XCAN_ComputeDescCRC9_Bitwise(&Desc[0], zPos + 1u)) ++Errors;
+  printf("FOLD: %u mismatch\n", (unsigned)Errors);
+  return Errors;
+}
+#endif
+
+
+
+//=============================================================================
+// [STATIC] Time a CRC function over the descriptors, in nanoseconds per descriptor
+//=============================================================================
+static double __XCAN_BenchTime(XCAN_BenchCRC_Func fnCRC, size_t count)
+{
+  uint16_t Sum = 0;
+  const clock_t Start = clock();
+  for (uint32_t zLoop = 0; zLoop < XCAN_BENCH_LOOPS; ++zLoop)
+    for (size_t zDesc = 0; zDesc < XCAN_BENCH_DESC_COUNT; ++zDesc) Sum ^= fnCRC(&XCAN_BenchDesc[zDesc][0], count);
+  const clock_t Stop = clock();
+  XCAN_BenchSink = Sum;
+  return ((double)(Stop - Start) * 1.0e9) / ((double)CLOCKS_PER_SEC * XCAN_BENCH_LOOPS * XCAN_BENCH_DESC_COUNT);
+}
+
+
+
+//=============================================================================
+// Descriptors CRC benchmark
+//=============================================================================
+int main(void)
+{
+  static const size_t DescWords[] = { 8u, 4u };                                            // TX descriptors then RX descriptors
+  size_t Errors = 0;
+
+  //--- Lookup tables and constants ---
+  Errors += __XCAN_BenchCheckTable(&XCAN_DESC_CRC9_TABLE0[0], 0);
+#if (XCAN_DESC_CRC_SLICE >= 4)
+  Errors += __XCAN_BenchCheckTable(&XCAN_DESC_CRC9_TABLE1[0], 1);
+  Errors += __XCAN_BenchCheckTable(&XCAN_DESC_CRC9_TABLE2[0], 2);
+  Errors += __XCAN_BenchCheckTable(&XCAN_DESC_CRC9_TABLE3[0], 3);
+#endif
+#if (XCAN_DESC_CRC_SLICE >= 8)
+  Errors += __XCAN_BenchCheckTable(&XCAN_DESC_CRC9_TABLE4[0], 4);
+  Errors += __XCAN_BenchCheckTable(&XCAN_DESC_CRC9_TABLE5[0], 5);
+  Errors += __XCAN_BenchCheckTable(&XCAN_DESC_CRC9_TABLE6[0], 6);
+  Errors += __XCAN_BenchCheckTable(&XCAN_DESC_CRC9_TABLE7[0], 7);
+#endif
+#ifdef XCAN_DESC_CRC_CLMUL_AVAILABLE
+  Errors += __XCAN_BenchCheckFold();
+#endif
+
+  for (size_t zSize = 0; zSize < (sizeof(DescWords) / sizeof(DescWords[0])); ++zSize)
+  {
+    const size_t Count = DescWords[zSize];
+    for (size_t zDesc = 0; zDesc < XCAN_BENCH_DESC_COUNT; ++zDesc) __XCAN_BenchFillDesc(&XCAN_BenchDesc[zDesc][0], Count);
+
+    //--- Equivalence with the reference ---
+    const size_t SizeErrors = __XCAN_BenchCheck(Count);
+    Errors += SizeErrors;
+
+    //--- Timing ---
+    const double BitwiseNs = __XCAN_BenchTime(XCAN_ComputeDescCRC9_Bitwise, Count);
+    const double FastNs    = __XCAN_BenchTime(XCAN_ComputeDescCRC9, Count);
+    printf("%u words: %u mismatch, bitwise %.1f ns, XCAN_ComputeDescCRC9 %.1f ns, speedup x%.1f\n",
+           (unsigned)Count, (unsigned)SizeErrors, BitwiseNs, FastNs, (FastNs > 0.0 ? BitwiseNs / FastNs : 0.0));
+  }
+  return (Errors == 0 ? 0 : 1);
+}
@@ -0,0 +1,241 @@
+/*!*****************************************************************************
+ * @file    XCAN_FilterCompiler_Bench.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN RX filter elements table compiler check
+ * @details
+ * Standalone host program: compile random subscriptions (exact IDs, ranges,
+ *   masks, black lists, standard and extended IDs) with XCAN_CompileRxFilters()
+ *   and compare, for every standard ID and every extended ID of a window,
+ *   XCAN_MatchRxFilters() on the table with a brute-force match of the
+ *   subscriptions:
+ *   - an ID subscribed on 2 RX FIFO Queues (or black listed on 2 RX FIFO
+ *     Queues) shall give ERR__CONFIGURATION, and only such an ID
+ *   - a black listed ID shall match a black list element
+ *   - an accepted ID shall match an element of its RX FIFO Queue
+ *   - an ID not subscribed shall match no element for an exact table, and
+ *     the IDs accepted by the merges shall not exceed the extra IDs reported
+ *     for a table compiled with MaxExtraIDs
+ *   then time the compilation.
+ * Build it with the driver and the same Conf_XCAN.h as the target, e.g.:
+ *   cc -O2 -I<conf> -I.. XCAN_FilterCompiler_Bench.c ../XCAN_FilterCompiler.c
+ * The program returns 0 if all the tables match the subscriptions
+ ******************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "XCAN_FilterCompiler.h"
+#include <stdio.h>
+#include <time.h>
+//-----------------------------------------------------------------------------
+
+#define XCAN_BENCH_TABLES       ( 20000u )      //!< Count of random subscription lists checked
+#define XCAN_BENCH_MAX_SUBS     ( 24u )         //!< Maximum count of subscriptions of a list
+#define XCAN_BENCH_ID_WINDOW    ( 0x800u )      //!< IDs checked: all the standard IDs, and this count of extended IDs from XCAN_BENCH_EXT_BASE
+#define XCAN_BENCH_EXT_BASE     ( 0x12345800u ) //!< First extended ID checked, aligned on XCAN_BENCH_ID_WINDOW
+#define XCAN_BENCH_REGION_SIZE  ( XCAN_BENCH_ID_WINDOW / XCAN_FIFO_QUEUE_COUNT ) //!< IDs of the region of each RX FIFO Queue, to get lists without conflict
+#define XCAN_BENCH_MAX_EXTRA    ( 512u )        //!< MaxExtraIDs of the lossy tables
+#define XCAN_BENCH_TIME_LOOPS   ( 200u )        //!< Count of compilations of each list for the timing
+
+static XCAN_RxSubscription XCAN_BenchSubs[XCAN_BENCH_MAX_SUBS];
+static XCAN_RxFilterRange XCAN_BenchWork[XCAN_BENCH_MAX_SUBS];
+static XCAN_RxFilterElement XCAN_BenchElements[XCAN_RX_FILTER_MAX_ELEMENTS];
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// [STATIC] Get a pseudo random word (xorshift32)
+//=============================================================================
+static uint32_t __XCAN_BenchRandom(void)
+{
+  static uint32_t State = 0x6C078965u;
+  State ^= State << 13;
+  State ^= State >> 17;
+  State ^= State << 5;
+  return State;
+}
+
+
+
+//=============================================================================
+// [STATIC] Fill a random subscriptions list, the IDs of each RX FIFO Queue in its own region if regions is 'true'
+//=============================================================================
+static size_t __XCAN_BenchFillSubscriptions(bool regions)
+{
+  const size_t Count = 1u + (__XCAN_BenchRandom() % XCAN_BENCH_MAX_SUBS);
+  for (size_t zSub = 0; zSub < Count; ++zSub)
+  {
+    XCAN_RxSubscription* pSub = &XCAN_BenchSubs[zSub];
+    const uint32_t Kind = __XCAN_BenchRandom() % 20u;
+    pSub->Queue     = (eXCAN_FIFOQueue)(__XCAN_BenchRandom() % XCAN_FIFO_QUEUE_COUNT);
+    pSub->Extended  = ((__XCAN_BenchRandom() % 4u) == 0);
+    pSub->BlackList = ((__XCAN_BenchRandom() % 10u) == 0);
+    const uint32_t Span  = (regions ? XCAN_BENCH_REGION_SIZE : XCAN_BENCH_ID_WINDOW);
+    const uint32_t Base  = (pSub->Extended ? XCAN_BENCH_EXT_BASE : 0u) + (regions ? ((uint32_t)pSub->Queue * XCAN_BENCH_REGION_SIZE) : 0u);
+    const uint32_t Fixed = (pSub->Extended ? (XCAN_RX_FILTER_EID_MAX & ~(XCAN_BENCH_ID_WINDOW - 1u)) : 0u) | (XCAN_BENCH_ID_WINDOW - Span); // Mask bits keeping the IDs in the region
+    pSub->ID1 = Base + (__XCAN_BenchRandom() % Span);
+    if (Kind < 8u)                                                                         // Exact ID
+    {
+      pSub->Type = XCAN_RX_FILTER_EXACT;
+      pSub->ID2  = 0;
+    }
+    else if (Kind < 15u)                                                                   // Range of up to 64 IDs in the region
+    {
+      pSub->Type = XCAN_RX_FILTER_RANGE;
+      pSub->ID2  = pSub->ID1 + (__XCAN_BenchRandom() % 64u);
+      if (pSub->ID2 > (Base + Span - 1u)) pSub->ID2 = Base + Span - 1u;
+    }
+    else                                                                                   // Mask with random checked bits in the region
+    {
+      pSub->Type = XCAN_RX_FILTER_MASK;
+      pSub->ID2  = Fixed | (__XCAN_BenchRandom() & (Span - 1u) & (__XCAN_BenchRandom() | __XCAN_BenchRandom()));
+    }
+  }
+  return Count;
+}
+
+
+
+//=============================================================================
+// [STATIC] Check if a subscription matches an ID
+//=============================================================================
+static bool __XCAN_BenchSubscriptionMatch(const XCAN_RxSubscription* pSub, bool extended, uint32_t id)
+{
+  if (pSub->Extended != extended) return false;
+  switch (pSub->Type)
+  {
+    case XCAN_RX_FILTER_EXACT: return (id == pSub->ID1);
+    case XCAN_RX_FILTER_RANGE: return (id >= pSub->ID1) && (id <= pSub->ID2);
+    default                  : return ((id & pSub->ID2) == (pSub->ID1 & pSub->ID2));
+  }
+}
+
+
+
+//=============================================================================
+// [STATIC] Get the expected RX FIFO Queues of an ID: accepted and black listed (-1 if none), 'false' if the ID is on 2 RX FIFO Queues
+//=============================================================================
+static bool __XCAN_BenchExpected(size_t count, bool extended, uint32_t id, int* pAccepted, int* pBlackList)
+{
+  *pAccepted = -1;
+  *pBlackList = -1;
+  for (size_t zSub = 0; zSub < count; ++zSub)
+  {
+    const XCAN_RxSubscription* pSub = &XCAN_BenchSubs[zSub];
+    if (__XCAN_BenchSubscriptionMatch(pSub, extended, id) == false) continue;
+    int* pQueue = (pSub->BlackList ? pBlackList : pAccepted);
+    if ((*pQueue >= 0) && (*pQueue != (int)pSub->Queue)) return false;
+    *pQueue = (int)pSub->Queue;
+  }
+  return true;
+}
+
+
+
+//=============================================================================
+// [STATIC] Compile a subscriptions list and compare the table with the subscriptions, return the count of errors
+//=============================================================================
+static size_t __XCAN_BenchCheckTable(size_t count, size_t maxElements, uint32_t maxExtraIDs, size_t* pConflicts, size_t* pFull)
+{
+  const XCAN_RxFilterCompilerConfig Conf = { &XCAN_BenchSubs[0], count, &XCAN_BenchWork[0], maxExtraIDs };
+  size_t ElementCount = 0;
+  uint32_t ExtraIDs = 0;
+  const eERRORRESULT Error = XCAN_CompileRxFilters(&Conf, &XCAN_BenchElements[0], maxElements, &ElementCount, &ExtraIDs);
+
+  //--- Conflicts ---
+  bool Conflict = false;
+  for (uint32_t zID = 0; (zID < (2u * XCAN_BENCH_ID_WINDOW)) && (Conflict == false); ++zID)
+  {
+    const bool Extended = (zID >= XCAN_BENCH_ID_WINDOW);
+    const uint32_t ID = (Extended ? XCAN_BENCH_EXT_BASE + zID - XCAN_BENCH_ID_WINDOW : zID);
+    int Accepted, BlackList;
+    Conflict = (__XCAN_BenchExpected(count, Extended, ID, &Accepted, &BlackList) == false);
+  }
+  if (Conflict)
+  {
+    ++(*pConflicts);
+    if (Error == ERR__CONFIGURATION) return 0;
+    printf("Conflict not detected: %u subscriptions, error %d\n", (unsigned)count, (int)Error);
+    return 1;
+  }
+  if (Error == ERR__BUFFER_FULL) { ++(*pFull); return ((maxExtraIDs > 0) && (ElementCount > maxElements) ? 0 : 1); }
+  if (Error != ERR_OK) { printf("Compile error %d: %u subscriptions\n", (int)Error, (unsigned)count); return 1; }
+
+  //--- Match each ID ---
+  size_t Errors = 0;
+  uint32_t Unsubscribed = 0;
+  for (uint32_t zID = 0; zID < (2u * XCAN_BENCH_ID_WINDOW); ++zID)
+  {
+    const bool Extended = (zID >= XCAN_BENCH_ID_WINDOW);
+    const uint32_t ID = (Extended ? XCAN_BENCH_EXT_BASE + zID - XCAN_BENCH_ID_WINDOW : zID);
+    int Accepted, BlackList;
+    (void)__XCAN_BenchExpected(count, Extended, ID, &Accepted, &BlackList);
+    uint8_t Index;
+    const bool Match = (XCAN_MatchRxFilters(&XCAN_BenchElements[0], ElementCount, Extended, ID, &Index) == ERR_OK);
+    bool Same = true;
+    if (BlackList >= 0) Same = Match && XCAN_BenchElements[Index].BlackList;
+    else if (Accepted >= 0) Same = Match && (XCAN_BenchElements[Index].BlackList == false) && ((int)XCAN_BenchElements[Index].Queue == Accepted);
+    else if (Match) ++Unsubscribed;                                                        // Accepted or black listed by a merge of ranges
+    if (Same == false)
+    {
+      ++Errors;
+      printf("Mismatch: %u subscriptions, %s ID 0x%08X, expected queue %d (black list %d)\n", (unsigned)count, (Extended ? "extended" : "standard"), (unsigned)ID, Accepted, BlackList);
+    }
+  }
+  if ((Unsubscribed > ExtraIDs) || (ExtraIDs > maxExtraIDs))
+  {
+    ++Errors;
+    printf("Extra IDs: %u subscriptions, %u IDs not subscribed matched, %u reported, %u allowed\n", (unsigned)count, (unsigned)Unsubscribed, (unsigned)ExtraIDs, (unsigned)maxExtraIDs);
+  }
+  return Errors;
+}
+
+
+
+//=============================================================================
+// [STATIC] Time the compilation of random subscriptions lists, in microseconds per table
+//=============================================================================
+static double __XCAN_BenchTime(void)
+{
+  size_t ElementCount;
+  uint32_t ExtraIDs;
+  clock_t Elapsed = 0;
+  for (uint32_t zTable = 0; zTable < (XCAN_BENCH_TABLES / 100u); ++zTable)
+  {
+    const size_t Count = __XCAN_BenchFillSubscriptions(true);
+    const XCAN_RxFilterCompilerConfig Conf = { &XCAN_BenchSubs[0], Count, &XCAN_BenchWork[0], XCAN_BENCH_MAX_EXTRA };
+    const clock_t Start = clock();
+    for (uint32_t zLoop = 0; zLoop < XCAN_BENCH_TIME_LOOPS; ++zLoop)
+      (void)XCAN_CompileRxFilters(&Conf, &XCAN_BenchElements[0], 1u + (Count / 2u), &ElementCount, &ExtraIDs);
+    Elapsed += clock() - Start;
+  }
+  return ((double)Elapsed * 1.0e6) / ((double)CLOCKS_PER_SEC * (XCAN_BENCH_TABLES / 100u) * XCAN_BENCH_TIME_LOOPS);
+}
+
+
+
+//=============================================================================
+// RX filter elements table compiler check
+//=============================================================================
+int main(void)
+{
+  size_t Errors = 0, Conflicts = 0, Full = 0;
+
+  //--- Exact tables, then tables compiled in fewer elements ---
+  for (uint32_t zTable = 0; zTable < XCAN_BENCH_TABLES; ++zTable)
+  {
+    const size_t Count = __XCAN_BenchFillSubscriptions((zTable % 4u) != 0);               // Most lists without conflict, to check the tables
+    Errors += __XCAN_BenchCheckTable(Count, XCAN_RX_FILTER_MAX_ELEMENTS, 0, &Conflicts, &Full);
+    Errors += __XCAN_BenchCheckTable(Count, 1u + (__XCAN_BenchRandom() % Count), XCAN_BENCH_MAX_EXTRA, &Conflicts, &Full);
+  }
+  printf("%u tables: %u mismatch, %u with conflict, %u not fitting\n", (unsigned)(2u * XCAN_BENCH_TABLES), (unsigned)Errors, (unsigned)Conflicts, (unsigned)Full);
+
+  //--- Timing ---
+  printf("Up to %u subscriptions: XCAN_CompileRxFilters %.2f us per table\n", (unsigned)XCAN_BENCH_MAX_SUBS, __XCAN_BenchTime());
+  return (Errors == 0 ? 0 : 1);
+}
@@ -0,0 +1,144 @@
+/*!*****************************************************************************
+ * @file    XCAN_HeaderDecoder_Bench.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN RX message headers batch decoder benchmark
+ * @details
+ * Standalone host program: check that XCAN_DecodeRxHeaders() gives the same
+ *   arrays as the scalar reference XCAN_DecodeRxHeaders_Scalar() on random
+ *   headers, for every batch size from 0 to 67 headers (tails of the 8 by 8
+ *   kernels) and with unaligned headers and arrays, then time both functions.
+ * Build it with the driver and the same Conf_XCAN.h as the target, e.g.:
+ *   cc -O2 -I<conf> -I.. XCAN_HeaderDecoder_Bench.c ../XCAN_HeaderDecoder.c
+ *   (add -DXCAN_HEADER_DECODER_USE_SIMD and -msse2, -mavx2 or the NEON flags
+ *   to time a SIMD kernel)
+ * The program returns 0 if all the decoded headers are equal
+ ******************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "XCAN_HeaderDecoder.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+//-----------------------------------------------------------------------------
+
+#define XCAN_BENCH_MAX_BATCH    ( 67u )   //!< Largest batch checked, not a multiple of 8
+#define XCAN_BENCH_OFFSET_COUNT ( 4u )    //!< Offsets in bytes of the headers and of the arrays checked (0 is aligned)
+#define XCAN_BENCH_TIME_BATCH   ( 1021u ) //!< Headers per timed batch, not a multiple of 8
+#define XCAN_BENCH_LOOPS        ( 20000u ) //!< Count of timed batches
+
+//! Decoder function under test
+typedef eERRORRESULT (*XCAN_BenchDecode_Func)(const uint32_t* pHeaders, size_t count, const XCAN_RxHeaderArrays* pOut);
+
+//! Decoded arrays storage, with room to move the arrays off their alignment
+typedef struct XCAN_BenchArrays
+{
+  uint32_t ID[XCAN_BENCH_TIME_BATCH + 1u];
+  uint16_t DLC[XCAN_BENCH_TIME_BATCH + 1u];
+  uint16_t Flags[XCAN_BENCH_TIME_BATCH + 1u];
+  uint8_t FIDX[XCAN_BENCH_TIME_BATCH + 1u];
+} XCAN_BenchArrays;
+
+static uint32_t XCAN_BenchHeaders[(2u * XCAN_BENCH_TIME_BATCH) + 1u];
+static XCAN_BenchArrays XCAN_BenchRef, XCAN_BenchOut;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// [STATIC] Get a pseudo random word (xorshift32)
+//=============================================================================
+static uint32_t __XCAN_BenchRandom(void)
+{
+  static uint32_t State = 0x9E3779B9u;
+  State ^= State << 13;
+  State ^= State >> 17;
+  State ^= State << 5;
+  return State;
+}
+
+
+
+//=============================================================================
+// [STATIC] Get the decoder arrays of a storage, moved by an offset of elements
+//=============================================================================
+static XCAN_RxHeaderArrays __XCAN_BenchGetArrays(XCAN_BenchArrays* pArrays, size_t offset)
+{
+  XCAN_RxHeaderArrays Arrays = { &pArrays->ID[offset], &pArrays->DLC[offset], &pArrays->Flags[offset], &pArrays->FIDX[offset] };
+  return Arrays;
+}
+
+
+
+//=============================================================================
+// [STATIC] Compare the decoder with the scalar reference on every batch size and alignment
+//=============================================================================
+static size_t __XCAN_BenchCheck(void)
+{
+  uint8_t Raw[(2u * XCAN_BENCH_MAX_BATCH * sizeof(uint32_t)) + XCAN_BENCH_OFFSET_COUNT + sizeof(uint32_t)];
+  size_t Errors = 0;
+  for (size_t zCount = 0; zCount <= XCAN_BENCH_MAX_BATCH; ++zCount)
+    for (size_t zOffset = 0; zOffset < XCAN_BENCH_OFFSET_COUNT; ++zOffset)
+    {
+      //--- Random headers, unaligned when zOffset is not 0 ---
+      uint32_t* pHeaders = (uint32_t*)((uintptr_t)&Raw[sizeof(uint32_t) - 1u] & ~(uintptr_t)(sizeof(uint32_t) - 1u)); // Aligned base
+      uint32_t Aligned[2u * XCAN_BENCH_MAX_BATCH];
+      for (size_t zWord = 0; zWord < (2u * zCount); ++zWord) Aligned[zWord] = __XCAN_BenchRandom();
+      pHeaders = (uint32_t*)((uint8_t*)pHeaders + zOffset);
+      memcpy(pHeaders, &Aligned[0], 2u * zCount * sizeof(uint32_t));
+
+      //--- Decode and compare ---
+      const XCAN_RxHeaderArrays Ref = __XCAN_BenchGetArrays(&XCAN_BenchRef, 0);
+      const XCAN_RxHeaderArrays Out = __XCAN_BenchGetArrays(&XCAN_BenchOut, zOffset % 2u);  // Arrays aligned or moved by one element
+      memset(&XCAN_BenchOut, 0xA5, sizeof(XCAN_BenchOut));
+      if (XCAN_DecodeRxHeaders_Scalar(&Aligned[0], zCount, &Ref) != ERR_OK) ++Errors;
+      if (XCAN_DecodeRxHeaders(pHeaders, zCount, &Out) != ERR_OK) ++Errors;
+      for (size_t zHeader = 0; zHeader < zCount; ++zHeader)
+      {
+        const bool Same = (Ref.ID[zHeader] == Out.ID[zHeader]) && (Ref.DLC[zHeader] == Out.DLC[zHeader])
+                       && (Ref.Flags[zHeader] == Out.Flags[zHeader]) && (Ref.FIDX[zHeader] == Out.FIDX[zHeader]);
+        if (Same == false) { ++Errors; printf("Mismatch: count %u, offset %u, header %u\n", (unsigned)zCount, (unsigned)zOffset, (unsigned)zHeader); }
+      }
+      if (Out.ID[zCount] != 0xA5A5A5A5u) { ++Errors; printf("Overflow: count %u, offset %u\n", (unsigned)zCount, (unsigned)zOffset); } // Nothing written after the batch
+    }
+  return Errors;
+}
+
+
+
+//=============================================================================
+// [STATIC] Time a decoder function, in nanoseconds per header
+//=============================================================================
+static double __XCAN_BenchTime(XCAN_BenchDecode_Func fnDecode, const uint32_t* pHeaders)
+{
+  const XCAN_RxHeaderArrays Out = __XCAN_BenchGetArrays(&XCAN_BenchOut, 1u);              // Arrays not aligned on a SIMD register
+  const clock_t Start = clock();
+  for (uint32_t zLoop = 0; zLoop < XCAN_BENCH_LOOPS; ++zLoop) (void)fnDecode(pHeaders, XCAN_BENCH_TIME_BATCH, &Out);
+  const clock_t Stop = clock();
+  return ((double)(Stop - Start) * 1.0e9) / ((double)CLOCKS_PER_SEC * XCAN_BENCH_LOOPS * XCAN_BENCH_TIME_BATCH);
+}
+
+
+
+//=============================================================================
+// RX message headers decoder benchmark
+//=============================================================================
+int main(void)
+{
+  //--- Equivalence with the reference ---
+  const size_t Errors = __XCAN_BenchCheck();
+  printf("Batches of 0 to %u headers, %u alignments: %u mismatch\n", (unsigned)XCAN_BENCH_MAX_BATCH, (unsigned)XCAN_BENCH_OFFSET_COUNT, (unsigned)Errors);
+
+  //--- Timing on headers moved by one word ---
+  for (size_t zWord = 0; zWord < (sizeof(XCAN_BenchHeaders) / sizeof(XCAN_BenchHeaders[0])); ++zWord) XCAN_BenchHeaders[zWord] = __XCAN_BenchRandom();
+  const double ScalarNs = __XCAN_BenchTime(XCAN_DecodeRxHeaders_Scalar, &XCAN_BenchHeaders[1]);
+  const double FastNs   = __XCAN_BenchTime(XCAN_DecodeRxHeaders, &XCAN_BenchHeaders[1]);
+  printf("%u headers: scalar %.2f ns, XCAN_DecodeRxHeaders %.2f ns per header, speedup x%.1f\n",
+         (unsigned)XCAN_BENCH_TIME_BATCH, ScalarNs, FastNs, (FastNs > 0.0 ? ScalarNs / FastNs : 0.0));
+  return (Errors == 0 ? 0 : 1);
+}
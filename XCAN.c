@@ -0,0 +1,2215 @@
+/*!*****************************************************************************
+ * @file    XCAN.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN driver
+ * @details
+ * The X_CAN Controller IP is a CAN-bus controller supporting CAN2.0A, CAN2.0B,
+ *   CAN-FD, CAN-XL
+ * Follow datasheet X_CAN user manual v3.50 (Nov 2022)
+ ******************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "XCAN.h"
+#include <string.h>
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+//! Access to a descriptor word shared with the MH
+#define XCAN_DESC_WORD(pDesc, word)  ( ((volatile uint32_t*)(pDesc)->Word)[(word)] )
+//! Is the TX descriptor still owned by the MH (VALID bit set and not yet cleared by the MH acknowledge)
+#define XCAN_TX_DESC_OWNED_BY_MH(pDesc)  ( (XCAN_DESC_WORD(pDesc, XCAN_CAN_TXDESC_TIC1) & XCAN_TxDMA1_VALID_SET_VALID_FOR_MH) > 0 )
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// Read a register of the X_CAN
+//=============================================================================
+eERRORRESULT XCAN_ReadREG32(XCAN *pComp, eXCAN_Registers reg, uint32_t* data)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (data == NULL)) return ERR__PARAMETER_ERROR;
+  if (pComp->fnReadRegister == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  return pComp->fnReadRegister(pComp->InterfaceDevice, (uint16_t)reg, data);
+}
+
+
+
+//=============================================================================
+// Write a register of the X_CAN
+//=============================================================================
+eERRORRESULT XCAN_WriteREG32(XCAN *pComp, eXCAN_Registers reg, uint32_t data)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pComp == NULL) return ERR__PARAMETER_ERROR;
+  if (pComp->fnWriteRegister == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  return pComp->fnWriteRegister(pComp->InterfaceDevice, (uint16_t)reg, data);
+}
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// [STATIC] Compute the CRC of a TX descriptor with a given TIC1
+//=============================================================================
+static uint32_t __XCAN_TxDescriptorCRC(XCAN *pComp, const XCAN_CAN_TxMessage* pDesc, uint32_t tic1)
+{
+  if ((pComp->DriverConfig & XCAN_DRIVER_TX_DESC_CRC) == 0) return 0u;
+  uint32_t Words[XCAN_CAN_TXDESC_COUNT];
+  memcpy(&Words[0], &pDesc->Word[0], sizeof(Words));
+  Words[XCAN_CAN_TXDESC_TIC1] = tic1 & ~XCAN_TxDMA1_CRC_Mask;                 // The CRC is computed with the CRC bit field set to 0
+  return XCAN_TxDMA1_CRC_SET(pComp->fnComputeCRC9(&Words[0], XCAN_CAN_TXDESC_COUNT));
+}
+
+
+
+//=============================================================================
+// [STATIC] Compute the CRC of an RX descriptor if needed
+//=============================================================================
+static uint32_t __XCAN_RxDescriptorCRC(XCAN *pComp, const XCAN_CAN_RxMessage* pDesc, uint32_t ric1)
+{
+  if ((pComp->DriverConfig & XCAN_DRIVER_RX_DESC_CRC) == 0) return 0u;
+  uint32_t Words[XCAN_CAN_RXDESC_COUNT];
+  memcpy(&Words[0], &pDesc->Word[0], sizeof(Words));
+  Words[XCAN_CAN_RXDESC_RIC1] = ric1 & ~XCAN_RxDMA1_CRC_Mask;                 // The CRC is computed with the CRC bit field set to 0
+  return XCAN_RxDMA1_CRC_SET(pComp->fnComputeCRC9(&Words[0], XCAN_CAN_RXDESC_COUNT));
+}
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// Configure a TX FIFO Queue of the X_CAN device
+//=============================================================================
+eERRORRESULT XCAN_ConfigureTxFIFOQueue(XCAN *pComp, const XCAN_TxFIFOQueueConfig* pConf)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pConf == NULL)) return ERR__PARAMETER_ERROR;
+  if (pConf->Descriptors == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (pConf->Queue >= XCAN_FIFO_QUEUE_COUNT) return ERR__PARAMETER_ERROR;
+  if ((pConf->MaxDesc == 0) || (pConf->MaxDesc > XCAN_TX_FIFO_QUEUE_MAX_DESC)) return ERR__OUT_OF_RANGE;
+  if (((uintptr_t)pConf->Descriptors & 0x3u) != 0) return ERR__PARAMETER_ERROR;            // The link list shall be 32-bits aligned
+  if (((pComp->DriverConfig & XCAN_DRIVER_TX_DESC_CRC) > 0) && (pComp->fnComputeCRC9 == NULL)) return ERR__CONFIGURATION;
+  const uint32_t QueueMask = XCAN_FIFO_QUEUE_MASK(pConf->Queue);
+  eERRORRESULT Error;
+
+  //--- Check the TX FIFO Queue is not busy ---
+  uint32_t Status;
+  Error = XCAN_ReadREG32(pComp, RegXCAN_TX_FQ_STS0, &Status);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_ReadREG32() then return the error
+  if ((XCAN_TX_FQ_STS0_BUSY_GET(Status) & QueueMask) > 0) return ERR__NOT_READY;           // The TX FIFO Queue registers are only writable when the TX FIFO Queue is not busy
+
+  //--- Initialize the link list and the ring ---
+  XCAN_TxFIFOQueueRing* pRing = &pComp->TxFIFO[pConf->Queue];
+  memset(pConf->Descriptors, 0, (size_t)pConf->MaxDesc * sizeof(XCAN_CAN_TxMessage));  // All descriptors are not valid for the MH
+  pRing->Desc           = pConf->Descriptors;
+  pRing->MaxDesc        = pConf->MaxDesc;
+  pRing->Head           = 0;
+  pRing->Tail           = 0;
+  pRing->InFlight       = 0;
+  pRing->RollingCounter = 0;                                                               // When a TX FIFO Queue is started for the first time, its first TX descriptor must have the RC set to 0
+  pRing->HarvestRollingCounter = 0;
+  pRing->Payloads       = pConf->PayloadBuffers;
+  if (pRing->Payloads != NULL) memset(pRing->Payloads, 0, (size_t)pConf->MaxDesc * sizeof(uint8_t*));
+
+  //--- Configure the TX FIFO Queue ---
+  Error = XCAN_WriteREG32(pComp, RegXCAN_TX_FQ_START_ADDn(pConf->Queue), XCAN_TX_FQ_START_ADD_SET(XCAN_PTR_TO_SMEM_ADDRESS(pConf->Descriptors)));
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_WriteREG32() then return the error
+  Error = XCAN_WriteREG32(pComp, RegXCAN_TX_FQ_SIZEn(pConf->Queue), XCAN_TX_FQ_SIZE_MAX_DESC_SET(pConf->MaxDesc));
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_WriteREG32() then return the error
+  uint32_t Enabled;
+  Error = XCAN_ReadREG32(pComp, RegXCAN_TX_FQ_CTRL2, &Enabled);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_ReadREG32() then return the error
+  return XCAN_WriteREG32(pComp, RegXCAN_TX_FQ_CTRL2, Enabled | XCAN_TX_FQ_CTRL2_SET(QueueMask));
+}
+
+
+
+//=============================================================================
+// Get the next free descriptor of a TX FIFO Queue
+//=============================================================================
+eERRORRESULT XCAN_GetNextTxFIFODescriptor(XCAN *pComp, eXCAN_FIFOQueue queue, XCAN_CAN_TxMessage** pDesc)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pDesc == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (queue >= XCAN_FIFO_QUEUE_COUNT) return ERR__PARAMETER_ERROR;
+  XCAN_TxFIFOQueueRing* pRing = &pComp->TxFIFO[queue];
+  if (pRing->Desc == NULL) return ERR__CONFIGURATION;
+
+  //--- Check a descriptor is free ---
+  if (pRing->InFlight >= pRing->MaxDesc)
+  {
+    XCAN_TxCompletion Completions[XCAN_TX_COMPLETION_BATCH_SIZE];
+    eERRORRESULT Error = XCAN_HarvestTxFIFOQueue(pComp, queue, &Completions[0], XCAN_TX_COMPLETION_BATCH_SIZE, NULL);
+    if (Error != ERR_OK) return Error;                                                     // If there is an error while calling XCAN_HarvestTxFIFOQueue() then return the error
+    if (pRing->InFlight >= pRing->MaxDesc) return ERR__BUFFER_FULL;                        // All descriptors are still owned by the MH, the ring is full
+  }
+  *pDesc = &pRing->Desc[pRing->Head];
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// [STATIC] Publish the next descriptor of a TX FIFO Queue ring to the MH
+//=============================================================================
+static eERRORRESULT __XCAN_PublishTxFIFODescriptor(XCAN *pComp, XCAN_TxFIFOQueueRing* pRing, eXCAN_FIFOQueue queue, bool irqWhenSent)
+{
+  if (pRing->InFlight >= pRing->MaxDesc) return ERR__BUFFER_FULL;                          // All descriptors are in flight
+  XCAN_CAN_TxMessage* pDesc = &pRing->Desc[pRing->Head];
+
+  //--- Fill the driver part of the descriptor ---
+  const bool LastDesc = (pRing->Head == (pRing->MaxDesc - 1u));
+  uint32_t TIC1 = XCAN_TxDMA1_RC_SET(pRing->RollingCounter) | XCAN_TxDMA1_FQN_SET(queue) | XCAN_TxDMA1_PQ_TX_FIFO_QUEUE
+                | (irqWhenSent ? XCAN_TxDMA1_IRQ_WHEN_SENT : XCAN_TxDMA1_IRQ_NO_IRQ)
+                | (LastDesc ? XCAN_TxDMA1_WRAP_TO_FIRST_ELEMENT : XCAN_TxDMA1_NO_WRAP)
+                | XCAN_TxDMA1_HD | XCAN_TxDMA1_VALID_SET_VALID_FOR_MH;
+  pDesc->TIC2.TxDMAinfoCtrl2 &= ~(XCAN_TxDMA2_IN_Mask | XCAN_TxDMA2_NHDO_Mask);
+  pDesc->TIC2.TxDMAinfoCtrl2 |= XCAN_TxDMA2_IN_SET(pComp->InstanceNumber) | XCAN_TxDMA2_NHDO_SET(XCAN_TxDMA2_NHDO_VALUE);
+  pDesc->TS0 = 0;
+  pDesc->TS1 = 0;
+  TIC1 |= __XCAN_TxDescriptorCRC(pComp, pDesc, TIC1);
+
+  //--- Hand over the descriptor to the MH ---
+  XCAN_MEMORY_BARRIER();                                                                   // All the descriptor shall be written before the VALID bit
+  XCAN_DESC_WORD(pDesc, XCAN_CAN_TXDESC_TIC1) = TIC1;
+  pRing->Head++;
+  if (pRing->Head >= pRing->MaxDesc) pRing->Head = 0;
+  pRing->InFlight++;
+  pRing->RollingCounter = (pRing->RollingCounter + 1u) & XCAN_ROLLING_COUNTER_Mask;        // RC continue even in case of wrap
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Publish the descriptor got with XCAN_GetNextTxFIFODescriptor() to the MH
+//=============================================================================
+eERRORRESULT XCAN_PublishTxFIFODescriptor(XCAN *pComp, eXCAN_FIFOQueue queue, bool irqWhenSent)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pComp == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (queue >= XCAN_FIFO_QUEUE_COUNT) return ERR__PARAMETER_ERROR;
+  XCAN_TxFIFOQueueRing* pRing = &pComp->TxFIFO[queue];
+  if (pRing->Desc == NULL) return ERR__CONFIGURATION;
+  eERRORRESULT Error = __XCAN_PublishTxFIFODescriptor(pComp, pRing, queue, irqWhenSent);
+  XCAN_MEMORY_BARRIER();                                                                   // The VALID bit shall be written before any TX FIFO Queue status check
+  return Error;
+}
+
+
+
+//=============================================================================
+// Start a TX FIFO Queue only if it is stalled
+//=============================================================================
+eERRORRESULT XCAN_StartTxFIFOQueueIfStalled(XCAN *pComp, eXCAN_FIFOQueue queue)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pComp == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (queue >= XCAN_FIFO_QUEUE_COUNT) return ERR__PARAMETER_ERROR;
+  const uint32_t QueueMask = XCAN_FIFO_QUEUE_MASK(queue);
+  eERRORRESULT Error;
+
+  uint32_t Status;
+  Error = XCAN_ReadREG32(pComp, RegXCAN_TX_FQ_STS0, &Status);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_ReadREG32() then return the error
+  const bool Busy   = ((XCAN_TX_FQ_STS0_BUSY_GET(Status) & QueueMask) > 0);
+  const bool OnHold = ((XCAN_TX_FQ_STS0_STOP_GET(Status) & QueueMask) > 0);
+  if (Busy && (OnHold == false)) return ERR_OK;                                            // The TX FIFO Queue is running, it will fetch the new descriptors by itself
+  return XCAN_WriteREG32(pComp, RegXCAN_TX_FQ_CTRL0, XCAN_TX_FQ_CTRL0_SET(QueueMask));     // Stalled (not started or on hold), start it
+}
+
+
+
+//=============================================================================
+// Publish the next descriptor and start the TX FIFO Queue if it is stalled
+//=============================================================================
+eERRORRESULT XCAN_SendTxFIFODescriptor(XCAN *pComp, eXCAN_FIFOQueue queue, bool irqWhenSent)
+{
+  eERRORRESULT Error = XCAN_PublishTxFIFODescriptor(pComp, queue, irqWhenSent);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_PublishTxFIFODescriptor() then return the error
+  return XCAN_StartTxFIFOQueueIfStalled(pComp, queue);
+}
+
+
+
+
+//=============================================================================
+// Initialize a TX payload pool
+//=============================================================================
+eERRORRESULT XCAN_InitTxPayloadPool(XCAN_TxPayloadPool* pPool, const XCAN_TxPayloadPoolConfig* pConf)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pPool == NULL) || (pConf == NULL)) return ERR__PARAMETER_ERROR;
+  if (pConf->Memory == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (((uintptr_t)pConf->Memory & (sizeof(uintptr_t) - 1u)) != 0) return ERR__PARAMETER_ERROR; // The headers shall be aligned
+  uint8_t* pMem = pConf->Memory;
+  size_t Remaining = pConf->MemorySize;
+
+  for (size_t zClass = 0; zClass < XCAN_TX_PAYLOAD_CLASS_COUNT; ++zClass)
+  {
+    const size_t Stride = (sizeof(uintptr_t) + XCAN_TX_PAYLOAD_CLASS_SIZE[zClass] + sizeof(uintptr_t) - 1u) & ~(sizeof(uintptr_t) - 1u); // Header + buffer, keep the next header aligned
+    pPool->FreeList[zClass]  = NULL;
+    pPool->FreeCount[zClass] = pConf->BufferCount[zClass];
+    for (size_t zBuf = 0; zBuf < pConf->BufferCount[zClass]; ++zBuf)
+    {
+      if (Remaining < Stride) return ERR__OUT_OF_MEMORY;
+      uintptr_t* pHeader = (uintptr_t*)pMem;
+      *pHeader = (uintptr_t)pPool->FreeList[zClass];                                       // Link the buffer in the free list of its class
+      pPool->FreeList[zClass] = pHeader;
+      pMem      += Stride;
+      Remaining -= Stride;
+    }
+  }
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Allocate a TX payload buffer from a pool
+//=============================================================================
+eERRORRESULT XCAN_AllocTxPayload(XCAN_TxPayloadPool* pPool, size_t size, uint8_t** pBuffer)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pPool == NULL) || (pBuffer == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if ((size < XCAN_CANXL_PAYLOAD_MIN) || (size > XCAN_CANXL_PAYLOAD_MAX)) return ERR__BAD_DATA_SIZE;
+
+  //--- Find the smallest class that fits ---
+  static const uint8_t XCAN_WORDS_TO_CLASS[16 + 1] = { 0, 0, 0, 1, 2, 3, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7, }; // Class for 0 to 16 words (64 bytes)
+  size_t Class;
+  if (size <= 64u) Class = XCAN_WORDS_TO_CLASS[(size + 3u) >> 2];
+  else
+  {
+    Class = 8;
+    while (XCAN_TX_PAYLOAD_CLASS_SIZE[Class] < size) ++Class;                              // CAN-XL classes are powers of 2
+  }
+
+  //--- Take the first free buffer of this class or a bigger one ---
+  while ((Class < XCAN_TX_PAYLOAD_CLASS_COUNT) && (pPool->FreeList[Class] == NULL)) ++Class;
+  if (Class >= XCAN_TX_PAYLOAD_CLASS_COUNT) return ERR__OUT_OF_MEMORY;
+  uintptr_t* pHeader = pPool->FreeList[Class];
+  pPool->FreeList[Class] = (uintptr_t*)*pHeader;
+  pPool->FreeCount[Class]--;
+  *pHeader = (uintptr_t)Class;                                                             // An allocated buffer keeps its class in its header
+  *pBuffer = (uint8_t*)(pHeader + 1);
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Free a TX payload buffer to its pool
+//=============================================================================
+eERRORRESULT XCAN_FreeTxPayload(XCAN_TxPayloadPool* pPool, uint8_t* pBuffer)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pPool == NULL) || (pBuffer == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  uintptr_t* pHeader = ((uintptr_t*)pBuffer) - 1;
+  const uintptr_t Class = *pHeader;
+  if (Class >= XCAN_TX_PAYLOAD_CLASS_COUNT) return ERR__PARAMETER_ERROR;                   // Not a buffer of the pool
+  *pHeader = (uintptr_t)pPool->FreeList[Class];
+  pPool->FreeList[Class] = pHeader;
+  pPool->FreeCount[Class]++;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// [STATIC] Pack up to 4 payload bytes in a descriptor word (byte 0 in bits 0-7)
+//=============================================================================
+static inline uint32_t __XCAN_PackPayloadWord(const uint8_t* pData, size_t size)
+{
+  uint32_t Word = 0;
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+  memcpy(&Word, pData, size);                                                              // Little-endian CPU: the bytes are already in the descriptor order
+#else
+  for (size_t z = 0; z < size; ++z) Word |= (uint32_t)pData[z] << (z * 8u);
+#endif
+  return Word;
+}
+
+
+
+//=============================================================================
+// [STATIC] Build a TX descriptor from a message
+//=============================================================================
+static eERRORRESULT __XCAN_BuildTxDescriptor(const XCAN_CANMessage* pMessage, XCAN_CAN_TxMessage* pDesc)
+{
+  const setXCAN_MessageCtrlFlags Flags = pMessage->ControlFlags;
+  const uint8_t* pData = pMessage->PayloadData;
+  uint32_t TIC2, T0, T1, W6 = 0, W7 = 0;
+  size_t PayloadSize;
+
+  if ((Flags & XCAN_CANXL_FRAME) > 0)
+  {
+    //--- CAN-XL frame: the payload is always in a data container ---
+    if ((Flags & (XCAN_CANFD_FRAME | XCAN_EXTENDED_MESSAGE_ID | XCAN_REMOTE_TRANSMISSION_REQUEST)) > 0) return ERR__PARAMETER_ERROR;
+    PayloadSize = pMessage->PayloadSize;
+    if ((PayloadSize < XCAN_CANXL_PAYLOAD_MIN) || (PayloadSize > XCAN_CANXL_PAYLOAD_MAX)) return ERR__BAD_DATA_SIZE;
+    if ((pData == NULL) || (((uintptr_t)pData & 0x3u) != 0)) return ERR__PARAMETER_ERROR;  // The payload shall be 32-bits aligned
+    T0   = XCAN_T0_CANXL_SET | XCAN_T0_SID_SET(pMessage->MessageID) | XCAN_T0_VCID_SET(pMessage->VCID) | XCAN_T0_SDT_SET(pMessage->SDT)
+         | XCAN_T0_SEC_SET((Flags & XCAN_SIMPLE_EXTENDED_CONTENT    ) > 0)
+         | XCAN_T0_RRS_SET((Flags & XCAN_REMOTE_REQUEST_SUBSTITUTION) > 0);
+    T1   = XCAN_T1_CANXL_DLC_SET(PayloadSize - 1u);                                        // DLC with CAN XL encoding is the payload size - 1
+    W6   = pMessage->AF;
+    W7   = XCAN_PTR_TO_SMEM_ADDRESS(pData);
+    TIC2 = XCAN_TxDMA1_PLSRC_IN_DATA_CONTAINER;
+  }
+  else
+  {
+    //--- CAN2.0 or CAN-FD frame ---
+    const bool IsCANFD = ((Flags & XCAN_CANFD_FRAME) > 0);
+    if ((IsCANFD == false) && ((Flags & (XCAN_SWITCH_BITRATE | XCAN_TRANSMIT_ERROR_PASSIVE)) > 0)) return ERR__PARAMETER_ERROR;
+    if (IsCANFD && ((Flags & XCAN_REMOTE_TRANSMISSION_REQUEST) > 0)) return ERR__PARAMETER_ERROR;
+    if ((size_t)pMessage->DLC >= XCAN_DLC_COUNT) return ERR__BAD_DATA_SIZE;
+    PayloadSize = XCAN_DLCToByte(pMessage->DLC, IsCANFD);
+    if ((Flags & XCAN_REMOTE_TRANSMISSION_REQUEST) > 0) PayloadSize = 0;                  // A remote frame does not have payload
+    if ((PayloadSize > 0) && (pData == NULL)) return ERR__PARAMETER_ERROR;
+    if ((Flags & XCAN_EXTENDED_MESSAGE_ID) > 0) T0 = XCAN_T0_XTD_EXTENDED_ID | XCAN_T0_ID_SET(pMessage->MessageID);
+    else                                        T0 = XCAN_T0_XTD_STANDARD_ID | XCAN_T0_SID_SET(pMessage->MessageID);
+    T0 |= (IsCANFD ? XCAN_T0_CANFD_SET : XCAN_T0_CAN20_SET);
+    T1  = XCAN_T1_DLC_SET(pMessage->DLC)
+        | ((Flags & XCAN_REMOTE_TRANSMISSION_REQUEST) > 0 ? XCAN_T1_RTR : 0u)
+        | ((Flags & XCAN_SWITCH_BITRATE             ) > 0 ? XCAN_T1_BRS : 0u)
+        | ((Flags & XCAN_TRANSMIT_ERROR_PASSIVE     ) > 0 ? XCAN_T1_ESI : 0u);
+
+    //--- Payload: TD0 is always the copy of the first 4 bytes ---
+    const size_t FirstSize = (PayloadSize > 4u ? 4u : PayloadSize);
+    W6 = (FirstSize > 0 ? __XCAN_PackPayloadWord(pData, FirstSize) : 0u);
+    if ((IsCANFD == false) || (PayloadSize <= 4u))
+    {
+      //--- Inline payload: the MH does not fetch any data container ---
+      if (IsCANFD) W7 = (pData != NULL ? XCAN_PTR_TO_SMEM_ADDRESS(pData) : 0u);           // CAN-FD with SIZE <= 1: TX_AP is not used but shall be set to the payload address
+      else if (PayloadSize > 4u) W7 = __XCAN_PackPayloadWord(&pData[4], PayloadSize - 4u); // CAN2.0: last 4 bytes in TD1
+      TIC2 = XCAN_TxDMA1_PLSRC_IN_TX_DESCRIPTOR;
+    }
+    else
+    {
+      if (((uintptr_t)pData & 0x3u) != 0) return ERR__PARAMETER_ERROR;                    // The payload shall be 32-bits aligned
+      W7   = XCAN_PTR_TO_SMEM_ADDRESS(pData);
+      TIC2 = XCAN_TxDMA1_PLSRC_IN_DATA_CONTAINER;
+    }
+  }
+
+  //--- Fill the descriptor ---
+  pDesc->TIC2.TxDMAinfoCtrl2 = TIC2 | XCAN_TxDMA2_SIZE_SET((PayloadSize + 3u) / 4u);       // SIZE is in words (32-bits)
+  pDesc->T0.T0 = T0;
+  pDesc->T1.T1 = T1;
+  pDesc->TD0   = W6;
+  pDesc->TD1   = W7;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Build a TX descriptor from a message
+//=============================================================================
+eERRORRESULT XCAN_BuildTxDescriptor(const XCAN_CANMessage* pMessage, XCAN_CAN_TxMessage* pDesc)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pMessage == NULL) || (pDesc == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if ((pMessage->ControlFlags & XCAN_PAYLOAD_FROM_POOL) > 0) return ERR__PARAMETER_ERROR; // The payload buffer of a descriptor built here cannot be freed by the driver
+  return __XCAN_BuildTxDescriptor(pMessage, pDesc);
+}
+
+
+
+//=============================================================================
+// [STATIC] Get the payload buffer from the TX payload pool to free when the descriptor is completed
+//=============================================================================
+static uint8_t* __XCAN_GetTxPoolPayload(XCAN *pComp, const XCAN_CANMessage* pMessage, const XCAN_CAN_TxMessage* pDesc)
+{
+  if ((pMessage->ControlFlags & XCAN_PAYLOAD_FROM_POOL) == 0) return NULL;
+  if ((pDesc->TIC2.TxDMAinfoCtrl2 & XCAN_TxDMA1_PLSRC_IN_DATA_CONTAINER) > 0) return pMessage->PayloadData;
+  if (pComp->TxPayloadPool != NULL) XCAN_FreeTxPayload(pComp->TxPayloadPool, pMessage->PayloadData); // Inline payload already copied in the descriptor, the buffer is not needed anymore
+  return NULL;
+}
+
+
+
+//=============================================================================
+// Transmit a burst of messages through a TX FIFO Queue
+//=============================================================================
+eERRORRESULT XCAN_TransmitMessagesToTxFIFOQueue(XCAN *pComp, eXCAN_FIFOQueue queue, const XCAN_CANMessage* pMessages, size_t count, size_t* pSentCount, bool irqWhenSent)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pMessages == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (queue >= XCAN_FIFO_QUEUE_COUNT) return ERR__PARAMETER_ERROR;
+  XCAN_TxFIFOQueueRing* pRing = &pComp->TxFIFO[queue];
+  if (pRing->Desc == NULL) return ERR__CONFIGURATION;
+  eERRORRESULT Error = ERR_OK;
+  size_t Sent = 0;
+
+  //--- Build and publish all messages ---
+  while (Sent < count)
+  {
+    XCAN_CAN_TxMessage* pDesc;
+    Error = XCAN_GetNextTxFIFODescriptor(pComp, queue, &pDesc);
+    if (Error != ERR_OK) break;                                                            // No more free descriptor, send what was published
+    Error = __XCAN_BuildTxDescriptor(&pMessages[Sent], pDesc);
+    if (Error != ERR_OK) break;                                                            // If there is an error while calling __XCAN_BuildTxDescriptor() then stop here
+    const bool InDataContainer = ((pDesc->TIC2.TxDMAinfoCtrl2 & XCAN_TxDMA1_PLSRC_IN_DATA_CONTAINER) > 0);
+    if (((pMessages[Sent].ControlFlags & XCAN_PAYLOAD_FROM_POOL) > 0) && InDataContainer && (pRing->Payloads == NULL))
+    { Error = ERR__CONFIGURATION; break; }                                                 // The payload buffer can only be freed at harvest if the ring has the payload buffers array
+    uint8_t* pPoolBuffer = __XCAN_GetTxPoolPayload(pComp, &pMessages[Sent], pDesc);
+    if (pRing->Payloads != NULL) pRing->Payloads[pRing->Head] = pPoolBuffer;
+    Error = __XCAN_PublishTxFIFODescriptor(pComp, pRing, queue, irqWhenSent);
+    if (Error != ERR_OK) break;                                                            // If there is an error while calling __XCAN_PublishTxFIFODescriptor() then stop here
+    ++Sent;
+  }
+  if (pSentCount != NULL) *pSentCount = Sent;
+
+  //--- One doorbell for the whole burst ---
+  if (Sent > 0)
+  {
+    XCAN_MEMORY_BARRIER();                                                                 // The VALID bits shall be written before starting the TX FIFO Queue
+    eERRORRESULT ErrorStart = XCAN_WriteREG32(pComp, RegXCAN_TX_FQ_CTRL0, XCAN_TX_FQ_CTRL0_SET(XCAN_FIFO_QUEUE_MASK(queue)));
+    if (ErrorStart != ERR_OK) return ErrorStart;                                           // If there is an error while calling XCAN_WriteREG32() then return the error
+  }
+  return Error;
+}
+
+
+
+//=============================================================================
+// Harvest the TX completions of a TX FIFO Queue
+//=============================================================================
+eERRORRESULT XCAN_HarvestTxFIFOQueue(XCAN *pComp, eXCAN_FIFOQueue queue, XCAN_TxCompletion* pCompletions, size_t maxCount, size_t* pHarvestedCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pCompletions == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (queue >= XCAN_FIFO_QUEUE_COUNT) return ERR__PARAMETER_ERROR;
+  XCAN_TxFIFOQueueRing* pRing = &pComp->TxFIFO[queue];
+  if (pRing->Desc == NULL) return ERR__CONFIGURATION;
+  size_t Harvested = 0;
+
+  //--- Walk the acknowledged descriptors ---
+  while ((Harvested < maxCount) && (pRing->InFlight > 0))
+  {
+    XCAN_CAN_TxMessage* pDesc = &pRing->Desc[pRing->Tail];
+    const uint32_t TIC1 = XCAN_DESC_WORD(pDesc, XCAN_CAN_TXDESC_TIC1);
+    if ((TIC1 & XCAN_TxDMA1_VALID_SET_VALID_FOR_MH) > 0) break;                            // First descriptor still owned by the MH, stop here
+    XCAN_MEMORY_BARRIER();                                                                 // The acknowledge data shall be read after the VALID bit
+    XCAN_TxCompletion* pCompletion = &pCompletions[Harvested++];
+    pCompletion->Timestamp = ((uint64_t)XCAN_DESC_WORD(pDesc, XCAN_CAN_TXDESC_TS1) << 32) | (uint64_t)XCAN_DESC_WORD(pDesc, XCAN_CAN_TXDESC_TS0);
+    pCompletion->Index     = pRing->Tail;
+    pCompletion->Status    = XCAN_TxDMA1_STS_GET(TIC1);
+    const uint8_t RC = (uint8_t)XCAN_TxDMA1_RC_GET(TIC1);
+    if (RC != pRing->HarvestRollingCounter)                                                // Gap or reorder in the descriptors acknowledged
+    {
+      if (pComp->fnRollingCounterError != NULL) pComp->fnRollingCounterError(pComp, false, queue, pRing->HarvestRollingCounter, RC);
+    }
+    pRing->HarvestRollingCounter = (RC + 1u) & XCAN_ROLLING_COUNTER_Mask;                  // Resynchronize on the received RC
+    if ((pRing->Payloads != NULL) && (pRing->Payloads[pRing->Tail] != NULL))
+    {
+      if (pComp->TxPayloadPool != NULL) XCAN_FreeTxPayload(pComp->TxPayloadPool, pRing->Payloads[pRing->Tail]); // The MH does not use the payload anymore
+      pRing->Payloads[pRing->Tail] = NULL;
+    }
+    pRing->Tail++;
+    if (pRing->Tail >= pRing->MaxDesc) pRing->Tail = 0;
+    pRing->InFlight--;
+  }
+  if (pHarvestedCount != NULL) *pHarvestedCount = Harvested;
+
+  //--- One callback for the whole batch ---
+  if ((Harvested > 0) && (pComp->fnTxCompleteBatch != NULL)) pComp->fnTxCompleteBatch(pComp, queue, pCompletions, Harvested);
+  return ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// Check the rolling counter of an RX header descriptor
+//=============================================================================
+bool XCAN_CheckRxRollingCounter(XCAN *pComp, eXCAN_FIFOQueue queue, uint32_t ric1, uint16_t descCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pComp == NULL) return false;
+#endif
+  if (queue >= XCAN_FIFO_QUEUE_COUNT) return false;
+  const uint8_t QueueMask = (uint8_t)XCAN_FIFO_QUEUE_MASK(queue);
+  const uint8_t RC = (uint8_t)XCAN_RxDMA1_RC_GET(ric1);
+  bool InSequence = true;
+  if ((pComp->RxRollingCounterSynced & QueueMask) == 0) pComp->RxRollingCounterSynced |= QueueMask; // The first RX descriptor synchronizes the expected RC
+  else if (RC != pComp->RxRollingCounter[queue])                                           // Gap or reorder in the descriptors received
+  {
+    InSequence = false;
+    if (pComp->fnRollingCounterError != NULL) pComp->fnRollingCounterError(pComp, true, queue, pComp->RxRollingCounter[queue], RC);
+  }
+  pComp->RxRollingCounter[queue] = (uint8_t)((RC + descCount) & XCAN_ROLLING_COUNTER_Mask); // Each descriptor used by the RX message has its own RC
+  return InSequence;
+}
+
+
+
+//=============================================================================
+// [STATIC] Give an RX descriptor to the MH
+//=============================================================================
+static void __XCAN_ArmRxDescriptor(XCAN *pComp, const XCAN_RxFIFOQueueRing* pRing, XCAN_CAN_RxMessage* pDesc, uint8_t rollingCounter, uint32_t rxAddress)
+{
+  XCAN_DESC_WORD(pDesc, XCAN_CAN_RXDESC_RX_AP) = rxAddress;                                // In Continuous Mode, the RX_AP is written by the MH
+  XCAN_DESC_WORD(pDesc, XCAN_CAN_RXDESC_TS0)   = 0;
+  XCAN_DESC_WORD(pDesc, XCAN_CAN_RXDESC_TS1)   = 0;
+  uint32_t RIC1 = pRing->DescCtrl | XCAN_RxDMA1_RC_SET(rollingCounter);                    // VALID = 0: the descriptor can be used by the MH
+  RIC1 |= __XCAN_RxDescriptorCRC(pComp, pDesc, RIC1);
+  XCAN_DESC_WORD(pDesc, XCAN_CAN_RXDESC_RIC1) = RIC1;
+}
+
+
+
+//=============================================================================
+// Configure an RX FIFO Queue of the X_CAN device in Continuous Mode
+//=============================================================================
+eERRORRESULT XCAN_ConfigureRxContinuousQueue(XCAN *pComp, const XCAN_RxContinuousQueueConfig* pConf)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pConf == NULL)) return ERR__PARAMETER_ERROR;
+  if ((pConf->Descriptors == NULL) || (pConf->DataContainer == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (pConf->Queue >= XCAN_FIFO_QUEUE_COUNT) return ERR__PARAMETER_ERROR;
+  if ((pConf->MaxDesc == 0) || (pConf->MaxDesc > XCAN_RX_FIFO_QUEUE_MAX_DESC)) return ERR__OUT_OF_RANGE;
+  if ((pConf->DCSize == 0) || (pConf->DCSize > XCAN_RX_DC_SIZE_MAX)) return ERR__OUT_OF_RANGE;
+  if ((((uintptr_t)pConf->Descriptors | (uintptr_t)pConf->DataContainer) & 0x3u) != 0) return ERR__PARAMETER_ERROR; // The link list and the data container shall be 32-bits aligned
+  if (((pComp->DriverConfig & XCAN_DRIVER_RX_DESC_CRC) > 0) && (pComp->fnComputeCRC9 == NULL)) return ERR__CONFIGURATION;
+  const uint32_t QueueMask = XCAN_FIFO_QUEUE_MASK(pConf->Queue);
+  eERRORRESULT Error;
+
+  //--- Check the RX FIFO Queue is not busy ---
+  uint32_t Status;
+  Error = XCAN_ReadREG32(pComp, RegXCAN_RX_FQ_STS0, &Status);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_ReadREG32() then return the error
+  if ((XCAN_RX_FQ_STS0_BUSY_GET(Status) & QueueMask) > 0) return ERR__NOT_READY;           // The RX FIFO Queue registers are only writable when the RX FIFO Queue is not busy
+
+  //--- Initialize the ring and the link list ---
+  XCAN_RxFIFOQueueRing* pRing = &pComp->RxFIFO[pConf->Queue];
+  pRing->Desc           = pConf->Descriptors;
+  pRing->MaxDesc        = pConf->MaxDesc;
+  pRing->Head           = 0;
+  pRing->Tail           = 0;
+  pRing->Pending        = 0;
+  pRing->DescCtrl       = XCAN_RxDMA1_HD | XCAN_RxDMA1_IN_SET(pComp->InstanceNumber) | XCAN_RxDMA1_FQN_SET(pConf->Queue)
+                        | (pConf->IrqWhenReceived ? XCAN_RxDMA1_IRQ_WHEN_SENT : XCAN_RxDMA1_IRQ_NO_IRQ);
+  pRing->DataContainer  = pConf->DataContainer;
+  pRing->DCAddress      = XCAN_PTR_TO_SMEM_ADDRESS(pConf->DataContainer);
+  pRing->DCSizeBytes    = (uint32_t)pConf->DCSize * XCAN_RX_DC_SIZE_UNIT;
+  pRing->Buffers        = NULL;
+  pRing->BufferPool     = NULL;
+  pRing->Dropped        = 0;
+  pRing->SkipDesc       = 0;
+  pRing->ReadEnd        = 0;
+  pRing->ReleaseEnd     = 0;
+  pRing->HighWatermark  = 0;
+  pRing->LowWatermark   = 0;
+  pRing->AboveWatermark = false;
+  pRing->Overflows      = 0;
+  for (size_t zDesc = 0; zDesc < pConf->MaxDesc; ++zDesc)                                  // When an RX FIFO Queue is started for the first time, its first RX descriptor must have the RC set to 0
+    __XCAN_ArmRxDescriptor(pComp, pRing, &pConf->Descriptors[zDesc], (uint8_t)(zDesc & XCAN_ROLLING_COUNTER_Mask), 0);
+  pComp->RxRollingCounter[pConf->Queue] = 0;
+  pComp->RxRollingCounterSynced |= (uint8_t)QueueMask;                                     // The first RC is known, no need to synchronize on the first RX descriptor
+
+  //--- Configure the RX FIFO Queue ---
+  XCAN_MEMORY_BARRIER();                                                                   // The descriptors shall be written before the MH can fetch them
+  Error = XCAN_WriteREG32(pComp, RegXCAN_RX_FQ_START_ADDn(pConf->Queue), XCAN_RX_FQ_ADD_PT_SET(XCAN_PTR_TO_SMEM_ADDRESS(pConf->Descriptors)));
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_WriteREG32() then return the error
+  Error = XCAN_WriteREG32(pComp, RegXCAN_RX_FQ_SIZEn(pConf->Queue), XCAN_RX_FQ_SIZE_MAX_DESC_SET(pConf->MaxDesc) | XCAN_RX_FQ_SIZE_DC_SIZE_SET(pConf->DCSize));
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_WriteREG32() then return the error
+  Error = XCAN_WriteREG32(pComp, RegXCAN_RX_FQ_DC_START_ADDn(pConf->Queue), XCAN_RX_FQ_DC_START_ADD_SET(pRing->DCAddress));
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_WriteREG32() then return the error
+  Error = XCAN_WriteREG32(pComp, RegXCAN_RX_FQ_RD_ADD_PTn(pConf->Queue), XCAN_RX_FQ_RD_ADD_PT_SET(pRing->DCAddress) | XCAN_RX_FQ_RD_ADD_PT_VAL_INITIAL);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_WriteREG32() then return the error
+  uint32_t Enabled;
+  Error = XCAN_ReadREG32(pComp, RegXCAN_RX_FQ_CTRL2, &Enabled);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_ReadREG32() then return the error
+  return XCAN_WriteREG32(pComp, RegXCAN_RX_FQ_CTRL2, Enabled | XCAN_RX_FQ_CTRL2_SET(QueueMask));
+}
+
+
+
+//=============================================================================
+// [STATIC] Read a word of the data container with the wrap around
+//=============================================================================
+static inline uint32_t __XCAN_ReadDataContainerWord(const uint8_t* pContainer, uint32_t containerSize, uint32_t offset)
+{
+  if (offset >= containerSize) offset -= containerSize;
+  uint32_t Word;
+  memcpy(&Word, &pContainer[offset], sizeof(uint32_t));
+  return Word;
+}
+
+
+
+//=============================================================================
+// [STATIC] Decode an RX message of a data container, return its size in the data container
+//=============================================================================
+static uint32_t __XCAN_DecodeRxMessage(const uint8_t* pContainer, uint32_t containerSize, uint32_t offset, XCAN_RxMessageView* pView)
+{
+  const uint32_t R0 = __XCAN_ReadDataContainerWord(pContainer, containerSize, offset);
+  const uint32_t R1 = __XCAN_ReadDataContainerWord(pContainer, containerSize, offset + sizeof(uint32_t));
+  setXCAN_MessageCtrlFlags Flags = XCAN_NO_MESSAGE_CTRL_FLAGS;
+  uint32_t HeaderSize, PayloadSize;
+
+  if ((R0 & XCAN_T0_XLF) > 0)
+  {
+    //--- CAN-XL message ---
+    HeaderSize  = XCAN_RX_CANXL_HEADER_WORDS * sizeof(uint32_t);
+    PayloadSize = ((R1 & XCAN_R1_CANXL_DLC_Mask) >> XCAN_R1_CANXL_DLC_Pos) + 1u;           // DLC with CAN XL encoding is the payload size - 1
+    if (pView == NULL) return HeaderSize + ((PayloadSize + 3u) & ~3u);
+    Flags = XCAN_CANXL_FRAME
+          | (XCAN_R0_SEC_GET(R0) > 0 ? XCAN_SIMPLE_EXTENDED_CONTENT     : XCAN_NO_MESSAGE_CTRL_FLAGS)
+          | (XCAN_R0_RRS_GET(R0) > 0 ? XCAN_REMOTE_REQUEST_SUBSTITUTION : XCAN_NO_MESSAGE_CTRL_FLAGS);
+    pView->MessageID = XCAN_R0_SID_GET(R0);
+    pView->DLC       = XCAN_DLC_0BYTE;
+    pView->SDT       = (uint8_t)XCAN_R0_SDT_GET(R0);
+    pView->VCID      = (uint8_t)XCAN_R0_VCID_GET(R0);
+    pView->AF        = __XCAN_ReadDataContainerWord(pContainer, containerSize, offset + (2u * sizeof(uint32_t)));
+  }
+  else
+  {
+    //--- CAN2.0 or CAN-FD message ---
+    const bool IsCANFD = ((R0 & XCAN_T0_FDF) > 0);
+    const eXCAN_DataLength DLC = (eXCAN_DataLength)((R1 & XCAN_R1_DLC_Mask) >> XCAN_R1_DLC_Pos);
+    HeaderSize  = XCAN_RX_HEADER_WORDS * sizeof(uint32_t);
+    PayloadSize = ((IsCANFD == false) && ((R1 & XCAN_R1_RTR) > 0) ? 0u : (uint32_t)XCAN_DLCToByte(DLC, IsCANFD)); // A remote frame does not have payload
+    if (pView == NULL) return HeaderSize + ((PayloadSize + 3u) & ~3u);
+    if (IsCANFD) Flags |= XCAN_CANFD_FRAME;
+    if ((R0 & XCAN_T0_XTD) > 0) Flags |= XCAN_EXTENDED_MESSAGE_ID;
+    if ((IsCANFD == false) && ((R1 & XCAN_R1_RTR) > 0)) Flags |= XCAN_REMOTE_TRANSMISSION_REQUEST;
+    if (IsCANFD && ((R1 & XCAN_R1_BRS) > 0)) Flags |= XCAN_SWITCH_BITRATE;
+    if (IsCANFD && ((R1 & XCAN_R1_ESI) > 0)) Flags |= XCAN_TRANSMIT_ERROR_PASSIVE;
+    pView->MessageID = ((Flags & XCAN_EXTENDED_MESSAGE_ID) > 0 ? XCAN_R0_ID_GET(R0) : XCAN_R0_SID_GET(R0));
+    pView->DLC       = DLC;
+    pView->SDT       = 0;
+    pView->VCID      = 0;
+    pView->AF        = 0;
+  }
+  pView->ControlFlags = Flags;
+  pView->PayloadSize  = (uint16_t)PayloadSize;
+  pView->R1           = R1;
+
+  //--- Payload parts in the data container ---
+  uint32_t PayloadOffset = offset + HeaderSize;
+  if (PayloadOffset >= containerSize) PayloadOffset -= containerSize;
+  const uint32_t FirstPart = containerSize - PayloadOffset;                                // Bytes up to the end of the data container
+  pView->Payload[0]         = &pContainer[PayloadOffset];
+  pView->PayloadPartSize[0] = (uint16_t)(PayloadSize < FirstPart ? PayloadSize : FirstPart);
+  pView->PayloadPartSize[1] = (uint16_t)(PayloadSize - pView->PayloadPartSize[0]);
+  pView->Payload[1]         = (pView->PayloadPartSize[1] > 0 ? &pContainer[0] : NULL);
+  return HeaderSize + ((PayloadSize + 3u) & ~3u);
+}
+
+
+
+//=============================================================================
+// [STATIC] Get the bytes of the data container used by the RX messages read and not yet released
+//=============================================================================
+static inline uint32_t __XCAN_RxDataContainerFill(const XCAN_RxFIFOQueueRing* pRing)
+{
+  if (pRing->Pending == 0) return 0;
+  uint32_t Fill = pRing->ReadEnd + pRing->DCSizeBytes - pRing->ReleaseEnd;
+  if (Fill > pRing->DCSizeBytes) Fill -= pRing->DCSizeBytes;                               // Both ends equal with messages pending means a full data container
+  return Fill;
+}
+
+
+
+//=============================================================================
+// [STATIC] Read the next RX message of an RX FIFO Queue in Continuous Mode
+//=============================================================================
+static eERRORRESULT __XCAN_ReadRxContinuousMessage(XCAN *pComp, XCAN_RxFIFOQueueRing* pRing, eXCAN_FIFOQueue queue, XCAN_RxMessageView* pView)
+{
+  if (pRing->Pending >= pRing->MaxDesc) return ERR__NO_DATA_AVAILABLE;                     // All descriptors are read and not yet released
+  XCAN_CAN_RxMessage* pDesc = &pRing->Desc[pRing->Head];
+  const uint32_t RIC1 = XCAN_DESC_WORD(pDesc, XCAN_CAN_RXDESC_RIC1);
+  if (XCAN_RxDMA1_VALID_DATA_IS_AVAILABLE(RIC1) == false) return ERR__NO_DATA_AVAILABLE;   // No more message received
+  XCAN_MEMORY_BARRIER();                                                                   // The message shall be read after the VALID bit
+  const uint32_t Offset = XCAN_DESC_WORD(pDesc, XCAN_CAN_RXDESC_RX_AP) - pRing->DCAddress;
+  if ((Offset >= pRing->DCSizeBytes) || ((Offset & 0x3u) != 0)) return ERR__OUT_OF_RANGE;  // The RX_AP shall point in the data container
+  (void)XCAN_CheckRxRollingCounter(pComp, queue, RIC1, 1);                                 // Only one RX descriptor per RX message in Continuous Mode
+  pRing->ReadEnd = Offset + __XCAN_DecodeRxMessage(pRing->DataContainer, pRing->DCSizeBytes, Offset, pView);
+  if (pRing->ReadEnd >= pRing->DCSizeBytes) pRing->ReadEnd -= pRing->DCSizeBytes;
+  pView->Status    = XCAN_RxDMA1_STS_GET(RIC1);
+  pView->Timestamp = ((uint64_t)XCAN_DESC_WORD(pDesc, XCAN_CAN_RXDESC_TS1) << 32) | (uint64_t)XCAN_DESC_WORD(pDesc, XCAN_CAN_RXDESC_TS0);
+  pView->Index     = pRing->Head;
+  pRing->Head++;
+  if (pRing->Head >= pRing->MaxDesc) pRing->Head = 0;
+  pRing->Pending++;
+
+  //--- Check the high watermark ---
+  if ((pRing->HighWatermark > 0) && (pRing->AboveWatermark == false))
+  {
+    const uint32_t Fill = __XCAN_RxDataContainerFill(pRing);
+    if (Fill >= pRing->HighWatermark)
+    {
+      pRing->AboveWatermark = true;
+      if (pComp->fnRxHighWatermark != NULL) pComp->fnRxHighWatermark(pComp, queue, Fill);
+    }
+  }
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Read the RX messages available in an RX FIFO Queue in Continuous Mode without copying them
+//=============================================================================
+eERRORRESULT XCAN_ReadRxContinuousMessages(XCAN *pComp, eXCAN_FIFOQueue queue, XCAN_RxMessageView* pViews, size_t maxCount, size_t* pReadCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pViews == NULL) || (pReadCount == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (queue >= XCAN_FIFO_QUEUE_COUNT) return ERR__PARAMETER_ERROR;
+  XCAN_RxFIFOQueueRing* pRing = &pComp->RxFIFO[queue];
+  if ((pRing->Desc == NULL) || (pRing->DataContainer == NULL)) return ERR__CONFIGURATION;
+  eERRORRESULT Error = ERR_OK;
+  size_t Read = 0;
+  while (Read < maxCount)
+  {
+    Error = __XCAN_ReadRxContinuousMessage(pComp, pRing, queue, &pViews[Read]);
+    if (Error != ERR_OK) break;                                                            // No more message or error, stop here
+    ++Read;
+  }
+  *pReadCount = Read;
+  return (Error == ERR__NO_DATA_AVAILABLE ? ERR_OK : Error);
+}
+
+
+
+//=============================================================================
+// Release the oldest RX messages read of an RX FIFO Queue in Continuous Mode
+//=============================================================================
+eERRORRESULT XCAN_ReleaseRxContinuousMessages(XCAN *pComp, eXCAN_FIFOQueue queue, size_t count)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pComp == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (queue >= XCAN_FIFO_QUEUE_COUNT) return ERR__PARAMETER_ERROR;
+  XCAN_RxFIFOQueueRing* pRing = &pComp->RxFIFO[queue];
+  if ((pRing->Desc == NULL) || (pRing->DataContainer == NULL)) return ERR__CONFIGURATION;
+  if (count > pRing->Pending) return ERR__OUT_OF_RANGE;
+  if (count == 0) return ERR_OK;
+
+  //--- Give back the descriptors to the MH ---
+  uint32_t LastWord = 0;
+  for (size_t zMsg = 0; zMsg < count; ++zMsg)
+  {
+    XCAN_CAN_RxMessage* pDesc = &pRing->Desc[pRing->Tail];
+    const uint32_t RIC1   = XCAN_DESC_WORD(pDesc, XCAN_CAN_RXDESC_RIC1);
+    const uint32_t Offset = XCAN_DESC_WORD(pDesc, XCAN_CAN_RXDESC_RX_AP) - pRing->DCAddress;
+    LastWord = Offset + __XCAN_DecodeRxMessage(pRing->DataContainer, pRing->DCSizeBytes, Offset, NULL) - sizeof(uint32_t);
+    if (LastWord >= pRing->DCSizeBytes) LastWord -= pRing->DCSizeBytes;
+    __XCAN_ArmRxDescriptor(pComp, pRing, pDesc, (uint8_t)((XCAN_RxDMA1_RC_GET(RIC1) + pRing->MaxDesc) & XCAN_ROLLING_COUNTER_Mask), 0); // The RC is continuous across the link list wrap
+    pRing->Tail++;
+    if (pRing->Tail >= pRing->MaxDesc) pRing->Tail = 0;
+    pRing->Pending--;
+  }
+
+  pRing->ReleaseEnd = LastWord + sizeof(uint32_t);
+  if (pRing->ReleaseEnd >= pRing->DCSizeBytes) pRing->ReleaseEnd -= pRing->DCSizeBytes;
+  if (pRing->AboveWatermark && (__XCAN_RxDataContainerFill(pRing) <= pRing->LowWatermark)) pRing->AboveWatermark = false;
+
+  //--- One read address pointer update for the whole batch ---
+  XCAN_MEMORY_BARRIER();                                                                   // The descriptors shall be given back before the MH can overwrite the data container
+  return XCAN_WriteREG32(pComp, RegXCAN_RX_FQ_RD_ADD_PTn(queue), XCAN_RX_FQ_RD_ADD_PT_SET(pRing->DCAddress + LastWord));
+}
+
+
+
+//=============================================================================
+// Set the watermarks of the data container of an RX FIFO Queue in Continuous Mode
+//=============================================================================
+eERRORRESULT XCAN_SetRxWatermarks(XCAN *pComp, eXCAN_FIFOQueue queue, uint32_t highBytes, uint32_t lowBytes)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pComp == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (queue >= XCAN_FIFO_QUEUE_COUNT) return ERR__PARAMETER_ERROR;
+  XCAN_RxFIFOQueueRing* pRing = &pComp->RxFIFO[queue];
+  if ((pRing->Desc == NULL) || (pRing->DataContainer == NULL)) return ERR__CONFIGURATION;
+  if ((highBytes > pRing->DCSizeBytes) || ((highBytes > 0) && (lowBytes >= highBytes))) return ERR__PARAMETER_ERROR;
+  pRing->HighWatermark  = highBytes;
+  pRing->LowWatermark   = lowBytes;
+  pRing->AboveWatermark = false;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Get the fill of the data container of an RX FIFO Queue in Continuous Mode
+//=============================================================================
+eERRORRESULT XCAN_GetRxDataContainerFill(XCAN *pComp, eXCAN_FIFOQueue queue, uint32_t* pFillBytes)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pFillBytes == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (queue >= XCAN_FIFO_QUEUE_COUNT) return ERR__PARAMETER_ERROR;
+  const XCAN_RxFIFOQueueRing* pRing = &pComp->RxFIFO[queue];
+  if ((pRing->Desc == NULL) || (pRing->DataContainer == NULL)) return ERR__CONFIGURATION;
+  *pFillBytes = __XCAN_RxDataContainerFill(pRing);
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Recover the RX FIFO Queues in Continuous Mode stopped because their data container is full
+//=============================================================================
+eERRORRESULT XCAN_RecoverRxDataContainerFull(XCAN *pComp, eXCAN_RxOverflowPolicy policy, uint8_t* pRestartedQueues)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pComp == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (pRestartedQueues != NULL) *pRestartedQueues = 0;
+  uint32_t Continuous = 0;
+  for (size_t zQueue = 0; zQueue < XCAN_RX_FIFO_QUEUE_COUNT; ++zQueue)
+    if ((pComp->RxFIFO[zQueue].Desc != NULL) && (pComp->RxFIFO[zQueue].DataContainer != NULL)) Continuous |= XCAN_FIFO_QUEUE_MASK(zQueue);
+  if (Continuous == 0) return ERR__CONFIGURATION;
+
+  //--- Get the RX FIFO Queues stopped by a full data container ---
+  uint32_t Full;
+  eERRORRESULT Error = XCAN_ReadREG32(pComp, RegXCAN_RX_FQ_STS2, &Full);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_ReadREG32() then return the error
+  Full = XCAN_RX_FQ_STS2_GET(Full) & Continuous;                                           // The RX FIFO Queues stopped for another reason are not restarted
+  if (Full == 0) return ERR_OK;
+
+  //--- Count the unsuccessful receptions ---
+  uint32_t Statistics;
+  Error = XCAN_ReadREG32(pComp, RegXCAN_RX_STATISTICS, &Statistics);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_ReadREG32() then return the error
+  const uint16_t Unsuccessful = (uint16_t)XCAN_RX_STATISTICS_UNSUCC_GET(Statistics);
+  pComp->RxUnsuccessful    += (uint32_t)(Unsuccessful - pComp->RxUnsuccessfulLast) & (XCAN_RX_STATISTICS_UNSUCC_Mask >> XCAN_RX_STATISTICS_UNSUCC_Pos); // The counter wraps at 12-bits
+  pComp->RxUnsuccessfulLast = Unsuccessful;
+
+  //--- Free the data containers ---
+  uint32_t Restart = Full;
+  for (size_t zQueue = 0; zQueue < XCAN_RX_FIFO_QUEUE_COUNT; ++zQueue)
+  {
+    if ((Full & XCAN_FIFO_QUEUE_MASK(zQueue)) == 0) continue;
+    XCAN_RxFIFOQueueRing* pRing = &pComp->RxFIFO[zQueue];
+    if (policy != XCAN_RX_OVERFLOW_DROP_UNREAD) continue;
+    if (pRing->Pending > 0)                                                                // The messages are released in order, the messages held by the application keep the space of the next ones
+    {
+      Restart &= ~XCAN_FIFO_QUEUE_MASK(zQueue);                                            // The data container is still full, the application shall release its messages first
+      continue;
+    }
+    XCAN_RxMessageView View;
+    size_t Count = 0;
+    pRing->AboveWatermark = true;                                                          // No high watermark call for the dropped messages
+    while (__XCAN_ReadRxContinuousMessage(pComp, pRing, (eXCAN_FIFOQueue)zQueue, &View) == ERR_OK) ++Count;
+    pRing->AboveWatermark = false;
+    if (Count == 0) continue;
+    Error = XCAN_ReleaseRxContinuousMessages(pComp, (eXCAN_FIFOQueue)zQueue, Count);      // One RX_FQ_RD_ADD_PTn write for all the dropped messages
+    if (Error != ERR_OK) return Error;                                                     // If there is an error while calling XCAN_ReleaseRxContinuousMessages() then return the error
+    pRing->Dropped += (uint32_t)Count;
+  }
+
+  //--- Restart all the recovered RX FIFO Queues at once ---
+  if (Restart != 0)
+  {
+    Error = XCAN_WriteREG32(pComp, RegXCAN_RX_FQ_CTRL0, XCAN_RX_FQ_CTRL0_SET(Restart));
+    if (Error != ERR_OK) return Error;                                                     // If there is an error while calling XCAN_WriteREG32() then return the error
+    for (size_t zQueue = 0; zQueue < XCAN_RX_FIFO_QUEUE_COUNT; ++zQueue)                   // Count each stop once, when it is recovered, not at each call while it waits for the application
+      if ((Restart & XCAN_FIFO_QUEUE_MASK(zQueue)) > 0) pComp->RxFIFO[zQueue].Overflows++;
+  }
+  if (pRestartedQueues != NULL) *pRestartedQueues = (uint8_t)Restart;
+  return (Restart == Full ? ERR_OK : ERR__NOT_READY);
+}
+
+
+
+//=============================================================================
+// Initialize an RX buffer pool
+//=============================================================================
+eERRORRESULT XCAN_InitRxBufferPool(XCAN_RxBufferPool* pPool, uint8_t* pMemory, size_t bufferSize, uint16_t bufferCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pPool == NULL) || (pMemory == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (((uintptr_t)pMemory & (sizeof(uintptr_t) - 1u)) != 0) return ERR__PARAMETER_ERROR;  // The buffers shall be aligned
+  if (bufferSize < sizeof(uintptr_t)) return ERR__BAD_DATA_SIZE;
+  const size_t Stride = (bufferSize + sizeof(uintptr_t) - 1u) & ~(sizeof(uintptr_t) - 1u); // Keep the next buffer aligned
+  pPool->FreeList   = NULL;
+  pPool->FreeCount  = bufferCount;
+  pPool->BufferSize = (uint32_t)Stride;
+  for (size_t zBuf = bufferCount; zBuf > 0; --zBuf)                                        // Link from the last buffer so that the first buffer is allocated first
+  {
+    uintptr_t* pBuffer = (uintptr_t*)&pMemory[(zBuf - 1u) * Stride];
+    *pBuffer = (uintptr_t)pPool->FreeList;
+    pPool->FreeList = pBuffer;
+  }
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Allocate an RX buffer from a pool
+//=============================================================================
+eERRORRESULT XCAN_AllocRxBuffer(XCAN_RxBufferPool* pPool, uint8_t** pBuffer)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pPool == NULL) || (pBuffer == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  uintptr_t* pFree = pPool->FreeList;
+  if (pFree == NULL) return ERR__OUT_OF_MEMORY;
+  pPool->FreeList = (uintptr_t*)*pFree;
+  pPool->FreeCount--;
+  *pBuffer = (uint8_t*)pFree;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Free an RX buffer to its pool
+//=============================================================================
+eERRORRESULT XCAN_FreeRxBuffer(XCAN_RxBufferPool* pPool, uint8_t* pBuffer)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pPool == NULL) || (pBuffer == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  uintptr_t* pFree = (uintptr_t*)pBuffer;
+  *pFree = (uintptr_t)pPool->FreeList;
+  pPool->FreeList = pFree;
+  pPool->FreeCount++;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Configure an RX FIFO Queue of the X_CAN device in Normal Mode
+//=============================================================================
+eERRORRESULT XCAN_ConfigureRxNormalQueue(XCAN *pComp, const XCAN_RxNormalQueueConfig* pConf)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pConf == NULL)) return ERR__PARAMETER_ERROR;
+  if ((pConf->Descriptors == NULL) || (pConf->DescBuffers == NULL) || (pConf->BufferPool == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (pConf->Queue >= XCAN_FIFO_QUEUE_COUNT) return ERR__PARAMETER_ERROR;
+  if ((pConf->MaxDesc == 0) || (pConf->MaxDesc > XCAN_RX_FIFO_QUEUE_MAX_DESC)) return ERR__OUT_OF_RANGE;
+  if ((pConf->DCSize == 0) || (pConf->DCSize > XCAN_RX_NORMAL_DC_SIZE_MAX)) return ERR__OUT_OF_RANGE;
+  if (((uintptr_t)pConf->Descriptors & 0x3u) != 0) return ERR__PARAMETER_ERROR;            // The link list shall be 32-bits aligned
+  const uint32_t DCSizeBytes = (uint32_t)pConf->DCSize * XCAN_RX_DC_SIZE_UNIT;
+  if (pConf->BufferPool->BufferSize < DCSizeBytes) return ERR__CONFIGURATION;              // The MH can write a full data container in each buffer
+  const uint32_t MaxPayload = (pConf->MaxPayloadSize == 0 ? XCAN_CANXL_PAYLOAD_MAX : pConf->MaxPayloadSize);
+  if (MaxPayload > XCAN_CANXL_PAYLOAD_MAX) return ERR__OUT_OF_RANGE;
+  const uint32_t MaxMessageSize = (XCAN_RX_CANXL_HEADER_WORDS * sizeof(uint32_t)) + ((MaxPayload + 3u) & ~3u);
+  if (((uint32_t)pConf->MaxDesc * DCSizeBytes) < MaxMessageSize) return ERR__CONFIGURATION; // A message larger than the link list can never be received
+  if (pConf->BufferPool->FreeCount < pConf->MaxDesc) return ERR__OUT_OF_MEMORY;
+  if (((pComp->DriverConfig & XCAN_DRIVER_RX_DESC_CRC) > 0) && (pComp->fnComputeCRC9 == NULL)) return ERR__CONFIGURATION;
+  const uint32_t QueueMask = XCAN_FIFO_QUEUE_MASK(pConf->Queue);
+  eERRORRESULT Error;
+
+  //--- Check the RX FIFO Queue is not busy ---
+  uint32_t Status;
+  Error = XCAN_ReadREG32(pComp, RegXCAN_RX_FQ_STS0, &Status);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_ReadREG32() then return the error
+  if ((XCAN_RX_FQ_STS0_BUSY_GET(Status) & QueueMask) > 0) return ERR__NOT_READY;           // The RX FIFO Queue registers are only writable when the RX FIFO Queue is not busy
+
+  //--- Initialize the ring and post a buffer on each descriptor ---
+  XCAN_RxFIFOQueueRing* pRing = &pComp->RxFIFO[pConf->Queue];
+  pRing->Desc           = pConf->Descriptors;
+  pRing->MaxDesc        = pConf->MaxDesc;
+  pRing->Head           = 0;
+  pRing->Tail           = 0;
+  pRing->Pending        = 0;
+  pRing->DescCtrl       = XCAN_RxDMA1_HD | XCAN_RxDMA1_IN_SET(pComp->InstanceNumber) | XCAN_RxDMA1_FQN_SET(pConf->Queue)
+                        | (pConf->IrqWhenReceived ? XCAN_RxDMA1_IRQ_WHEN_SENT : XCAN_RxDMA1_IRQ_NO_IRQ);
+  pRing->DataContainer  = NULL;
+  pRing->DCAddress      = 0;
+  pRing->DCSizeBytes    = DCSizeBytes;
+  pRing->Buffers        = pConf->DescBuffers;
+  pRing->BufferPool     = pConf->BufferPool;
+  pRing->Dropped        = 0;
+  pRing->SkipDesc       = 0;
+  pRing->ReadEnd        = 0;
+  pRing->ReleaseEnd     = 0;
+  pRing->HighWatermark  = 0;
+  pRing->LowWatermark   = 0;
+  pRing->AboveWatermark = false;
+  pRing->Overflows      = 0;
+  for (size_t zDesc = 0; zDesc < pConf->MaxDesc; ++zDesc)                                  // When an RX FIFO Queue is started for the first time, its first RX descriptor must have the RC set to 0
+  {
+    (void)XCAN_AllocRxBuffer(pConf->BufferPool, &pConf->DescBuffers[zDesc]);               // Cannot fail, the free buffers count has been checked
+    __XCAN_ArmRxDescriptor(pComp, pRing, &pConf->Descriptors[zDesc], (uint8_t)(zDesc & XCAN_ROLLING_COUNTER_Mask), XCAN_PTR_TO_SMEM_ADDRESS(pConf->DescBuffers[zDesc]));
+  }
+  pComp->RxRollingCounter[pConf->Queue] = 0;
+  pComp->RxRollingCounterSynced |= (uint8_t)QueueMask;                                     // The first RC is known, no need to synchronize on the first RX descriptor
+
+  //--- Configure the RX FIFO Queue ---
+  XCAN_MEMORY_BARRIER();                                                                   // The descriptors shall be written before the MH can fetch them
+  Error = XCAN_WriteREG32(pComp, RegXCAN_RX_FQ_START_ADDn(pConf->Queue), XCAN_RX_FQ_ADD_PT_SET(XCAN_PTR_TO_SMEM_ADDRESS(pConf->Descriptors)));
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_WriteREG32() then return the error
+  Error = XCAN_WriteREG32(pComp, RegXCAN_RX_FQ_SIZEn(pConf->Queue), XCAN_RX_FQ_SIZE_MAX_DESC_SET(pConf->MaxDesc) | XCAN_RX_FQ_SIZE_DC_SIZE_SET(pConf->DCSize));
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_WriteREG32() then return the error
+  uint32_t Enabled;
+  Error = XCAN_ReadREG32(pComp, RegXCAN_RX_FQ_CTRL2, &Enabled);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_ReadREG32() then return the error
+  return XCAN_WriteREG32(pComp, RegXCAN_RX_FQ_CTRL2, Enabled | XCAN_RX_FQ_CTRL2_SET(QueueMask));
+}
+
+
+
+//=============================================================================
+// [STATIC] Give back to the MH the descriptors read of an RX FIFO Queue in Normal Mode, in order
+//=============================================================================
+static eERRORRESULT __XCAN_RearmRxNormalDescriptors(XCAN *pComp, XCAN_RxFIFOQueueRing* pRing, eXCAN_FIFOQueue queue, size_t* pRearmedCount)
+{
+  size_t Rearmed = 0;
+  while (pRing->Pending > 0)
+  {
+    uint8_t** pBuffer = &pRing->Buffers[pRing->Tail];
+    if (*pBuffer == NULL)                                                                  // The buffer has been given to the application, post a fresh one
+    {
+      if (XCAN_AllocRxBuffer(pRing->BufferPool, pBuffer) != ERR_OK) break;                 // Pool empty, the next descriptors wait for a buffer to keep the link list order
+    }
+    XCAN_CAN_RxMessage* pDesc = &pRing->Desc[pRing->Tail];
+    const uint8_t RC = (uint8_t)((XCAN_RxDMA1_RC_GET(XCAN_DESC_WORD(pDesc, XCAN_CAN_RXDESC_RIC1)) + pRing->MaxDesc) & XCAN_ROLLING_COUNTER_Mask); // The RC is continuous across the link list wrap
+    __XCAN_ArmRxDescriptor(pComp, pRing, pDesc, RC, XCAN_PTR_TO_SMEM_ADDRESS(*pBuffer));
+    pRing->Tail++;
+    if (pRing->Tail >= pRing->MaxDesc) pRing->Tail = 0;
+    pRing->Pending--;
+    ++Rearmed;
+  }
+  if (pRearmedCount != NULL) *pRearmedCount = Rearmed;
+  if (Rearmed == 0) return ERR_OK;
+
+  //--- Restart the RX FIFO Queue if it is on hold on a descriptor not yet given back ---
+  XCAN_MEMORY_BARRIER();                                                                   // The descriptors shall be given back before restarting the RX FIFO Queue
+  uint32_t Status;
+  eERRORRESULT Error = XCAN_ReadREG32(pComp, RegXCAN_RX_FQ_STS1, &Status);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_ReadREG32() then return the error
+  if ((XCAN_RX_FQ_STS1_UNVALID_GET(Status) & XCAN_FIFO_QUEUE_MASK(queue)) == 0) return ERR_OK;
+  return XCAN_WriteREG32(pComp, RegXCAN_RX_FQ_CTRL0, XCAN_RX_FQ_CTRL0_SET(XCAN_FIFO_QUEUE_MASK(queue)));
+}
+
+
+
+//=============================================================================
+// [STATIC] Skip a descriptor of a dropped RX message of an RX FIFO Queue in Normal Mode
+//=============================================================================
+static void __XCAN_SkipRxNormalDescriptor(XCAN_RxFIFOQueueRing* pRing)
+{
+  pRing->SkipDesc--;
+  pRing->Head++;                                                                           // The buffer stays on the descriptor and is posted again
+  if (pRing->Head >= pRing->MaxDesc) pRing->Head = 0;
+  pRing->Pending++;
+}
+
+
+
+//=============================================================================
+// [STATIC] Receive the next RX message of an RX FIFO Queue in Normal Mode
+//=============================================================================
+static eERRORRESULT __XCAN_ReceiveRxNormalMessage(XCAN *pComp, XCAN_RxFIFOQueueRing* pRing, eXCAN_FIFOQueue queue, XCAN_RxNormalMessage* pMessage)
+{
+  while (pRing->Pending < pRing->MaxDesc)
+  {
+    const uint16_t First = pRing->Head;
+    XCAN_CAN_RxMessage* pDesc = &pRing->Desc[First];
+    const uint32_t RIC1 = XCAN_DESC_WORD(pDesc, XCAN_CAN_RXDESC_RIC1);
+    if (XCAN_RxDMA1_VALID_DATA_IS_AVAILABLE(RIC1) == false) break;                         // No more message received
+    if (pRing->SkipDesc > 0) { __XCAN_SkipRxNormalDescriptor(pRing); continue; }           // Trailing descriptor of a message larger than the link list
+    XCAN_MEMORY_BARRIER();                                                                 // The message shall be read after the VALID bit
+    const uint32_t MessageSize = __XCAN_DecodeRxMessage(pRing->Buffers[First], pRing->DCSizeBytes, 0, &pMessage->View);
+    uint32_t DescCount = 1;
+    if ((RIC1 & XCAN_RxDMA1_NEXT_HAVE_NEXT_DESCRIPTOR) > 0) DescCount = (MessageSize + pRing->DCSizeBytes - 1u) / pRing->DCSizeBytes;
+    if (DescCount > pRing->MaxDesc)                                                        // The message will never be in the link list at once, skip its descriptors as they come
+    {
+      (void)XCAN_CheckRxRollingCounter(pComp, queue, RIC1, (uint16_t)DescCount);
+      pRing->Dropped++;
+      pRing->SkipDesc = (uint16_t)DescCount;
+      __XCAN_SkipRxNormalDescriptor(pRing);
+      continue;
+    }
+    if ((pRing->Pending + DescCount) > pRing->MaxDesc) break;                              // The trailing descriptors are not in the link list yet
+    (void)XCAN_CheckRxRollingCounter(pComp, queue, RIC1, (uint16_t)DescCount);             // Each descriptor used by the RX message has its own RC
+
+    //--- Give the buffers to the application ---
+    const bool Keep = (DescCount <= XCAN_RX_NORMAL_MAX_DESC_PER_MESSAGE);
+    for (size_t zBuf = 0; zBuf < XCAN_RX_NORMAL_MAX_DESC_PER_MESSAGE; ++zBuf) pMessage->Buffer[zBuf] = NULL;
+    for (size_t zDesc = 0; zDesc < DescCount; ++zDesc)
+    {
+      if (Keep)
+      {
+        pMessage->Buffer[zDesc] = pRing->Buffers[pRing->Head];
+        pRing->Buffers[pRing->Head] = NULL;                                                // A fresh buffer will be posted on this descriptor
+      }
+      pRing->Head++;
+      if (pRing->Head >= pRing->MaxDesc) pRing->Head = 0;
+      pRing->Pending++;
+    }
+    if (Keep == false) { pRing->Dropped++; continue; }                                     // The buffers are posted again on the descriptors
+    if (DescCount > 1) pMessage->View.Payload[1] = (pMessage->View.PayloadPartSize[1] > 0 ? pMessage->Buffer[1] : NULL); // The payload continues in the next descriptor buffer
+    pMessage->View.Status    = XCAN_RxDMA1_STS_GET(RIC1);
+    pMessage->View.Timestamp = ((uint64_t)XCAN_DESC_WORD(pDesc, XCAN_CAN_RXDESC_TS1) << 32) | (uint64_t)XCAN_DESC_WORD(pDesc, XCAN_CAN_RXDESC_TS0);
+    pMessage->View.Index     = First;
+    return ERR_OK;
+  }
+  return ERR__NO_DATA_AVAILABLE;
+}
+
+
+
+//=============================================================================
+// Receive the RX messages available in an RX FIFO Queue in Normal Mode without copying them
+//=============================================================================
+eERRORRESULT XCAN_ReceiveRxNormalMessages(XCAN *pComp, eXCAN_FIFOQueue queue, XCAN_RxNormalMessage* pMessages, size_t maxCount, size_t* pReceivedCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pMessages == NULL) || (pReceivedCount == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (queue >= XCAN_FIFO_QUEUE_COUNT) return ERR__PARAMETER_ERROR;
+  XCAN_RxFIFOQueueRing* pRing = &pComp->RxFIFO[queue];
+  if ((pRing->Desc == NULL) || (pRing->Buffers == NULL)) return ERR__CONFIGURATION;
+  size_t Received = 0;
+  while ((Received < maxCount) && (__XCAN_ReceiveRxNormalMessage(pComp, pRing, queue, &pMessages[Received]) == ERR_OK)) ++Received;
+  *pReceivedCount = Received;
+
+  //--- Re-arm the descriptors in the same pass ---
+  return __XCAN_RearmRxNormalDescriptors(pComp, pRing, queue, NULL);
+}
+
+
+
+//=============================================================================
+// Give back to the MH all the descriptors of an RX FIFO Queue in Normal Mode waiting for a buffer
+//=============================================================================
+eERRORRESULT XCAN_RearmRxNormalQueue(XCAN *pComp, eXCAN_FIFOQueue queue, size_t* pRearmedCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pComp == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (queue >= XCAN_FIFO_QUEUE_COUNT) return ERR__PARAMETER_ERROR;
+  XCAN_RxFIFOQueueRing* pRing = &pComp->RxFIFO[queue];
+  if ((pRing->Desc == NULL) || (pRing->Buffers == NULL)) return ERR__CONFIGURATION;
+  eERRORRESULT Error = __XCAN_RearmRxNormalDescriptors(pComp, pRing, queue, pRearmedCount);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling __XCAN_RearmRxNormalDescriptors() then return the error
+  return (pRing->Pending > 0 ? ERR__OUT_OF_MEMORY : ERR_OK);
+}
+
+
+
+//=============================================================================
+// [STATIC] Receive the next RX message of an RX FIFO Queue in Normal Mode as a list of segments
+//=============================================================================
+static eERRORRESULT __XCAN_ReceiveRxSegmentedMessage(XCAN *pComp, XCAN_RxFIFOQueueRing* pRing, eXCAN_FIFOQueue queue, XCAN_RxSegmentedMessage* pMessage, XCAN_RxSegment* pSegments, size_t maxSegments)
+{
+  uint16_t First;
+  XCAN_CAN_RxMessage* pDesc;
+  uint32_t RIC1, DescCount;
+  while (true)
+  {
+    if (pRing->Pending >= pRing->MaxDesc) return ERR__NO_DATA_AVAILABLE;                   // All descriptors are read and not yet re-armed
+    First = pRing->Head;
+    pDesc = &pRing->Desc[First];
+    RIC1  = XCAN_DESC_WORD(pDesc, XCAN_CAN_RXDESC_RIC1);
+    if (XCAN_RxDMA1_VALID_DATA_IS_AVAILABLE(RIC1) == false) return ERR__NO_DATA_AVAILABLE; // No more message received
+    if (pRing->SkipDesc > 0) { __XCAN_SkipRxNormalDescriptor(pRing); continue; }           // Trailing descriptor of a message larger than the link list
+    XCAN_MEMORY_BARRIER();                                                                 // The message shall be read after the VALID bit
+    const uint32_t MessageSize = __XCAN_DecodeRxMessage(pRing->Buffers[First], pRing->DCSizeBytes, 0, &pMessage->View);
+    DescCount = 1;
+    if ((RIC1 & XCAN_RxDMA1_NEXT_HAVE_NEXT_DESCRIPTOR) > 0) DescCount = (MessageSize + pRing->DCSizeBytes - 1u) / pRing->DCSizeBytes;
+    if (DescCount <= pRing->MaxDesc) break;
+    (void)XCAN_CheckRxRollingCounter(pComp, queue, RIC1, (uint16_t)DescCount);             // The message will never be in the link list at once, skip its descriptors as they come
+    pRing->Dropped++;
+    pRing->SkipDesc = (uint16_t)DescCount;
+    __XCAN_SkipRxNormalDescriptor(pRing);
+  }
+  if ((pRing->Pending + DescCount) > pRing->MaxDesc) return ERR__NO_DATA_AVAILABLE;        // The trailing descriptors are not in the link list yet
+  if (DescCount > maxSegments) return ERR__BUFFER_FULL;                                    // The message stays in the RX FIFO Queue
+  (void)XCAN_CheckRxRollingCounter(pComp, queue, RIC1, (uint16_t)DescCount);               // Each descriptor used by the RX message has its own RC
+
+  //--- Give the buffers to the application, one segment per descriptor ---
+  uint32_t Remaining = pMessage->View.PayloadSize;
+  for (size_t zDesc = 0; zDesc < DescCount; ++zDesc)
+  {
+    XCAN_RxSegment* pSegment = &pSegments[zDesc];
+    pSegment->Buffer = pRing->Buffers[pRing->Head];
+    if (zDesc == 0)                                                                        // The header descriptor starts with the header words
+    {
+      pSegment->Data = pMessage->View.Payload[0];
+      pSegment->Size = pMessage->View.PayloadPartSize[0];
+    }
+    else                                                                                   // The trailing descriptors only contain payload data
+    {
+      pSegment->Data = pSegment->Buffer;
+      pSegment->Size = (uint16_t)(Remaining < pRing->DCSizeBytes ? Remaining : pRing->DCSizeBytes);
+    }
+    Remaining -= pSegment->Size;
+    pRing->Buffers[pRing->Head] = NULL;                                                    // A fresh buffer will be posted on this descriptor
+    pRing->Head++;
+    if (pRing->Head >= pRing->MaxDesc) pRing->Head = 0;
+    pRing->Pending++;
+  }
+  pMessage->Segments                = pSegments;
+  pMessage->SegmentCount            = (uint16_t)DescCount;
+  pMessage->View.Payload[1]         = (DescCount > 1 ? pSegments[1].Data : NULL);
+  pMessage->View.PayloadPartSize[1] = (DescCount > 1 ? pSegments[1].Size : 0);
+  pMessage->View.Status             = XCAN_RxDMA1_STS_GET(RIC1);
+  pMessage->View.Timestamp          = ((uint64_t)XCAN_DESC_WORD(pDesc, XCAN_CAN_RXDESC_TS1) << 32) | (uint64_t)XCAN_DESC_WORD(pDesc, XCAN_CAN_RXDESC_TS0);
+  pMessage->View.Index              = First;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Receive the RX messages available in an RX FIFO Queue in Normal Mode as lists of segments without copying them
+//=============================================================================
+eERRORRESULT XCAN_ReceiveRxSegmentedMessages(XCAN *pComp, eXCAN_FIFOQueue queue, XCAN_RxSegmentedMessage* pMessages, size_t maxCount, XCAN_RxSegment* pSegments, size_t maxSegments, size_t* pReceivedCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pMessages == NULL) || (pSegments == NULL) || (pReceivedCount == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (queue >= XCAN_FIFO_QUEUE_COUNT) return ERR__PARAMETER_ERROR;
+  XCAN_RxFIFOQueueRing* pRing = &pComp->RxFIFO[queue];
+  if ((pRing->Desc == NULL) || (pRing->Buffers == NULL)) return ERR__CONFIGURATION;
+  eERRORRESULT Error = ERR_OK;
+  size_t Received = 0, SegmentsUsed = 0;
+  while (Received < maxCount)
+  {
+    Error = __XCAN_ReceiveRxSegmentedMessage(pComp, pRing, queue, &pMessages[Received], &pSegments[SegmentsUsed], maxSegments - SegmentsUsed);
+    if (Error != ERR_OK) break;                                                            // No more message or no more segments, stop here
+    SegmentsUsed += pMessages[Received].SegmentCount;
+    ++Received;
+  }
+  *pReceivedCount = Received;
+  if ((Error == ERR__BUFFER_FULL) && (Received > 0)) Error = ERR_OK;                       // The next message will be received by the next call
+  if (Error == ERR__NO_DATA_AVAILABLE) Error = ERR_OK;
+
+  //--- Re-arm the descriptors in the same pass ---
+  const eERRORRESULT RearmError = __XCAN_RearmRxNormalDescriptors(pComp, pRing, queue, NULL);
+  return (Error != ERR_OK ? Error : RearmError);
+}
+
+
+
+//=============================================================================
+// Release RX messages received with XCAN_ReceiveRxSegmentedMessages()
+//=============================================================================
+eERRORRESULT XCAN_ReleaseRxSegmentedMessages(XCAN *pComp, eXCAN_FIFOQueue queue, const XCAN_RxSegmentedMessage* pMessages, size_t count)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || ((pMessages == NULL) && (count > 0))) return ERR__PARAMETER_ERROR;
+#endif
+  if (queue >= XCAN_FIFO_QUEUE_COUNT) return ERR__PARAMETER_ERROR;
+  XCAN_RxFIFOQueueRing* pRing = &pComp->RxFIFO[queue];
+  if ((pRing->Desc == NULL) || (pRing->Buffers == NULL)) return ERR__CONFIGURATION;
+  for (size_t zMsg = 0; zMsg < count; ++zMsg)
+    for (size_t zSeg = 0; zSeg < pMessages[zMsg].SegmentCount; ++zSeg)
+      (void)XCAN_FreeRxBuffer(pRing->BufferPool, pMessages[zMsg].Segments[zSeg].Buffer);
+  if (pRing->Pending == 0) return ERR_OK;
+  return __XCAN_RearmRxNormalDescriptors(pComp, pRing, queue, NULL);                      // Re-arm the descriptors waiting for a buffer
+}
+
+
+
+//=============================================================================
+// Copy the payload of a segmented RX message in a contiguous buffer
+//=============================================================================
+eERRORRESULT XCAN_CopyRxSegments(const XCAN_RxSegmentedMessage* pMessage, uint8_t* pDest, size_t destSize)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pMessage == NULL) || (pDest == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (pMessage->View.PayloadSize > destSize) return ERR__BAD_DATA_SIZE;
+  for (size_t zSeg = 0; zSeg < pMessage->SegmentCount; ++zSeg)
+  {
+    memcpy(pDest, pMessage->Segments[zSeg].Data, pMessage->Segments[zSeg].Size);
+    pDest += pMessage->Segments[zSeg].Size;
+  }
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Set the drain order of the RX FIFO Queues by XCAN_PollRxFIFOQueues()
+//=============================================================================
+eERRORRESULT XCAN_SetRxPollOrder(XCAN *pComp, const eXCAN_FIFOQueue* pOrder)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pComp == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (pOrder == NULL) { pComp->RxPollOrder = 0; return ERR_OK; }
+  uint32_t Order = 0, Seen = 0;
+  for (size_t zPos = 0; zPos < XCAN_RX_FIFO_QUEUE_COUNT; ++zPos)
+  {
+    if (pOrder[zPos] >= XCAN_FIFO_QUEUE_COUNT) return ERR__PARAMETER_ERROR;
+    Seen  |= XCAN_FIFO_QUEUE_MASK(pOrder[zPos]);
+    Order |= (uint32_t)pOrder[zPos] << (zPos * 4u);
+  }
+  if (Seen != XCAN_FIFO_QUEUE_MASK_ALL) return ERR__PARAMETER_ERROR;                                          // Each queue shall appear once
+  pComp->RxPollOrder = Order;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// [STATIC] Drain an RX FIFO Queue in frames
+//=============================================================================
+static eERRORRESULT __XCAN_DrainRxFIFOQueue(XCAN *pComp, eXCAN_FIFOQueue queue, XCAN_RxFrame* pFrames, size_t maxCount, size_t* pDrainedCount)
+{
+  XCAN_RxFIFOQueueRing* pRing = &pComp->RxFIFO[queue];
+  eERRORRESULT Error = ERR_OK;
+  size_t Drained = 0;
+  while (Drained < maxCount)
+  {
+    XCAN_RxFrame* pFrame = &pFrames[Drained];
+    if (pRing->DataContainer != NULL)
+    {
+      for (size_t zBuf = 0; zBuf < XCAN_RX_NORMAL_MAX_DESC_PER_MESSAGE; ++zBuf) pFrame->Message.Buffer[zBuf] = NULL;
+      Error = __XCAN_ReadRxContinuousMessage(pComp, pRing, queue, &pFrame->Message.View);
+    }
+    else Error = __XCAN_ReceiveRxNormalMessage(pComp, pRing, queue, &pFrame->Message);
+    if (Error != ERR_OK) break;                                                            // No more message or error, stop here
+    pFrame->Queue = queue;
+    ++Drained;
+  }
+  *pDrainedCount = Drained;
+  if ((Error == ERR_OK) || (Error == ERR__NO_DATA_AVAILABLE))
+  {
+    if (pRing->Buffers != NULL) Error = __XCAN_RearmRxNormalDescriptors(pComp, pRing, queue, NULL); // Re-arm the descriptors in the same pass
+    else Error = ERR_OK;
+  }
+  return Error;
+}
+
+
+
+//=============================================================================
+// Poll all the configured RX FIFO Queues for received frames
+//=============================================================================
+eERRORRESULT XCAN_PollRxFIFOQueues(XCAN *pComp, XCAN_RxFrame* pFrames, size_t maxCount, size_t* pPolledCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pFrames == NULL) || (pPolledCount == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  *pPolledCount = 0;
+  eERRORRESULT Error;
+
+  //--- Get the queues to drain ---
+  uint32_t Configured = 0, Flagged = 0;
+  for (size_t zQueue = 0; zQueue < XCAN_RX_FIFO_QUEUE_COUNT; ++zQueue)
+  {
+    const XCAN_RxFIFOQueueRing* pRing = &pComp->RxFIFO[zQueue];
+    if (pRing->Desc == NULL) continue;
+    Configured |= XCAN_FIFO_QUEUE_MASK(zQueue);
+    if ((pRing->DescCtrl & XCAN_RxDMA1_IRQ_WHEN_SENT) == 0) Flagged |= XCAN_FIFO_QUEUE_MASK(zQueue); // No interrupt flag for this queue, always check it
+  }
+  if (Configured == 0) return ERR__CONFIGURATION;
+  if (Flagged != Configured)
+  {
+    uint32_t Raw;
+    Error = XCAN_ReadREG32(pComp, RegXCAN_FUNC_RAW, &Raw);
+    if (Error != ERR_OK) return Error;                                                     // If there is an error while calling XCAN_ReadREG32() then return the error
+    const uint32_t RawRx = (Raw & (XCAN_FIFO_QUEUE_MASK_ALL << XCAN_FUNC_MH_RX_FQ_Pos)) >> XCAN_FUNC_MH_RX_FQ_Pos;
+    if (RawRx != 0)
+    {
+      Error = XCAN_WriteREG32(pComp, RegXCAN_FUNC_CLR, RawRx << XCAN_FUNC_MH_RX_FQ_Pos);   // Cleared before draining to not miss a frame received during the poll
+      if (Error != ERR_OK) return Error;                                                   // If there is an error while calling XCAN_WriteREG32() then return the error
+    }
+    Flagged |= RawRx;
+  }
+  uint32_t ToDrain = (Flagged | pComp->RxPollCarry) & Configured;
+  pComp->RxPollCarry = 0;
+
+  //--- Drain the queues in the poll order ---
+  size_t Polled = 0;
+  Error = ERR_OK;
+  for (size_t zPos = 0; (zPos < XCAN_RX_FIFO_QUEUE_COUNT) && (ToDrain != 0); ++zPos)
+  {
+    const eXCAN_FIFOQueue Queue = (eXCAN_FIFOQueue)(pComp->RxPollOrder == 0 ? zPos : ((pComp->RxPollOrder >> (zPos * 4u)) & 0x7u));
+    const uint32_t QueueMask = XCAN_FIFO_QUEUE_MASK(Queue);
+    if ((ToDrain & QueueMask) == 0) continue;
+    ToDrain &= ~QueueMask;
+    if (Polled >= maxCount) { pComp->RxPollCarry |= (uint8_t)QueueMask; continue; }        // No room, the queue will be drained first by the next poll
+    size_t Drained;
+    Error = __XCAN_DrainRxFIFOQueue(pComp, Queue, &pFrames[Polled], maxCount - Polled, &Drained);
+    Polled += Drained;
+    if (Polled >= maxCount) pComp->RxPollCarry |= (uint8_t)QueueMask;                      // The queue may not be fully drained
+    if (Error != ERR_OK) break;                                                            // If there is an error while calling __XCAN_DrainRxFIFOQueue() then stop here
+  }
+  pComp->RxPollCarry |= (uint8_t)ToDrain;                                                  // Queues not visited after an error
+  *pPolledCount = Polled;
+  return Error;
+}
+
+
+
+//=============================================================================
+// Release the frames polled by XCAN_PollRxFIFOQueues()
+//=============================================================================
+eERRORRESULT XCAN_ReleaseRxPolledFrames(XCAN *pComp, const XCAN_RxFrame* pFrames, size_t count)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || ((pFrames == NULL) && (count > 0))) return ERR__PARAMETER_ERROR;
+#endif
+  size_t ContinuousCount[XCAN_RX_FIFO_QUEUE_COUNT] = { 0 };
+  uint32_t NormalQueues = 0;
+  for (size_t zFrame = 0; zFrame < count; ++zFrame)
+  {
+    const XCAN_RxFrame* pFrame = &pFrames[zFrame];
+    if (pFrame->Queue >= XCAN_FIFO_QUEUE_COUNT) return ERR__PARAMETER_ERROR;
+    const XCAN_RxFIFOQueueRing* pRing = &pComp->RxFIFO[pFrame->Queue];
+    if (pRing->DataContainer != NULL) { ContinuousCount[pFrame->Queue]++; continue; }
+    NormalQueues |= XCAN_FIFO_QUEUE_MASK(pFrame->Queue);
+    for (size_t zBuf = 0; zBuf < XCAN_RX_NORMAL_MAX_DESC_PER_MESSAGE; ++zBuf)
+      if ((pFrame->Message.Buffer[zBuf] != NULL) && (pRing->BufferPool != NULL)) XCAN_FreeRxBuffer(pRing->BufferPool, pFrame->Message.Buffer[zBuf]);
+  }
+
+  //--- One read address pointer update per queue in Continuous Mode, re-arm of the descriptors waiting for a buffer in Normal Mode ---
+  eERRORRESULT Error;
+  for (size_t zQueue = 0; zQueue < XCAN_RX_FIFO_QUEUE_COUNT; ++zQueue)
+  {
+    if (ContinuousCount[zQueue] > 0)
+    {
+      Error = XCAN_ReleaseRxContinuousMessages(pComp, (eXCAN_FIFOQueue)zQueue, ContinuousCount[zQueue]);
+      if (Error != ERR_OK) return Error;                                                   // If there is an error while calling XCAN_ReleaseRxContinuousMessages() then return the error
+    }
+    if (((NormalQueues & XCAN_FIFO_QUEUE_MASK(zQueue)) > 0) && (pComp->RxFIFO[zQueue].Pending > 0))
+    {
+      Error = __XCAN_RearmRxNormalDescriptors(pComp, &pComp->RxFIFO[zQueue], (eXCAN_FIFOQueue)zQueue, NULL);
+      if (Error != ERR_OK) return Error;                                                   // If there is an error while calling __XCAN_RearmRxNormalDescriptors() then return the error
+    }
+  }
+  return ERR_OK;
+}
+
+
+
+
+//=============================================================================
+// [STATIC] Set the RX FIFO Queues interrupts in FUNC_ENA
+//=============================================================================
+static eERRORRESULT __XCAN_SetRxQueuesInterrupts(XCAN *pComp, uint8_t queues)
+{
+  const uint32_t FuncEnable = (pComp->FuncEnable & ~(XCAN_FIFO_QUEUE_MASK_ALL << XCAN_FUNC_MH_RX_FQ_Pos)) | ((uint32_t)queues << XCAN_FUNC_MH_RX_FQ_Pos);
+  if (FuncEnable == pComp->FuncEnable) return ERR_OK;                                      // Already set, no write needed
+  eERRORRESULT Error = XCAN_WriteREG32(pComp, RegXCAN_FUNC_ENA, FuncEnable);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_WriteREG32() then return the error
+  pComp->FuncEnable = FuncEnable;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Configure the adaptive interrupt/poll RX
+//=============================================================================
+eERRORRESULT XCAN_ConfigureRxAdaptivePoll(XCAN *pComp, const XCAN_RxAdaptiveConfig* pConf)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pConf == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (pConf->DryPollsToIrq == 0) return ERR__PARAMETER_ERROR;
+  XCAN_RxAdaptiveState* pState = &pComp->RxAdaptive;
+  uint8_t IrqQueues = 0;
+  for (size_t zQueue = 0; zQueue < XCAN_RX_FIFO_QUEUE_COUNT; ++zQueue)
+    if ((pComp->RxFIFO[zQueue].Desc != NULL) && ((pComp->RxFIFO[zQueue].DescCtrl & XCAN_RxDMA1_IRQ_WHEN_SENT) > 0)) IrqQueues |= (uint8_t)XCAN_FIFO_QUEUE_MASK(zQueue);
+  if (IrqQueues == 0) return ERR__CONFIGURATION;                                           // No RX FIFO Queue can trigger an interrupt
+
+  //--- Start in interrupt mode ---
+  eERRORRESULT Error = XCAN_ReadREG32(pComp, RegXCAN_FUNC_ENA, &pComp->FuncEnable);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_ReadREG32() then return the error
+  pState->Enabled       = false;
+  pState->Polling       = false;
+  pState->DryThreshold  = pConf->DryThreshold;
+  pState->DryPollsToIrq = pConf->DryPollsToIrq;
+  pState->DryPolls      = 0;
+  pState->IrqQueues     = IrqQueues;
+  pState->IrqCount      = 0;
+  pState->PollCount     = 0;
+  Error = __XCAN_SetRxQueuesInterrupts(pComp, IrqQueues);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling __XCAN_SetRxQueuesInterrupts() then return the error
+  pState->Enabled = true;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Handle an RX FIFO Queues interrupt of the adaptive interrupt/poll RX
+//=============================================================================
+eERRORRESULT XCAN_RxAdaptiveInterruptHandler(XCAN *pComp, bool* pSchedulePoll)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pSchedulePoll == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  XCAN_RxAdaptiveState* pState = &pComp->RxAdaptive;
+  *pSchedulePoll = false;
+  if (pState->Enabled == false) return ERR__CONFIGURATION;
+  if (pState->Polling) return ERR_OK;                                                      // Already in poll mode
+  eERRORRESULT Error = __XCAN_SetRxQueuesInterrupts(pComp, 0);                             // Mask all the RX FIFO Queues interrupts during the poll mode
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling __XCAN_SetRxQueuesInterrupts() then return the error
+  pState->Polling  = true;
+  pState->DryPolls = 0;
+  pState->IrqCount++;
+  *pSchedulePoll = true;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Poll the RX FIFO Queues in poll mode of the adaptive interrupt/poll RX
+//=============================================================================
+eERRORRESULT XCAN_RxAdaptivePoll(XCAN *pComp, XCAN_RxFrame* pFrames, size_t maxCount, size_t* pPolledCount, bool* pPollAgain)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pPollAgain == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  XCAN_RxAdaptiveState* pState = &pComp->RxAdaptive;
+  *pPollAgain = false;
+  if (pState->Enabled == false) return ERR__CONFIGURATION;
+  eERRORRESULT Error = XCAN_PollRxFIFOQueues(pComp, pFrames, maxCount, pPolledCount);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_PollRxFIFOQueues() then return the error
+  if (pState->Polling == false) return ERR_OK;                                             // Poll in interrupt mode, nothing to switch
+  pState->PollCount++;
+
+  //--- Check if the RX FIFO Queues run dry ---
+  const bool Dry = (*pPolledCount <= pState->DryThreshold) && (*pPolledCount < maxCount) && (pComp->RxPollCarry == 0);
+  if (Dry == false) { pState->DryPolls = 0; *pPollAgain = true; return ERR_OK; }           // Still busy, stay in poll mode
+  if (pState->DryPolls < UINT8_MAX) pState->DryPolls++;
+  if (pState->DryPolls < pState->DryPollsToIrq) { *pPollAgain = true; return ERR_OK; }
+
+  //--- Back to interrupt mode ---
+  Error = __XCAN_SetRxQueuesInterrupts(pComp, pState->IrqQueues);                          // A frame received since the last poll has its flag set and triggers the interrupt right away
+  if (Error != ERR_OK) { *pPollAgain = true; return Error; }                               // If there is an error while calling __XCAN_SetRxQueuesInterrupts() then stay in poll mode and return the error
+  pState->Polling  = false;
+  pState->DryPolls = 0;
+  return ERR_OK;
+}
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// Configure the TX Priority Queue of the X_CAN device
+//=============================================================================
+eERRORRESULT XCAN_ConfigureTxPriorityQueue(XCAN *pComp, XCAN_CAN_TxMessage* pDescriptors, uint32_t enabledSlots)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pDescriptors == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (((uintptr_t)pDescriptors & 0x3u) != 0) return ERR__PARAMETER_ERROR;                  // The descriptors shall be 32-bits aligned
+  if (((pComp->DriverConfig & XCAN_DRIVER_TX_DESC_CRC) > 0) && (pComp->fnComputeCRC9 == NULL)) return ERR__CONFIGURATION;
+  eERRORRESULT Error;
+
+  //--- Check no slot is busy ---
+  uint32_t Status;
+  Error = XCAN_ReadREG32(pComp, RegXCAN_TX_PQ_STS0, &Status);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_ReadREG32() then return the error
+  if (XCAN_TX_PQ_STS0_BUSY_GET(Status) != 0) return ERR__NOT_READY;                        // The TX_PQ_START_ADD register is only writable when no slot is busy
+
+  //--- Initialize the descriptors and the slots state ---
+  XCAN_TxPriorityQueueSlots* pPQ = &pComp->TxPQ;
+  memset(pDescriptors, 0, XCAN_TX_PQ_SLOT_COUNT * sizeof(XCAN_CAN_TxMessage));            // All descriptors are not valid for the MH
+  memset(&pPQ->RollingCounter[0], 0, sizeof(pPQ->RollingCounter));
+  memset(&pPQ->Payloads[0], 0, sizeof(pPQ->Payloads));
+  pPQ->Desc            = pDescriptors;
+  pPQ->EnabledMask     = enabledSlots;
+  pPQ->FreeMask        = enabledSlots;
+  pPQ->PendingMask     = 0;
+  pPQ->PinnedMask      = 0;
+  pPQ->IrqWhenSentMask = 0;
+
+  //--- Configure the TX Priority Queue ---
+  Error = XCAN_WriteREG32(pComp, RegXCAN_TX_PQ_START_ADD, XCAN_TX_PQ_START_ADD_SET(XCAN_PTR_TO_SMEM_ADDRESS(pDescriptors)));
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_WriteREG32() then return the error
+  return XCAN_WriteREG32(pComp, RegXCAN_TX_PQ_CTRL2, XCAN_TX_PQ_CTRL2_ENABLE_SET(enabledSlots));
+}
+
+
+
+//=============================================================================
+// [STATIC] Free the payload buffer from the TX payload pool of a TX Priority Queue slot
+//=============================================================================
+static void __XCAN_FreeTxPQSlotPayload(XCAN *pComp, XCAN_TxPriorityQueueSlots* pPQ, uint32_t slot)
+{
+  if (pPQ->Payloads[slot] == NULL) return;
+  if (pComp->TxPayloadPool != NULL) XCAN_FreeTxPayload(pComp->TxPayloadPool, pPQ->Payloads[slot]); // The MH does not use the payload anymore
+  pPQ->Payloads[slot] = NULL;
+}
+
+
+
+//=============================================================================
+// Reclaim the TX Priority Queue slots that are no more busy
+//=============================================================================
+eERRORRESULT XCAN_ReclaimTxPQSlots(XCAN *pComp, uint32_t* pCompletedSlots)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pComp == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  XCAN_TxPriorityQueueSlots* pPQ = &pComp->TxPQ;
+  if (pPQ->Desc == NULL) return ERR__CONFIGURATION;
+  uint32_t Completed = 0;
+  if (pPQ->PendingMask != 0)
+  {
+    uint32_t Status;
+    eERRORRESULT Error = XCAN_ReadREG32(pComp, RegXCAN_TX_PQ_STS0, &Status);
+    if (Error != ERR_OK) return Error;                                                     // If there is an error while calling XCAN_ReadREG32() then return the error
+    Completed         = pPQ->PendingMask & ~XCAN_TX_PQ_STS0_BUSY_GET(Status);
+    pPQ->PendingMask &= ~Completed;
+    pPQ->FreeMask    |= (Completed & ~pPQ->PinnedMask);                                    // Pinned slots stay owned by their periodic message
+    for (uint32_t Slots = (Completed & ~pPQ->PinnedMask); Slots != 0; Slots &= (Slots - 1u)) __XCAN_FreeTxPQSlotPayload(pComp, pPQ, XCAN_CTZ32(Slots));
+  }
+  if (pCompletedSlots != NULL) *pCompletedSlots = Completed;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// [STATIC] Publish the descriptor of a TX Priority Queue slot and start the slot
+//=============================================================================
+static eERRORRESULT __XCAN_StartTxPQSlot(XCAN *pComp, XCAN_TxPriorityQueueSlots* pPQ, uint32_t slot, bool irqWhenSent)
+{
+  XCAN_CAN_TxMessage* pDesc = &pPQ->Desc[slot];
+  const uint32_t SlotMask = (1u << slot);
+
+  //--- Fill the driver part of the descriptor ---
+  uint32_t TIC1 = XCAN_TxDMA1_RC_SET(pPQ->RollingCounter[slot]) | XCAN_TxDMA1_PQSN_SET(slot) | XCAN_TxDMA1_PQ_TX_PRIORITY_QUEUE
+                | (irqWhenSent ? XCAN_TxDMA1_IRQ_WHEN_SENT : XCAN_TxDMA1_IRQ_NO_IRQ)
+                | XCAN_TxDMA1_HD | XCAN_TxDMA1_VALID_SET_VALID_FOR_MH;
+  pDesc->TIC2.TxDMAinfoCtrl2 &= ~(XCAN_TxDMA2_IN_Mask | XCAN_TxDMA2_TDO_Mask);
+  pDesc->TIC2.TxDMAinfoCtrl2 |= XCAN_TxDMA2_IN_SET(pComp->InstanceNumber) | XCAN_TxDMA2_TDO_SET(XCAN_TxDMA2_TDO_VALUE);
+  pDesc->TS0 = 0;
+  pDesc->TS1 = 0;
+  TIC1 |= __XCAN_TxDescriptorCRC(pComp, pDesc, TIC1);
+
+  //--- Hand over the descriptor to the MH and start the slot ---
+  XCAN_MEMORY_BARRIER();                                                                   // All the descriptor shall be written before the VALID bit
+  XCAN_DESC_WORD(pDesc, XCAN_CAN_TXDESC_TIC1) = TIC1;
+  pPQ->RollingCounter[slot] = (pPQ->RollingCounter[slot] + 1u) & XCAN_ROLLING_COUNTER_Mask;
+  pPQ->PendingMask |= SlotMask;
+  XCAN_MEMORY_BARRIER();                                                                   // The VALID bit shall be written before starting the slot
+  return XCAN_WriteREG32(pComp, RegXCAN_TX_PQ_CTRL0, XCAN_TX_PQ_CTRL0_START_SET(SlotMask));
+}
+
+
+
+//=============================================================================
+// [STATIC] Allocate the lowest free TX Priority Queue slot
+//=============================================================================
+static eERRORRESULT __XCAN_AllocateTxPQSlot(XCAN *pComp, uint32_t* pSlot)
+{
+  XCAN_TxPriorityQueueSlots* pPQ = &pComp->TxPQ;
+  if (pPQ->Desc == NULL) return ERR__CONFIGURATION;
+  if (pPQ->FreeMask == 0)
+  {
+    eERRORRESULT Error = XCAN_ReclaimTxPQSlots(pComp, NULL);                               // Reclaim only when needed to save register reads
+    if (Error != ERR_OK) return Error;                                                     // If there is an error while calling XCAN_ReclaimTxPQSlots() then return the error
+    if (pPQ->FreeMask == 0) return ERR__BUFFER_FULL;
+  }
+  *pSlot = XCAN_CTZ32(pPQ->FreeMask);
+  pPQ->FreeMask &= (pPQ->FreeMask - 1u);                                                   // Clear the lowest bit set
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Transmit a message through a free slot of the TX Priority Queue
+//=============================================================================
+eERRORRESULT XCAN_TransmitMessageToTxPQ(XCAN *pComp, const XCAN_CANMessage* pMessage, bool irqWhenSent, uint8_t* pSlot)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pMessage == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  XCAN_TxPriorityQueueSlots* pPQ = &pComp->TxPQ;
+  uint32_t Slot;
+  eERRORRESULT Error = __XCAN_AllocateTxPQSlot(pComp, &Slot);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling __XCAN_AllocateTxPQSlot() then return the error
+  Error = __XCAN_BuildTxDescriptor(pMessage, &pPQ->Desc[Slot]);
+  if (Error != ERR_OK) { pPQ->FreeMask |= (1u << Slot); return Error; }                    // If there is an error while calling __XCAN_BuildTxDescriptor() then release the slot and return the error
+  pPQ->Payloads[Slot] = __XCAN_GetTxPoolPayload(pComp, pMessage, &pPQ->Desc[Slot]);
+  if (pSlot != NULL) *pSlot = (uint8_t)Slot;
+  return __XCAN_StartTxPQSlot(pComp, pPQ, Slot, irqWhenSent);
+}
+
+
+
+//=============================================================================
+// Pin a TX Priority Queue slot to a periodic message
+//=============================================================================
+eERRORRESULT XCAN_PinTxPQSlot(XCAN *pComp, const XCAN_CANMessage* pMessage, bool irqWhenSent, uint8_t* pSlot)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pMessage == NULL) || (pSlot == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  XCAN_TxPriorityQueueSlots* pPQ = &pComp->TxPQ;
+  uint32_t Slot;
+  eERRORRESULT Error = __XCAN_AllocateTxPQSlot(pComp, &Slot);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling __XCAN_AllocateTxPQSlot() then return the error
+  Error = __XCAN_BuildTxDescriptor(pMessage, &pPQ->Desc[Slot]);
+  if (Error != ERR_OK) { pPQ->FreeMask |= (1u << Slot); return Error; }                    // If there is an error while calling __XCAN_BuildTxDescriptor() then release the slot and return the error
+  pPQ->Payloads[Slot] = __XCAN_GetTxPoolPayload(pComp, pMessage, &pPQ->Desc[Slot]);       // Kept by the slot until it is unpinned
+  pPQ->PinnedMask |= (1u << Slot);
+  if (irqWhenSent) pPQ->IrqWhenSentMask |= (1u << Slot);
+  else             pPQ->IrqWhenSentMask &= ~(1u << Slot);
+  *pSlot = (uint8_t)Slot;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Patch the payload of a pinned TX Priority Queue slot and restart it
+//=============================================================================
+eERRORRESULT XCAN_RestartPinnedTxPQSlot(XCAN *pComp, uint8_t slot, const uint8_t* pData)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pComp == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (slot >= XCAN_TX_PQ_SLOT_COUNT) return ERR__PARAMETER_ERROR;
+  XCAN_TxPriorityQueueSlots* pPQ = &pComp->TxPQ;
+  if (pPQ->Desc == NULL) return ERR__CONFIGURATION;
+  const uint32_t SlotMask = (1u << slot);
+  if ((pPQ->PinnedMask & SlotMask) == 0) return ERR__PARAMETER_ERROR;                      // Only a pinned slot can be restarted
+  XCAN_CAN_TxMessage* pDesc = &pPQ->Desc[slot];
+  if (XCAN_TX_DESC_OWNED_BY_MH(pDesc)) return ERR__NOT_READY;                              // The previous message is not acknowledged by the MH yet
+
+  //--- Patch the payload in place ---
+  if (pData != NULL)
+  {
+    const bool InDescriptor = ((pDesc->TIC2.TxDMAinfoCtrl2 & XCAN_TxDMA1_PLSRC_IN_DATA_CONTAINER) == 0);
+    size_t PayloadSize = 4;                                                                // With a data container, only TD0 (copy of the first 4 bytes) is in the descriptor
+    if (InDescriptor)
+    {
+      const bool IsCANFD = ((pDesc->T0.T0 & XCAN_T0_FDF) > 0);
+      PayloadSize = ((pDesc->T1.T1 & XCAN_T1_RTR) > 0 ? 0u : XCAN_DLCToByte(XCAN_T1_DLC_GET(pDesc->T1.T1), IsCANFD));
+    }
+    if ((pDesc->T0.T0 & XCAN_T0_XLF) == 0)                                                 // CAN-XL payload is only in the data container
+    {
+      pDesc->TD0 = (PayloadSize > 0 ? __XCAN_PackPayloadWord(pData, (PayloadSize > 4u ? 4u : PayloadSize)) : 0u);
+      if (InDescriptor && ((pDesc->T0.T0 & XCAN_T0_FDF) == 0))                             // CAN2.0: last 4 bytes in TD1
+        pDesc->TD1 = (PayloadSize > 4u ? __XCAN_PackPayloadWord(&pData[4], PayloadSize - 4u) : 0u);
+    }
+  }
+  return __XCAN_StartTxPQSlot(pComp, pPQ, slot, ((pPQ->IrqWhenSentMask & SlotMask) > 0));
+}
+
+
+
+//=============================================================================
+// Unpin a TX Priority Queue slot
+//=============================================================================
+eERRORRESULT XCAN_UnpinTxPQSlot(XCAN *pComp, uint8_t slot)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pComp == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (slot >= XCAN_TX_PQ_SLOT_COUNT) return ERR__PARAMETER_ERROR;
+  XCAN_TxPriorityQueueSlots* pPQ = &pComp->TxPQ;
+  const uint32_t SlotMask = (1u << slot);
+  if ((pPQ->PinnedMask & SlotMask) == 0) return ERR__PARAMETER_ERROR;
+  pPQ->PinnedMask      &= ~SlotMask;
+  pPQ->IrqWhenSentMask &= ~SlotMask;
+  if ((pPQ->PendingMask & SlotMask) == 0)                                                  // A pending slot will be freed by the next reclaim
+  {
+    pPQ->FreeMask |= SlotMask;
+    __XCAN_FreeTxPQSlotPayload(pComp, pPQ, slot);
+  }
+  return ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// [STATIC] Write a locked register after the unlock sequence
+//=============================================================================
+static eERRORRESULT __XCAN_WriteLockedREG32(XCAN *pComp, eXCAN_Registers reg, uint32_t data)
+{
+  eERRORRESULT Error = XCAN_WriteREG32(pComp, RegXCAN_MH_LOCK, XCAN_MH_LOCK_ULK_SET(XCAN_IC_ULK_UNLOCK_KEY1));
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_WriteREG32() then return the error
+  Error = XCAN_WriteREG32(pComp, RegXCAN_MH_LOCK, XCAN_MH_LOCK_ULK_SET(XCAN_IC_ULK_UNLOCK_KEY2));
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_WriteREG32() then return the error
+  return XCAN_WriteREG32(pComp, reg, data);
+}
+
+
+
+//=============================================================================
+// [STATIC] Set or clear ABORT bits of a locked ABORT register
+//=============================================================================
+static eERRORRESULT __XCAN_SetAbortBits(XCAN *pComp, eXCAN_Registers reg, uint32_t mask, bool abort)
+{
+  uint32_t Current;
+  eERRORRESULT Error = XCAN_ReadREG32(pComp, reg, &Current);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_ReadREG32() then return the error
+  return __XCAN_WriteLockedREG32(pComp, reg, (abort ? (Current | mask) : (Current & ~mask))); // Do not change the ABORT bits of the other queues
+}
+
+
+
+//=============================================================================
+// [STATIC] Store an unsent descriptor or drop it if there is no room
+//=============================================================================
+static bool __XCAN_StoreUnsentDescriptor(XCAN *pComp, const XCAN_CAN_TxMessage* pDesc, uint8_t* pPayloadBuffer, bool fromPQ, uint8_t queue,
+                                         XCAN_TxUnsentDescriptor* pUnsent, size_t maxUnsent, size_t* pStored)
+{
+  if (*pStored >= maxUnsent)
+  {
+    if ((pPayloadBuffer != NULL) && (pComp->TxPayloadPool != NULL)) XCAN_FreeTxPayload(pComp->TxPayloadPool, pPayloadBuffer);
+    return false;                                                                          // No room, the descriptor is dropped
+  }
+  XCAN_TxUnsentDescriptor* pEntry = &pUnsent[(*pStored)++];
+  memcpy(&pEntry->Desc, pDesc, sizeof(XCAN_CAN_TxMessage));
+  pEntry->PayloadBuffer     = pPayloadBuffer;
+  pEntry->FromPriorityQueue = fromPQ;
+  pEntry->Queue             = queue;
+  return true;
+}
+
+
+
+//=============================================================================
+// Abort a set of TX FIFO Queues and TX Priority Queue slots together
+//=============================================================================
+eERRORRESULT XCAN_AbortTxQueues(XCAN *pComp, uint8_t fifoQueues, uint32_t pqSlots, uint32_t timeoutMs, XCAN_TxUnsentDescriptor* pUnsent, size_t maxUnsent, size_t* pUnsentCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pComp == NULL) return ERR__PARAMETER_ERROR;
+  if ((pUnsent == NULL) && (maxUnsent > 0)) return ERR__PARAMETER_ERROR;
+#endif
+  if (pComp->fnGetCurrentms == NULL) return ERR__CONFIGURATION;
+  if (pUnsentCount != NULL) *pUnsentCount = 0;
+  eERRORRESULT Error;
+
+  //--- Abort all queues and slots, one unlock per register ---
+  if (fifoQueues != 0)
+  {
+    Error = __XCAN_SetAbortBits(pComp, RegXCAN_TX_FQ_CTRL1, XCAN_TX_FQ_CTRL1_SET(fifoQueues), true);
+    if (Error != ERR_OK) return Error;                                                     // If there is an error while calling __XCAN_SetAbortBits() then return the error
+  }
+  if (pqSlots != 0)
+  {
+    Error = __XCAN_SetAbortBits(pComp, RegXCAN_TX_PQ_CTRL1, XCAN_TX_PQ_CTRL1_ABORT_SET(pqSlots), true);
+    if (Error != ERR_OK) return Error;                                                     // If there is an error while calling __XCAN_SetAbortBits() then return the error
+  }
+
+  //--- Wait all of them inactive in the same loop ---
+  const uint32_t StartTime = pComp->fnGetCurrentms();
+  uint32_t FQBusy = fifoQueues, PQBusy = pqSlots, Status;
+  while (true)
+  {
+    if (FQBusy != 0)
+    {
+      Error = XCAN_ReadREG32(pComp, RegXCAN_TX_FQ_STS0, &Status);
+      if (Error != ERR_OK) return Error;                                                   // If there is an error while calling XCAN_ReadREG32() then return the error
+      FQBusy = XCAN_TX_FQ_STS0_BUSY_GET(Status) & fifoQueues;
+    }
+    if (PQBusy != 0)
+    {
+      Error = XCAN_ReadREG32(pComp, RegXCAN_TX_PQ_STS0, &Status);
+      if (Error != ERR_OK) return Error;                                                   // If there is an error while calling XCAN_ReadREG32() then return the error
+      PQBusy = XCAN_TX_PQ_STS0_BUSY_GET(Status) & pqSlots;
+    }
+    if ((FQBusy | PQBusy) == 0) break;
+    if (XCAN_TIME_DIFF(StartTime, pComp->fnGetCurrentms()) > timeoutMs) return ERR__DEVICE_TIMEOUT; // ABORT bits stay set, they can only be cleared when the queues are inactive
+  }
+
+  //--- Set back ABORT to 0 ---
+  if (fifoQueues != 0)
+  {
+    Error = __XCAN_SetAbortBits(pComp, RegXCAN_TX_FQ_CTRL1, XCAN_TX_FQ_CTRL1_SET(fifoQueues), false);
+    if (Error != ERR_OK) return Error;                                                     // If there is an error while calling __XCAN_SetAbortBits() then return the error
+  }
+  if (pqSlots != 0)
+  {
+    Error = __XCAN_SetAbortBits(pComp, RegXCAN_TX_PQ_CTRL1, XCAN_TX_PQ_CTRL1_ABORT_SET(pqSlots), false);
+    if (Error != ERR_OK) return Error;                                                     // If there is an error while calling __XCAN_SetAbortBits() then return the error
+  }
+
+  //--- Copy out the unsent descriptors of the TX FIFO Queues and reset them ---
+  size_t Stored = 0;
+  bool AllStored = true;
+  for (uint32_t Queues = fifoQueues; Queues != 0; Queues &= (Queues - 1u))
+  {
+    const eXCAN_FIFOQueue Queue = (eXCAN_FIFOQueue)XCAN_CTZ32(Queues);
+    XCAN_TxFIFOQueueRing* pRing = &pComp->TxFIFO[Queue];
+    if (pRing->Desc == NULL) continue;
+    XCAN_TxCompletion Completions[XCAN_TX_COMPLETION_BATCH_SIZE];
+    size_t Harvested;
+    do                                                                                     // The messages sent before the abort are completed normally
+    {
+      Error = XCAN_HarvestTxFIFOQueue(pComp, Queue, &Completions[0], XCAN_TX_COMPLETION_BATCH_SIZE, &Harvested);
+      if (Error != ERR_OK) return Error;                                                   // If there is an error while calling XCAN_HarvestTxFIFOQueue() then return the error
+    } while (Harvested == XCAN_TX_COMPLETION_BATCH_SIZE);
+    while (pRing->InFlight > 0)                                                            // The remaining descriptors were not sent, in the sent order
+    {
+      uint8_t* pPayloadBuffer = (pRing->Payloads != NULL ? pRing->Payloads[pRing->Tail] : NULL);
+      AllStored &= __XCAN_StoreUnsentDescriptor(pComp, &pRing->Desc[pRing->Tail], pPayloadBuffer, false, (uint8_t)Queue, pUnsent, maxUnsent, &Stored);
+      pRing->Tail++;
+      if (pRing->Tail >= pRing->MaxDesc) pRing->Tail = 0;
+      pRing->InFlight--;
+    }
+    memset(pRing->Desc, 0, (size_t)pRing->MaxDesc * sizeof(XCAN_CAN_TxMessage));          // An aborted TX FIFO Queue restarts from its first descriptor
+    if (pRing->Payloads != NULL) memset(pRing->Payloads, 0, (size_t)pRing->MaxDesc * sizeof(uint8_t*));
+    pRing->Head = 0;
+    pRing->Tail = 0;
+    pRing->RollingCounter        = 0;
+    pRing->HarvestRollingCounter = 0;
+  }
+
+  //--- Copy out the unsent descriptors of the TX Priority Queue slots ---
+  XCAN_TxPriorityQueueSlots* pPQ = &pComp->TxPQ;
+  if (pPQ->Desc != NULL)
+  {
+    for (uint32_t Slots = (pqSlots & pPQ->PendingMask); Slots != 0; Slots &= (Slots - 1u))
+    {
+      const uint32_t Slot = XCAN_CTZ32(Slots);
+      const uint32_t SlotMask = (1u << Slot);
+      XCAN_CAN_TxMessage* pDesc = &pPQ->Desc[Slot];
+      if (XCAN_TX_DESC_OWNED_BY_MH(pDesc))
+      {
+        if ((pPQ->PinnedMask & SlotMask) == 0)
+        {
+          AllStored &= __XCAN_StoreUnsentDescriptor(pComp, pDesc, pPQ->Payloads[Slot], true, (uint8_t)Slot, pUnsent, maxUnsent, &Stored);
+          pPQ->Payloads[Slot] = NULL;                                                      // The payload buffer is owned by the unsent descriptor now
+        }
+        XCAN_DESC_WORD(pDesc, XCAN_CAN_TXDESC_TIC1) &= ~XCAN_TxDMA1_VALID_SET_VALID_FOR_MH; // The slot is owned by the SW again
+      }
+      pPQ->PendingMask &= ~SlotMask;
+      if ((pPQ->PinnedMask & SlotMask) == 0)
+      {
+        pPQ->FreeMask |= SlotMask;
+        __XCAN_FreeTxPQSlotPayload(pComp, pPQ, Slot);                                      // Message sent before the abort
+      }
+    }
+  }
+  if (pUnsentCount != NULL) *pUnsentCount = Stored;
+  return (AllStored ? ERR_OK : ERR__BUFFER_FULL);
+}
+
+
+
+//=============================================================================
+// [STATIC] Copy the message part of an unsent descriptor in a descriptor
+//=============================================================================
+static void __XCAN_CopyTxMessagePart(XCAN_CAN_TxMessage* pDest, const XCAN_CAN_TxMessage* pSource)
+{
+  pDest->TIC2.TxDMAinfoCtrl2 = pSource->TIC2.TxDMAinfoCtrl2 & (XCAN_TxDMA2_SIZE_Mask | XCAN_TxDMA1_PLSRC_IN_DATA_CONTAINER);
+  pDest->T0.T0 = pSource->T0.T0;
+  pDest->T1.T1 = pSource->T1.T1;
+  pDest->TD0   = pSource->TD0;
+  pDest->TD1   = pSource->TD1;
+}
+
+
+
+//=============================================================================
+// Requeue unsent TX descriptors
+//=============================================================================
+eERRORRESULT XCAN_RequeueTxDescriptors(XCAN *pComp, const XCAN_TxUnsentDescriptor* pUnsent, size_t count, XCAN_TxRequeueFilter_Func fnKeep, void* pContext, size_t* pRequeuedCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || ((pUnsent == NULL) && (count > 0))) return ERR__PARAMETER_ERROR;
+#endif
+  eERRORRESULT Error = ERR_OK;
+  uint32_t QueuesToStart = 0;
+  size_t Requeued = 0;
+
+  for (size_t zDesc = 0; zDesc < count; ++zDesc)
+  {
+    const XCAN_TxUnsentDescriptor* pEntry = &pUnsent[zDesc];
+    if ((fnKeep != NULL) && (fnKeep(pContext, pEntry) == false))                          // Dropped by the filter
+    {
+      if ((pEntry->PayloadBuffer != NULL) && (pComp->TxPayloadPool != NULL)) XCAN_FreeTxPayload(pComp->TxPayloadPool, pEntry->PayloadBuffer);
+      continue;
+    }
+    const bool IrqWhenSent = ((pEntry->Desc.Word[XCAN_CAN_TXDESC_TIC1] & XCAN_TxDMA1_IRQ_WHEN_SENT) > 0);
+    if (pEntry->FromPriorityQueue)
+    {
+      uint32_t Slot;
+      Error = __XCAN_AllocateTxPQSlot(pComp, &Slot);
+      if (Error != ERR_OK) break;                                                          // If there is an error while calling __XCAN_AllocateTxPQSlot() then stop here
+      __XCAN_CopyTxMessagePart(&pComp->TxPQ.Desc[Slot], &pEntry->Desc);
+      pComp->TxPQ.Payloads[Slot] = pEntry->PayloadBuffer;
+      Error = __XCAN_StartTxPQSlot(pComp, &pComp->TxPQ, Slot, IrqWhenSent);
+    }
+    else
+    {
+      const eXCAN_FIFOQueue Queue = (eXCAN_FIFOQueue)pEntry->Queue;
+      XCAN_CAN_TxMessage* pDesc;
+      Error = XCAN_GetNextTxFIFODescriptor(pComp, Queue, &pDesc);
+      if (Error != ERR_OK) break;                                                          // If there is an error while calling XCAN_GetNextTxFIFODescriptor() then stop here
+      XCAN_TxFIFOQueueRing* pRing = &pComp->TxFIFO[Queue];
+      __XCAN_CopyTxMessagePart(pDesc, &pEntry->Desc);
+      if (pRing->Payloads != NULL) pRing->Payloads[pRing->Head] = pEntry->PayloadBuffer;
+      Error = __XCAN_PublishTxFIFODescriptor(pComp, pRing, Queue, IrqWhenSent);
+      QueuesToStart |= XCAN_FIFO_QUEUE_MASK(Queue);
+    }
+    if (Error != ERR_OK) break;
+    ++Requeued;
+  }
+  if (pRequeuedCount != NULL) *pRequeuedCount = Requeued;
+
+  //--- One START for all the TX FIFO Queues requeued ---
+  if (QueuesToStart != 0)
+  {
+    XCAN_MEMORY_BARRIER();                                                                 // The VALID bits shall be written before starting the TX FIFO Queues
+    eERRORRESULT ErrorStart = XCAN_WriteREG32(pComp, RegXCAN_TX_FQ_CTRL0, XCAN_TX_FQ_CTRL0_SET(QueuesToStart));
+    if (ErrorStart != ERR_OK) return ErrorStart;                                           // If there is an error while calling XCAN_WriteREG32() then return the error
+  }
+  return Error;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// Configure the RX filters of the X_CAN device
+//=============================================================================
+eERRORRESULT XCAN_ConfigureRxFilters(XCAN *pComp, const XCAN_RxFilterConfig* pConf)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pConf == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (pConf->DefaultQueue >= XCAN_FIFO_QUEUE_COUNT) return ERR__PARAMETER_ERROR;
+  if ((pConf->ElementsAddress & 0x3u) != 0) return ERR__PARAMETER_ERROR;                   // The table shall be 32-bits aligned
+  eERRORRESULT Error;
+
+  Error = XCAN_WriteREG32(pComp, RegXCAN_RX_FILTER_MEM_ADD, XCAN_RX_FILTER_MEM_ADD_BASE_ADDR_SET(pConf->ElementsAddress));
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_WriteREG32() then return the error
+  uint32_t Ctrl;
+  Error = XCAN_ReadREG32(pComp, RegXCAN_RX_FILTER_CTRL, &Ctrl);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_ReadREG32() then return the error
+  Ctrl &= (XCAN_RX_FILTER_CTRL_THRESHOLD_Mask | XCAN_RX_FILTER_CTRL_ROUTE_NOT_FILTERED_IN_TIME); // Keep the threshold mechanism
+  Ctrl |= XCAN_RX_FILTER_CTRL_NB_FE_SET(pConf->ElementCount) | XCAN_RX_FILTER_CTRL_ANMF_FQ_SET(pConf->DefaultQueue);
+  if (pConf->AcceptNonMatching) Ctrl |= XCAN_RX_FILTER_CTRL_ACCEPT_NON_MATCHING_FRAMES;
+  return XCAN_WriteREG32(pComp, RegXCAN_RX_FILTER_CTRL, Ctrl);
+}
+
+
+
+//=============================================================================
+// Set the RX filtering threshold of the X_CAN device
+//=============================================================================
+eERRORRESULT XCAN_SetRxFilterThreshold(XCAN *pComp, uint8_t threshold)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pComp == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (threshold > XCAN_RX_FILTER_THRESHOLD_MAX) return ERR__OUT_OF_RANGE;
+  uint32_t Ctrl;
+  eERRORRESULT Error = XCAN_ReadREG32(pComp, RegXCAN_RX_FILTER_CTRL, &Ctrl);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_ReadREG32() then return the error
+  Ctrl &= ~(XCAN_RX_FILTER_CTRL_THRESHOLD_Mask | XCAN_RX_FILTER_CTRL_ROUTE_NOT_FILTERED_IN_TIME);
+  if (threshold > 0) Ctrl |= XCAN_RX_FILTER_CTRL_THRESHOLD_SET(threshold) | XCAN_RX_FILTER_CTRL_ROUTE_NOT_FILTERED_IN_TIME; // THRESHOLD is only used with ANFF
+  return XCAN_WriteREG32(pComp, RegXCAN_RX_FILTER_CTRL, Ctrl);
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// Configure the TX filter of the X_CAN device
+//=============================================================================
+eERRORRESULT XCAN_ConfigureTxFilter(XCAN *pComp, const XCAN_TxFilterConfig* pConf)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pConf == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  eERRORRESULT Error;
+  uint32_t Status;
+  Error = XCAN_ReadREG32(pComp, RegXCAN_MH_STS, &Status);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_ReadREG32() then return the error
+  if ((Status & XCAN_MH_STS_BUSY) > 0) return ERR__NOT_READY;                              // The TX filter registers are only writable when the MH is not busy
+
+  //--- Write the elements with the filter disabled ---
+  Error = XCAN_WriteREG32(pComp, RegXCAN_TX_FILTER_CTRL0, 0);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_WriteREG32() then return the error
+  Error = XCAN_WriteREG32(pComp, RegXCAN_TX_FILTER_CTRL1, pConf->Ctrl1);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_WriteREG32() then return the error
+  for (size_t zReg = 0; zReg < XCAN_TX_FILTER_REFVAL_COUNT; ++zReg)
+  {
+    Error = XCAN_WriteREG32(pComp, RegXCAN_TX_FILTER_REFVALn(zReg), pConf->RefVal[zReg]);
+    if (Error != ERR_OK) return Error;                                                     // If there is an error while calling XCAN_WriteREG32() then return the error
+  }
+  return XCAN_WriteREG32(pComp, RegXCAN_TX_FILTER_CTRL0, pConf->Ctrl0);
+}
+
+
+
+//=============================================================================
+// Get the TX queue of the last message rejected by the TX filter
+//=============================================================================
+eERRORRESULT XCAN_GetTxFilterRejection(XCAN *pComp, XCAN_TxFilterRejection* pRejection)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pRejection == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  uint32_t Info;
+  eERRORRESULT Error = XCAN_ReadREG32(pComp, RegXCAN_TX_FILTER_ERR_INFO, &Info);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_ReadREG32() then return the error
+  pRejection->FIFOQueue = ((Info & XCAN_TX_FILTER_ERR_INFO_FIFO_QUEUE_TRIGGERED) > 0);
+  pRejection->Number    = (uint8_t)XCAN_TX_FILTER_ERR_INFO_FQN_PQS_GET(Info);
+  return ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
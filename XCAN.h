@@ -0,0 +1,1147 @@
+/*!*****************************************************************************
+ * @file    XCAN.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN driver
+ * @details
+ * The X_CAN Controller IP is a CAN-bus controller supporting CAN2.0A, CAN2.0B,
+ *   CAN-FD, CAN-XL
+ * Follow datasheet X_CAN user manual v3.50 (Nov 2022)
+ * The descriptors and payloads are in the system memory (S_MEM) and must be
+ *   directly accessible by the CPU. The registers are accessed through the
+ *   interface functions of the device structure
+ ******************************************************************************/
+/* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#ifndef XCAN_H_INC
+#define XCAN_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include "XCAN_core.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+  extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+//! Memory barrier used before handing over a descriptor to the MH. Can be overridden in Conf_XCAN.h (for example with a DMB instruction)
+#ifndef XCAN_MEMORY_BARRIER
+#  define XCAN_MEMORY_BARRIER()  __sync_synchronize()
+#endif
+
+//! Convert a CPU pointer to an address as seen by the MH in the S_MEM. Can be overridden in Conf_XCAN.h if the MH does not see the memory at the same address than the CPU
+#ifndef XCAN_PTR_TO_SMEM_ADDRESS
+#  define XCAN_PTR_TO_SMEM_ADDRESS(ptr)  ( (uint32_t)(uintptr_t)(ptr) )
+#endif
+
+//! Time difference in milliseconds between 2 values of XCAN.fnGetCurrentms(), with the counter roll over
+#define XCAN_TIME_DIFF(begin,end)  ( ((end) >= (begin)) ? ((end) - (begin)) : (UINT32_MAX - ((begin) - (end) - 1)) )
+
+//-----------------------------------------------------------------------------
+
+#define XCAN_TX_FIFO_QUEUE_COUNT     ( 8 )    //!< Count of TX FIFO Queues
+#define XCAN_RX_FIFO_QUEUE_COUNT     ( 8 )    //!< Count of RX FIFO Queues
+#define XCAN_TX_FIFO_QUEUE_MAX_DESC  ( 1023 ) //!< Maximum descriptors in a TX FIFO Queue link list (MAX_DESC is 10-bits)
+#define XCAN_RX_FIFO_QUEUE_MAX_DESC  ( 1023 ) //!< Maximum descriptors in an RX FIFO Queue link list (MAX_DESC is 10-bits)
+#define XCAN_RX_DC_SIZE_MAX          ( 4095 ) //!< Maximum data container size in Continuous Mode in XCAN_RX_DC_SIZE_UNIT (DC_SIZE is 12-bits)
+#define XCAN_ROLLING_COUNTER_Mask    ( 0x1Fu ) //!< Rolling counter (RC) is 5-bits
+#define XCAN_CANXL_PAYLOAD_MIN       ( 1 )    //!< Minimum payload size of a CAN-XL message
+#define XCAN_CANXL_PAYLOAD_MAX       ( 2048 ) //!< Maximum payload size of a CAN-XL message
+#define XCAN_TX_PQ_SLOT_COUNT        ( 32 )   //!< Count of TX Priority Queue slots
+#define XCAN_FUNC_MH_RX_FQ_Pos       ( 8u )   //!< Position of the MH_RX_FQn_IRQ bits in the FUNC_RAW, FUNC_CLR and FUNC_ENA registers
+#define XCAN_RX_HEADER_WORDS         ( 2 )    //!< Count of header words (R0, R1) before the payload of a CAN2.0 or CAN-FD RX message in the data container
+#define XCAN_RX_CANXL_HEADER_WORDS   ( 3 )    //!< Count of header words (R0, R1, R2 = AF) before the payload of a CAN-XL RX message in the data container
+#define XCAN_RX_DC_SIZE_UNIT         ( 32 )   //!< RX_FQ_SIZE.DC_SIZE unit in bytes
+#define XCAN_RX_NORMAL_DC_SIZE_MAX   ( 127 )  //!< Maximum data container size in Normal Mode in XCAN_RX_DC_SIZE_UNIT (only DC_SIZE[6:0] is used)
+#define XCAN_RX_NORMAL_MAX_DESC_PER_MESSAGE  ( 2 ) //!< Maximum count of descriptors of an RX message in Normal Mode, the data container size shall be set accordingly
+#define XCAN_RX_FILTER_MAX_ELEMENTS   ( 255 ) //!< Maximum count of RX filter elements (RX_FILTER_CTRL.NB_FE is 8-bits)
+#define XCAN_RX_FILTER_THRESHOLD_MAX  ( 31 ) //!< Maximum RX filtering threshold in 32-bits words (THRESHOLD is 5-bits)
+#define XCAN_TX_FILTER_ELEMENT_COUNT  ( 16 ) //!< Count of TX filter elements (reference values of TX_FILTER_REFVAL0 to TX_FILTER_REFVAL3)
+#define XCAN_TX_FILTER_REFVAL_COUNT   ( 4 )  //!< Count of TX_FILTER_REFVALn registers
+
+#define XCAN_TX_PAYLOAD_CLASS_COUNT  ( 13 )   //!< Count of size classes of the TX payload pool
+//! Size in bytes of each TX payload pool class: CAN-FD payloads sizes more than 4 bytes, then CAN-XL payloads sizes up to 2048 bytes
+static const uint16_t XCAN_TX_PAYLOAD_CLASS_SIZE[XCAN_TX_PAYLOAD_CLASS_COUNT] = {8, 12, 16, 20, 24, 32, 48, 64, 128, 256, 512, 1024, 2048};
+
+//! Count of completions harvested per batch when a TX FIFO Queue is full and needs descriptors. Can be overridden in Conf_XCAN.h
+#ifndef XCAN_TX_COMPLETION_BATCH_SIZE
+#  define XCAN_TX_COMPLETION_BATCH_SIZE  ( 16 )
+#endif
+
+//! Count trailing zeros of a non-zero 32-bits value (index of the lowest bit set). Can be overridden in Conf_XCAN.h with a CPU specific instruction
+#ifndef XCAN_CTZ32
+#  if defined(__GNUC__) || defined(__clang__)
+#    define XCAN_CTZ32(value)  ( (uint32_t)__builtin_ctz(value) )
+#  else
+     //! De Bruijn sequence index table for the count trailing zeros
+     static const uint8_t XCAN_CTZ32_DEBRUIJN[32] = { 0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8, 31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9, };
+#    define XCAN_CTZ32(value)  ( (uint32_t)XCAN_CTZ32_DEBRUIJN[(((uint32_t)(value) & (0u - (uint32_t)(value))) * 0x077CB531u) >> 27] )
+#  endif
+#endif
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// XCAN Driver API
+//********************************************************************************************************************
+
+typedef struct XCAN XCAN; //! Typedef of XCAN device object structure
+
+//-----------------------------------------------------------------------------
+
+/*! @brief Interface function for register read of the X_CAN
+ *
+ * This function will be called when the driver needs to read a 32-bits register of the X_CAN
+ * @param[in] *pIntDev Is the XCAN.InterfaceDevice of the device that call the interface
+ * @param[in] address Is the register address to read (offset from the X_CAN base address, see #eXCAN_Registers)
+ * @param[out] *data Is where the register value will be stored
+ * @return Returns an #eERRORRESULT value enum
+ */
+typedef eERRORRESULT (*XCAN_ReadRegister_Func)(void *pIntDev, uint16_t address, uint32_t* data);
+
+/*! @brief Interface function for register write of the X_CAN
+ *
+ * This function will be called when the driver needs to write a 32-bits register of the X_CAN
+ * @param[in] *pIntDev Is the XCAN.InterfaceDevice of the device that call the interface
+ * @param[in] address Is the register address to write (offset from the X_CAN base address, see #eXCAN_Registers)
+ * @param[in] data Is the register value to write
+ * @return Returns an #eERRORRESULT value enum
+ */
+typedef eERRORRESULT (*XCAN_WriteRegister_Func)(void *pIntDev, uint16_t address, uint32_t data);
+
+/*! @brief Function that compute the 9-bits CRC of a descriptor
+ *
+ * This function will be called when the driver needs to compute the CRC of a TX or RX descriptor (TIC1.CRC or RIC1.CRC)
+ * The CRC bit field of the first word is already set to 0
+ * @param[in] *data Is the descriptor words to process
+ * @param[in] count Is the count of words to process (8 for TX descriptors, 4 for RX descriptors)
+ * @return The computed 9-bits CRC
+ */
+typedef uint16_t (*ComputeCRC9_Func)(const uint32_t* data, size_t count);
+
+/*! @brief Function that gives the current millisecond of the system to the driver
+ *
+ * This function will be called when the driver needs to get the current millisecond
+ * @return Returns the current millisecond of the system
+ */
+typedef uint32_t (*GetCurrentms_Func)(void);
+
+//-----------------------------------------------------------------------------
+
+
+
+//! TX/RX FIFO Queue number enumerator
+typedef enum
+{
+  XCAN_FIFO_QUEUE_0 = 0, //!< FIFO Queue 0
+  XCAN_FIFO_QUEUE_1 = 1, //!< FIFO Queue 1
+  XCAN_FIFO_QUEUE_2 = 2, //!< FIFO Queue 2
+  XCAN_FIFO_QUEUE_3 = 3, //!< FIFO Queue 3
+  XCAN_FIFO_QUEUE_4 = 4, //!< FIFO Queue 4
+  XCAN_FIFO_QUEUE_5 = 5, //!< FIFO Queue 5
+  XCAN_FIFO_QUEUE_6 = 6, //!< FIFO Queue 6
+  XCAN_FIFO_QUEUE_7 = 7, //!< FIFO Queue 7
+  XCAN_FIFO_QUEUE_COUNT, // Keep last
+} eXCAN_FIFOQueue;
+
+#define XCAN_FIFO_QUEUE_MASK(queue)  ( 1u << (uint32_t)(queue) ) //!< Get the FIFO Queue bit in a FIFO Queue register
+#define XCAN_FIFO_QUEUE_MASK_ALL     ( 0xFFu )                  //!< All the FIFO Queues bits in a FIFO Queue register
+
+//-----------------------------------------------------------------------------
+
+
+
+//! Driver configuration enum
+typedef enum
+{
+  XCAN_DRIVER_NORMAL_USE  = 0x00, //!< Use the driver with no special verifications, just settings verifications (usually the fastest mode)
+  XCAN_DRIVER_TX_DESC_CRC = 0x01, //!< Compute the CRC of all TX descriptors. MH_SFTY_CTRL.TX_DESC_CRC_EN shall be set and XCAN.fnComputeCRC9 shall be set
+  XCAN_DRIVER_RX_DESC_CRC = 0x02, //!< Compute the CRC of all RX descriptors. MH_SFTY_CTRL.RX_DESC_CRC_EN shall be set and XCAN.fnComputeCRC9 shall be set
+} eXCAN_DriverConfig;
+
+typedef eXCAN_DriverConfig setXCAN_DriverConfig; //! Set of Driver configuration (can be OR'ed)
+
+//-----------------------------------------------------------------------------
+
+
+
+//! Message control flags enum
+typedef enum
+{
+  XCAN_NO_MESSAGE_CTRL_FLAGS       = 0x00, //!< No Message Control Flags (CAN2.0 frame with standard ID)
+  XCAN_CANFD_FRAME                 = 0x01, //!< Indicate that the frame is a CAN-FD frame
+  XCAN_CANXL_FRAME                 = 0x02, //!< Indicate that the frame is a CAN-XL frame
+  XCAN_EXTENDED_MESSAGE_ID         = 0x04, //!< Indicate that the message ID is extended (29-bits). Not available with CAN-XL
+  XCAN_REMOTE_TRANSMISSION_REQUEST = 0x08, //!< Indicate that the frame is a remote frame. Only available with CAN2.0
+  XCAN_SWITCH_BITRATE              = 0x10, //!< Indicate that the data bitrate will be switched. Only available with CAN-FD
+  XCAN_TRANSMIT_ERROR_PASSIVE      = 0x20, //!< Indicate that the Error State Indicator is recessive. Only available with CAN-FD
+  XCAN_SIMPLE_EXTENDED_CONTENT     = 0x40, //!< Indicate the Simple Extended Content. Only available with CAN-XL
+  XCAN_REMOTE_REQUEST_SUBSTITUTION = 0x80, //!< Indicate the Remote Request Substitution. Only available with CAN-XL
+  XCAN_PAYLOAD_FROM_POOL           = 0x100, //!< Indicate that the payload data was allocated with XCAN_AllocTxPayload(), it will be freed when the message completion is harvested (TX FIFO Queue) or its slot reclaimed (TX Priority Queue). Not accepted by XCAN_BuildTxDescriptor()
+} eXCAN_MessageCtrlFlags;
+
+typedef eXCAN_MessageCtrlFlags setXCAN_MessageCtrlFlags; //! Set of Message control flags (can be OR'ed)
+
+//! Transmit and receive message structure
+typedef struct XCAN_CANMessage
+{
+  uint32_t MessageID;                    //!< Contain the message ID: 11-bits standard or 29-bits extended ID for CAN2.0 and CAN-FD, 11-bits priority ID for CAN-XL
+  setXCAN_MessageCtrlFlags ControlFlags; //!< Contain the CAN controls flags
+  eXCAN_DataLength DLC;                  //!< CAN2.0 and CAN-FD: Indicate how many bytes in the payload data will be sent
+  uint16_t PayloadSize;                  //!< CAN-XL: Indicate how many bytes in the payload data will be sent (1 to 2048)
+  uint8_t SDT;                           //!< CAN-XL: SDU Type
+  uint8_t VCID;                          //!< CAN-XL: Virtual CAN Network ID
+  uint32_t AF;                           //!< CAN-XL: Acceptance Field
+  uint8_t* PayloadData;                  /*!< Pointer to the payload data that will be sent. PayloadData array should be at least the same size as indicate by the DLC or PayloadSize.
+                                          *   For CAN-FD with more than 4 bytes and CAN-XL, the payload is fetched by the MH: it must be 32-bits aligned in S_MEM and stay untouched until the message is sent
+                                          */
+} XCAN_CANMessage;
+
+//-----------------------------------------------------------------------------
+
+
+
+//! TX FIFO Queue configuration structure
+typedef struct XCAN_TxFIFOQueueConfig
+{
+  eXCAN_FIFOQueue Queue;           //!< TX FIFO Queue to configure
+  XCAN_CAN_TxMessage* Descriptors; //!< Descriptors link list of the TX FIFO Queue in S_MEM. Must be 32-bits aligned and of MaxDesc elements
+  uint16_t MaxDesc;                //!< Count of descriptors in the link list (1 to 1023)
+  uint8_t** PayloadBuffers;        //!< Payload buffer of each descriptor, MaxDesc elements. Needed to send messages with XCAN_PAYLOAD_FROM_POOL, else can be NULL
+} XCAN_TxFIFOQueueConfig;
+
+//! TX FIFO Queue ring state (Managed by the driver)
+typedef struct XCAN_TxFIFOQueueRing
+{
+  XCAN_CAN_TxMessage* Desc; //!< Descriptors link list of the TX FIFO Queue. NULL if the TX FIFO Queue is not configured
+  uint16_t MaxDesc;         //!< Count of descriptors in the link list
+  uint16_t Head;            //!< Index of the next free descriptor in the link list
+  uint16_t Tail;            //!< Index of the oldest published descriptor not yet harvested
+  uint16_t InFlight;        //!< Count of descriptors published and not yet harvested
+  uint8_t RollingCounter;   //!< Rolling counter (RC) of the next descriptor to publish
+  uint8_t HarvestRollingCounter; //!< Rolling counter (RC) expected for the next descriptor to harvest
+  uint8_t** Payloads;       //!< Payload buffer from the TX payload pool of each descriptor (NULL if none). NULL if not used
+} XCAN_TxFIFOQueueRing;
+
+//! TX completion structure, decoded from the acknowledge data written back by the MH
+typedef struct XCAN_TxCompletion
+{
+  uint64_t Timestamp;    //!< Timestamp of the message sent (TS1:TS0)
+  uint16_t Index;        //!< Index of the descriptor in the link list of the TX FIFO Queue
+  eXCAN_TxStatus Status; //!< TX message status
+} XCAN_TxCompletion;
+
+/*! @brief Function that is called with a batch of TX completions
+ *
+ * This function will be called once per harvest of a TX FIFO Queue with all descriptors acknowledged by the MH since the last harvest
+ * @param[in] *pComp Is the pointed structure of the device that harvested the completions
+ * @param[in] queue Is the TX FIFO Queue of the completions
+ * @param[in] *pCompletions Is the array of completions in the sent order
+ * @param[in] count Is the count of completions in the array
+ */
+typedef void (*XCAN_TxCompleteBatch_Func)(XCAN *pComp, eXCAN_FIFOQueue queue, const XCAN_TxCompletion* pCompletions, size_t count);
+
+/*! @brief Function that is called when a rolling counter gap or reorder is detected
+ *
+ * This function will be called as soon as the rolling counter (RC) of a harvested TX descriptor or of a received RX descriptor is not the one expected.
+ * The driver resynchronizes on the received RC after the call
+ * @param[in] *pComp Is the pointed structure of the device that detected the error
+ * @param[in] isRx Is 'true' for an RX FIFO Queue, 'false' for a TX FIFO Queue
+ * @param[in] queue Is the FIFO Queue of the descriptor
+ * @param[in] expected Is the expected rolling counter
+ * @param[in] received Is the rolling counter of the descriptor
+ */
+typedef void (*XCAN_RollingCounterError_Func)(XCAN *pComp, bool isRx, eXCAN_FIFOQueue queue, uint8_t expected, uint8_t received);
+
+/*! @brief Function that is called when the data container of an RX FIFO Queue in Continuous Mode reaches its high watermark
+ *
+ * This function will be called once each time the bytes of the RX messages read and not yet released reach the high watermark, before the MH stops the RX FIFO Queue (DC_FULL).
+ * The application can shed load (release messages faster, drop low priority messages). The function will be called again once the fill goes down to the low watermark then up to the high watermark
+ * @param[in] *pComp Is the pointed structure of the device that detected the watermark
+ * @param[in] queue Is the RX FIFO Queue
+ * @param[in] fillBytes Is the bytes of the data container used by the RX messages read and not yet released
+ */
+typedef void (*XCAN_RxHighWatermark_Func)(XCAN *pComp, eXCAN_FIFOQueue queue, uint32_t fillBytes);
+
+//! TX payload pool configuration structure
+typedef struct XCAN_TxPayloadPoolConfig
+{
+  uint8_t* Memory;                                      //!< Memory of the pool in S_MEM. Must be aligned on a uintptr_t
+  size_t MemorySize;                                    //!< Size of the memory of the pool in bytes
+  uint16_t BufferCount[XCAN_TX_PAYLOAD_CLASS_COUNT];    //!< Count of buffers of each class (see XCAN_TX_PAYLOAD_CLASS_SIZE)
+} XCAN_TxPayloadPoolConfig;
+
+//! TX payload pool state (Managed by the driver). Each buffer is preceded by a header word: its class when allocated, the next free buffer header when free
+typedef struct XCAN_TxPayloadPool
+{
+  uintptr_t* FreeList[XCAN_TX_PAYLOAD_CLASS_COUNT];     //!< First free buffer header of each class. NULL if the class is empty
+  uint16_t FreeCount[XCAN_TX_PAYLOAD_CLASS_COUNT];      //!< Count of free buffers of each class
+} XCAN_TxPayloadPool;
+
+//-----------------------------------------------------------------------------
+
+
+
+//! TX Priority Queue slots state (Managed by the driver)
+typedef struct XCAN_TxPriorityQueueSlots
+{
+  XCAN_CAN_TxMessage* Desc;    //!< Descriptors of the TX Priority Queue, the descriptor of the slot n is Desc[n]. NULL if the TX Priority Queue is not configured
+  uint32_t EnabledMask;        //!< Slots enabled in the TX_PQ_CTRL2 register
+  uint32_t FreeMask;           //!< Slots owned by the SW and ready to be allocated
+  uint32_t PendingMask;        //!< Slots started and not yet reclaimed
+  uint32_t PinnedMask;         //!< Slots pinned to a periodic message, they are never allocated
+  uint32_t IrqWhenSentMask;    //!< Pinned slots that trigger an interrupt when the message has been sent
+  uint8_t RollingCounter[XCAN_TX_PQ_SLOT_COUNT]; //!< Rolling counter (RC) of the next descriptor of each slot
+  uint8_t* Payloads[XCAN_TX_PQ_SLOT_COUNT];      //!< Payload buffer from the TX payload pool of each slot (NULL if none), freed when the slot is reclaimed (or unpinned)
+} XCAN_TxPriorityQueueSlots;
+
+//-----------------------------------------------------------------------------
+
+
+
+//! Unsent TX descriptor structure, copied out after an abort
+typedef struct XCAN_TxUnsentDescriptor
+{
+  XCAN_CAN_TxMessage Desc; //!< Copy of the descriptor as it was published (T0, T1, TD0/T2, TD1/TX_AP, TIC2.SIZE and TIC2.PLSRC are kept when requeued)
+  uint8_t* PayloadBuffer;  //!< Payload buffer from the TX payload pool attached to the descriptor, NULL if none
+  bool FromPriorityQueue;  //!< 'true' if the descriptor was in a TX Priority Queue slot, 'false' if in a TX FIFO Queue
+  uint8_t Queue;           //!< TX FIFO Queue (#eXCAN_FIFOQueue) or TX Priority Queue slot of the descriptor
+} XCAN_TxUnsentDescriptor;
+
+/*! @brief Function that decides if an unsent TX descriptor is requeued
+ *
+ * @param[in] *pContext Is the context given to XCAN_RequeueTxDescriptors()
+ * @param[in] *pUnsent Is the unsent descriptor
+ * @return Returns 'true' to requeue the descriptor, 'false' to drop it (deadline missed for example)
+ */
+typedef bool (*XCAN_TxRequeueFilter_Func)(void* pContext, const XCAN_TxUnsentDescriptor* pUnsent);
+
+//-----------------------------------------------------------------------------
+
+
+
+//! RX FIFO Queue in Continuous Mode configuration structure
+typedef struct XCAN_RxContinuousQueueConfig
+{
+  eXCAN_FIFOQueue Queue;           //!< RX FIFO Queue to configure
+  XCAN_CAN_RxMessage* Descriptors; //!< Descriptors link list of the RX FIFO Queue in S_MEM. Must be 32-bits aligned and of MaxDesc elements
+  uint16_t MaxDesc;                //!< Count of descriptors in the link list (1 to 1023), one descriptor per RX message
+  uint8_t* DataContainer;          //!< Single data container where the MH writes all RX messages linearly. Must be 32-bits aligned and of DCSize * XCAN_RX_DC_SIZE_UNIT bytes
+  uint16_t DCSize;                 //!< Size of the data container in XCAN_RX_DC_SIZE_UNIT bytes (1 to 4095)
+  bool IrqWhenReceived;            //!< Set to 'true' to trigger an interrupt when each RX message has been received
+} XCAN_RxContinuousQueueConfig;
+
+//! RX data container full recovery policy enum
+typedef enum
+{
+  XCAN_RX_OVERFLOW_KEEP_UNREAD = 0, //!< Keep the RX messages not yet read, only the space released by the application is given back to the MH
+  XCAN_RX_OVERFLOW_DROP_UNREAD = 1, //!< Drop the RX messages not yet read if the application does not hold any message of the RX FIFO Queue, to restart with an empty data container
+} eXCAN_RxOverflowPolicy;
+
+//! RX buffer pool state (Managed by the driver). Each free buffer keeps the next free buffer in its first word
+typedef struct XCAN_RxBufferPool
+{
+  uintptr_t* FreeList;      //!< First free buffer. NULL if the pool is empty
+  uint16_t FreeCount;       //!< Count of free buffers
+  uint32_t BufferSize;      //!< Size of each buffer in bytes
+} XCAN_RxBufferPool;
+
+//! RX FIFO Queue in Normal Mode configuration structure
+typedef struct XCAN_RxNormalQueueConfig
+{
+  eXCAN_FIFOQueue Queue;           //!< RX FIFO Queue to configure
+  XCAN_CAN_RxMessage* Descriptors; //!< Descriptors link list of the RX FIFO Queue in S_MEM. Must be 32-bits aligned and of MaxDesc elements
+  uint16_t MaxDesc;                //!< Count of descriptors in the link list (1 to 1023)
+  uint8_t** DescBuffers;           //!< Buffer posted on each descriptor, MaxDesc elements
+  XCAN_RxBufferPool* BufferPool;   //!< Pool where the buffers are taken, its buffers shall be of at least DCSize * XCAN_RX_DC_SIZE_UNIT bytes
+  uint8_t DCSize;                  //!< Size of the data container of each descriptor in XCAN_RX_DC_SIZE_UNIT bytes (1 to 127)
+  bool IrqWhenReceived;            //!< Set to 'true' to trigger an interrupt when each RX message has been received
+  uint16_t MaxPayloadSize;         //!< Largest payload in bytes of the RX messages (64 for CAN-FD only, up to 2048 for CAN-XL). 0 for XCAN_CANXL_PAYLOAD_MAX. MaxDesc data containers shall hold such a message
+} XCAN_RxNormalQueueConfig;
+
+//! RX FIFO Queue ring state (Managed by the driver)
+typedef struct XCAN_RxFIFOQueueRing
+{
+  XCAN_CAN_RxMessage* Desc; //!< Descriptors link list of the RX FIFO Queue. NULL if the RX FIFO Queue is not configured
+  uint16_t MaxDesc;         //!< Count of descriptors in the link list
+  uint16_t Head;            //!< Index of the next descriptor to read
+  uint16_t Tail;            //!< Index of the oldest descriptor read and not yet given back to the MH
+  uint16_t Pending;         //!< Count of descriptors read and not yet given back to the MH
+  uint32_t DescCtrl;        //!< RIC1 of the descriptors without the RC and the CRC (IN, FQN, IRQ)
+  uint8_t* DataContainer;   //!< Data container of the RX FIFO Queue in Continuous Mode. NULL in Normal Mode
+  uint32_t DCAddress;       //!< Address of the data container as seen by the MH (Continuous Mode)
+  uint32_t DCSizeBytes;     //!< Size of the data container in bytes (of each descriptor in Normal Mode)
+  uint8_t** Buffers;        //!< Buffer posted on each descriptor, NULL if taken by the application and not yet replaced (Normal Mode). NULL in Continuous Mode
+  XCAN_RxBufferPool* BufferPool; //!< Pool of the buffers posted (Normal Mode)
+  uint32_t Dropped;         //!< Count of RX messages dropped because they use more than XCAN_RX_NORMAL_MAX_DESC_PER_MESSAGE descriptors or more than the link list (Normal Mode) or by XCAN_RecoverRxDataContainerFull() (Continuous Mode)
+  uint16_t SkipDesc;        //!< Count of descriptors still to skip of a dropped RX message larger than the link list (Normal Mode)
+  uint32_t ReadEnd;         //!< Offset in the data container after the last RX message read (Continuous Mode)
+  uint32_t ReleaseEnd;      //!< Offset in the data container after the last RX message released (Continuous Mode)
+  uint32_t HighWatermark;   //!< Data container fill in bytes that calls XCAN.fnRxHighWatermark. 0 if not used (Continuous Mode)
+  uint32_t LowWatermark;    //!< Data container fill in bytes at or under which XCAN.fnRxHighWatermark can be called again (Continuous Mode)
+  bool AboveWatermark;      //!< The high watermark has been reached and the fill is not yet under the low watermark (Continuous Mode)
+  uint32_t Overflows;       //!< Count of RX FIFO Queue stops due to the data container full (DC_FULL) recovered, counted once when the RX FIFO Queue is restarted (Continuous Mode)
+} XCAN_RxFIFOQueueRing;
+
+//! RX message view structure, the payload stays in the data container until the message is released
+typedef struct XCAN_RxMessageView
+{
+  uint32_t MessageID;                    //!< Message ID: 11-bits standard or 29-bits extended ID for CAN2.0 and CAN-FD, 11-bits priority ID for CAN-XL
+  setXCAN_MessageCtrlFlags ControlFlags; //!< CAN controls flags
+  eXCAN_DataLength DLC;                  //!< CAN2.0 and CAN-FD: Data Length Code
+  uint16_t PayloadSize;                  //!< Payload size in bytes (0 for a remote frame)
+  uint8_t SDT;                           //!< CAN-XL: SDU Type
+  uint8_t VCID;                          //!< CAN-XL: Virtual CAN Network ID
+  uint32_t AF;                           //!< CAN-XL: Acceptance Field
+  uint32_t R1;                           //!< Raw R1 header word (FIDX, FM, BLK, FAB)
+  eXCAN_RxStatus Status;                 //!< RX message status
+  uint64_t Timestamp;                    //!< Timestamp of the message received (TS1:TS0)
+  uint16_t Index;                        //!< Index of the descriptor in the link list of the RX FIFO Queue
+  const uint8_t* Payload[2];             //!< Payload parts in the data container. The second part is only used when the payload wraps at the end of the data container (Continuous Mode) or continues in the next descriptor buffer (Normal Mode), else NULL
+  uint16_t PayloadPartSize[2];           //!< Size in bytes of each payload part
+} XCAN_RxMessageView;
+
+//! RX message received in Normal Mode, the buffers are given to the application
+typedef struct XCAN_RxNormalMessage
+{
+  XCAN_RxMessageView View;                                //!< Decoded message. The payload parts point in Buffer[0] and Buffer[1]
+  uint8_t* Buffer[XCAN_RX_NORMAL_MAX_DESC_PER_MESSAGE];   //!< Buffers of the message (NULL if not used), they shall be freed with XCAN_FreeRxBuffer() once the message is processed
+} XCAN_RxNormalMessage;
+
+//! Payload segment of an RX message in Normal Mode, one per descriptor used by the message
+typedef struct XCAN_RxSegment
+{
+  uint8_t* Buffer;     //!< Descriptor buffer holding the segment, given to the application until the message is released
+  const uint8_t* Data; //!< Payload data of the segment in the buffer
+  uint16_t Size;       //!< Size in bytes of the payload data of the segment
+} XCAN_RxSegment;
+
+//! RX message received in Normal Mode as a list of segments, whatever its count of descriptors
+typedef struct XCAN_RxSegmentedMessage
+{
+  XCAN_RxMessageView View;  //!< Decoded message. The payload parts are the 2 first segments
+  XCAN_RxSegment* Segments; //!< Payload segments of the message in the descriptors buffers, in order
+  uint16_t SegmentCount;    //!< Count of segments, that is the count of descriptors used by the message
+} XCAN_RxSegmentedMessage;
+
+//! RX frame polled across the RX FIFO Queues
+typedef struct XCAN_RxFrame
+{
+  eXCAN_FIFOQueue Queue;        //!< RX FIFO Queue of the frame
+  XCAN_RxNormalMessage Message; //!< Received message. In Continuous Mode, the buffers are NULL and the frame shall be released with XCAN_ReleaseRxPolledFrames()
+} XCAN_RxFrame;
+
+//! Adaptive interrupt/poll RX configuration structure
+typedef struct XCAN_RxAdaptiveConfig
+{
+  uint16_t DryThreshold;   //!< A poll that returns this count of frames or less is a dry poll (0 = only the empty polls are dry)
+  uint8_t DryPollsToIrq;   //!< Count of consecutive dry polls before going back to interrupt mode (1 or more). More polls avoid an interrupt storm when the load goes up and down
+} XCAN_RxAdaptiveConfig;
+
+//! Adaptive interrupt/poll RX state (Managed by the driver, do not change)
+typedef struct XCAN_RxAdaptiveState
+{
+  bool Enabled;            //!< The adaptive interrupt/poll RX has been configured
+  bool Polling;            //!< 'true' in poll mode (RX FIFO Queues interrupts masked), 'false' in interrupt mode
+  uint16_t DryThreshold;   //!< A poll that returns this count of frames or less is a dry poll
+  uint8_t DryPollsToIrq;   //!< Count of consecutive dry polls before going back to interrupt mode
+  uint8_t DryPolls;        //!< Current count of consecutive dry polls
+  uint8_t IrqQueues;       //!< RX FIFO Queues which interrupt is enabled in interrupt mode
+  uint32_t IrqCount;       //!< Count of interrupts that switched to poll mode
+  uint32_t PollCount;      //!< Count of polls done in poll mode
+} XCAN_RxAdaptiveState;
+
+//! RX filters configuration structure
+typedef struct XCAN_RxFilterConfig
+{
+  uint16_t ElementsAddress;     //!< Address in L_MEM of the RX filter elements table (32-bits aligned). The table shall be written in L_MEM before starting the MH
+  uint8_t ElementCount;         //!< Count of RX filter elements of the table (0 to XCAN_RX_FILTER_MAX_ELEMENTS). 0 accepts all messages in DefaultQueue
+  bool AcceptNonMatching;       //!< Set to 'true' to store the messages that match no filter element in DefaultQueue, else they are rejected
+  eXCAN_FIFOQueue DefaultQueue; //!< RX FIFO Queue of the non matching messages, it shall be enabled and started if used
+} XCAN_RxFilterConfig;
+
+//! TX filter configuration structure, the values of the TX filter registers. XCAN_BuildTxFilter() of XCAN_TxFilterBuilder.h can build them
+typedef struct XCAN_TxFilterConfig
+{
+  uint32_t Ctrl0;                                //!< TX_FILTER_CTRL0 value: COMB, MASK, MODE, CAN_FD, CC_CAN, EN and IRQ_EN
+  uint32_t Ctrl1;                                //!< TX_FILTER_CTRL1 value: VALID and FIELD
+  uint32_t RefVal[XCAN_TX_FILTER_REFVAL_COUNT];  //!< TX_FILTER_REFVAL0 to TX_FILTER_REFVAL3 values
+} XCAN_TxFilterConfig;
+
+//! TX filter rejection information structure
+typedef struct XCAN_TxFilterRejection
+{
+  bool FIFOQueue; //!< 'true' if the message rejected was in a TX FIFO Queue, 'false' if it was in a TX Priority Queue slot
+  uint8_t Number; //!< TX FIFO Queue number (see #eXCAN_FIFOQueue) or TX Priority Queue slot number of the message rejected
+} XCAN_TxFilterRejection;
+
+
+
+//! XCAN device object structure
+struct XCAN
+{
+  void *UserDriverData;                    //!< Optional, can be used to store driver data or NULL
+
+  //--- Driver configuration ---
+  setXCAN_DriverConfig DriverConfig;       //!< Driver configuration, by default it is XCAN_DRIVER_NORMAL_USE. Configuration can be OR'ed
+  uint8_t InstanceNumber;                  //!< Instance number of the X_CAN, must be the same value as MH_CFG.INST_NUM (0 to 7)
+
+  //--- Interface driver call functions ---
+  void *InterfaceDevice;                   //!< This is the pointer that will be in the first parameter of all interface call functions
+  XCAN_ReadRegister_Func fnReadRegister;   //!< This function will be called when the driver needs to read a register of the X_CAN
+  XCAN_WriteRegister_Func fnWriteRegister; //!< This function will be called when the driver needs to write a register of the X_CAN
+
+  //--- Events call functions ---
+  XCAN_TxCompleteBatch_Func fnTxCompleteBatch; //!< This function will be called with each batch of TX completions harvested. Can be NULL
+  XCAN_RollingCounterError_Func fnRollingCounterError; //!< This function will be called when a rolling counter gap or reorder is detected on a TX or RX FIFO Queue. Can be NULL
+  XCAN_RxHighWatermark_Func fnRxHighWatermark; //!< This function will be called when the data container of an RX FIFO Queue in Continuous Mode reaches its high watermark (set with XCAN_SetRxWatermarks()). Can be NULL
+
+  //--- Time call function ---
+  GetCurrentms_Func fnGetCurrentms;        //!< This function will be called when the driver needs to get the current millisecond (timeouts). Can be NULL if no timeout is used
+
+  //--- CRC9 call function ---
+  ComputeCRC9_Func fnComputeCRC9;          //!< This function will be called when a descriptor CRC is needed (XCAN_ComputeDescCRC9() of XCAN_DescCRC.h can be used). Can be NULL if XCAN_DRIVER_TX_DESC_CRC and XCAN_DRIVER_RX_DESC_CRC are not used
+
+  //--- TX FIFO Queues ---
+  XCAN_TxFIFOQueueRing TxFIFO[XCAN_TX_FIFO_QUEUE_COUNT]; //!< TX FIFO Queues ring states (Managed by the driver, do not change)
+
+  //--- RX FIFO Queues ---
+  uint8_t RxRollingCounter[XCAN_RX_FIFO_QUEUE_COUNT]; //!< Rolling counter (RC) expected for the next RX header descriptor of each RX FIFO Queue (Managed by the driver, do not change)
+  uint8_t RxRollingCounterSynced;          //!< RX FIFO Queues which RxRollingCounter is synchronized, the first RX descriptor received synchronizes it (Managed by the driver, do not change)
+  XCAN_RxFIFOQueueRing RxFIFO[XCAN_RX_FIFO_QUEUE_COUNT]; //!< RX FIFO Queues ring states (Managed by the driver, do not change)
+  uint32_t RxPollOrder;                    //!< Drain order of the RX FIFO Queues by XCAN_PollRxFIFOQueues(), 4 bits per queue from the first drained (bits 0-3). 0 = by queue number (set with XCAN_SetRxPollOrder())
+  uint8_t RxPollCarry;                     //!< RX FIFO Queues not fully drained by the last poll (Managed by the driver, do not change)
+  XCAN_RxAdaptiveState RxAdaptive;         //!< Adaptive interrupt/poll RX state (Managed by the driver, do not change)
+  uint16_t RxUnsuccessfulLast;             //!< Last RX_STATISTICS.UNSUCC value read (Managed by the driver, do not change)
+  uint32_t RxUnsuccessful;                 //!< Count of unsuccessful receptions (RX_STATISTICS.UNSUCC) accumulated at each XCAN_RecoverRxDataContainerFull() call, including the messages that the MH could not store while the RX FIFO Queues were stopped
+
+  //--- Interrupts ---
+  uint32_t FuncEnable;                     //!< Shadow of the FUNC_ENA register, the interrupts are masked and unmasked without reading it (Managed by the driver, do not change)
+
+  //--- TX payload pool ---
+  XCAN_TxPayloadPool* TxPayloadPool;       //!< TX payload pool used for the messages with XCAN_PAYLOAD_FROM_POOL. Can be NULL if not used
+
+  //--- TX Priority Queue ---
+  XCAN_TxPriorityQueueSlots TxPQ;          //!< TX Priority Queue slots state (Managed by the driver, do not change)
+};
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// XCAN Registers access
+//********************************************************************************************************************
+
+/*! @brief Read a register of the X_CAN
+ *
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] reg Is the register to read
+ * @param[out] *data Is where the register value will be stored
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_ReadREG32(XCAN *pComp, eXCAN_Registers reg, uint32_t* data);
+
+/*! @brief Write a register of the X_CAN
+ *
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] reg Is the register to write
+ * @param[in] data Is the register value to write
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_WriteREG32(XCAN *pComp, eXCAN_Registers reg, uint32_t data);
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// XCAN TX FIFO Queues
+//********************************************************************************************************************
+
+/*! @brief Configure a TX FIFO Queue of the X_CAN device
+ *
+ * Clear all descriptors of the link list, set the TX FIFO Queue start address and size, and enable the TX FIFO Queue
+ * The TX FIFO Queue is not started, it will be started with the first descriptor published
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] *pConf Is the TX FIFO Queue configuration
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_ConfigureTxFIFOQueue(XCAN *pComp, const XCAN_TxFIFOQueueConfig* pConf);
+
+/*! @brief Get the next free descriptor of a TX FIFO Queue
+ *
+ * If all descriptors are in flight, the TX FIFO Queue is harvested first (see XCAN_HarvestTxFIFOQueue()).
+ * The caller builds the TX message directly in the descriptor returned (T0, T1, TD0/T2, TD1/TX_AP, TIC2.SIZE and TIC2.PLSRC).
+ * TIC1, TIC2.IN and TIC2.TDO are set by the driver when the descriptor is published
+ * As long as the descriptor is not published, calling this function again returns the same descriptor
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] queue Is the TX FIFO Queue to use
+ * @param[out] **pDesc Is where the pointer to the free descriptor will be stored
+ * @return Returns an #eERRORRESULT value enum, ERR__BUFFER_FULL if no descriptor is free
+ */
+eERRORRESULT XCAN_GetNextTxFIFODescriptor(XCAN *pComp, eXCAN_FIFOQueue queue, XCAN_CAN_TxMessage** pDesc);
+
+/*! @brief Publish the descriptor got with XCAN_GetNextTxFIFODescriptor() to the MH
+ *
+ * Set the TIC1 (rolling counter, queue number, wrap, CRC) and hand over the descriptor to the MH by setting the VALID bit.
+ * The TX FIFO Queue is not started, use XCAN_StartTxFIFOQueueIfStalled() after one or more descriptors were published
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] queue Is the TX FIFO Queue to use
+ * @param[in] irqWhenSent Set to 'true' to trigger an interrupt when the message has been sent
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_PublishTxFIFODescriptor(XCAN *pComp, eXCAN_FIFOQueue queue, bool irqWhenSent);
+
+/*! @brief Start a TX FIFO Queue only if it is stalled
+ *
+ * Read the TX_FQ_STS0 register and write the TX_FQ_CTRL0.START bit only if the TX FIFO Queue is not busy or on hold (STOP).
+ * A running TX FIFO Queue will fetch the new valid descriptors by itself
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] queue Is the TX FIFO Queue to start
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_StartTxFIFOQueueIfStalled(XCAN *pComp, eXCAN_FIFOQueue queue);
+
+/*! @brief Publish the descriptor got with XCAN_GetNextTxFIFODescriptor() and start the TX FIFO Queue if it is stalled
+ *
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] queue Is the TX FIFO Queue to use
+ * @param[in] irqWhenSent Set to 'true' to trigger an interrupt when the message has been sent
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_SendTxFIFODescriptor(XCAN *pComp, eXCAN_FIFOQueue queue, bool irqWhenSent);
+
+
+/*! @brief Initialize a TX payload pool
+ *
+ * Split the memory of the pool in buffers of each class, preceded by a header word each
+ * @param[out] *pPool Is the pool to initialize
+ * @param[in] *pConf Is the pool configuration
+ * @return Returns an #eERRORRESULT value enum, ERR__OUT_OF_MEMORY if the memory is too small for all buffers
+ */
+eERRORRESULT XCAN_InitTxPayloadPool(XCAN_TxPayloadPool* pPool, const XCAN_TxPayloadPoolConfig* pConf);
+
+/*! @brief Allocate a TX payload buffer from a pool
+ *
+ * The buffer is taken from the smallest class that fits the size and has a free buffer. The buffer is 32-bits aligned
+ * The pool is not protected against concurrent accesses, allocations and frees shall be done from the same context or protected by the caller
+ * @param[in] *pPool Is the pool to use
+ * @param[in] size Is the payload size in bytes (1 to 2048)
+ * @param[out] **pBuffer Is where the buffer allocated will be stored
+ * @return Returns an #eERRORRESULT value enum, ERR__OUT_OF_MEMORY if no buffer is free
+ */
+eERRORRESULT XCAN_AllocTxPayload(XCAN_TxPayloadPool* pPool, size_t size, uint8_t** pBuffer);
+
+/*! @brief Free a TX payload buffer to its pool
+ *
+ * @param[in] *pPool Is the pool of the buffer
+ * @param[in] *pBuffer Is the buffer allocated with XCAN_AllocTxPayload()
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_FreeTxPayload(XCAN_TxPayloadPool* pPool, uint8_t* pBuffer);
+
+
+/*! @brief Build a TX descriptor from a message
+ *
+ * Fill the T0, T1, TD0/T2, TD1/TX_AP, TIC2.SIZE and TIC2.PLSRC of the descriptor. TIC1 and the other TIC2 fields are set when the descriptor is published
+ * The descriptor is not tracked by the driver, so a message with XCAN_PAYLOAD_FROM_POOL is refused: use XCAN_TransmitMessagesToTxFIFOQueue() or XCAN_TransmitMessageToTxPQ() for them
+ * @param[in] *pMessage Is the message to build
+ * @param[out] *pDesc Is the descriptor to fill, usually got with XCAN_GetNextTxFIFODescriptor()
+ * @return Returns an #eERRORRESULT value enum, ERR__PARAMETER_ERROR if the message has the XCAN_PAYLOAD_FROM_POOL flag
+ */
+eERRORRESULT XCAN_BuildTxDescriptor(const XCAN_CANMessage* pMessage, XCAN_CAN_TxMessage* pDesc);
+
+/*! @brief Transmit a burst of messages through a TX FIFO Queue
+ *
+ * Build and publish as many messages as possible in the free descriptors of the TX FIFO Queue, then write the TX_FQ_CTRL0.START bit once for the whole burst
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] queue Is the TX FIFO Queue to use
+ * @param[in] *pMessages Is the array of messages to transmit
+ * @param[in] count Is the count of messages in the array
+ * @param[out] *pSentCount Is where the count of messages published will be stored. Can be NULL
+ * @param[in] irqWhenSent Set to 'true' to trigger an interrupt when each message has been sent
+ * @return Returns an #eERRORRESULT value enum, ERR__BUFFER_FULL if not all messages were published
+ */
+eERRORRESULT XCAN_TransmitMessagesToTxFIFOQueue(XCAN *pComp, eXCAN_FIFOQueue queue, const XCAN_CANMessage* pMessages, size_t count, size_t* pSentCount, bool irqWhenSent);
+
+/*! @brief Harvest the TX completions of a TX FIFO Queue
+ *
+ * Walk the link list from the oldest descriptor not yet harvested to the first descriptor still valid for the MH in one pass, decode the status and timestamp
+ *   of each acknowledged descriptor in the completions array and free the descriptors and their payload buffers from the pool. XCAN.fnTxCompleteBatch is called once with the whole batch
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] queue Is the TX FIFO Queue to harvest
+ * @param[out] *pCompletions Is the array where the completions will be stored
+ * @param[in] maxCount Is the maximum count of completions in the array
+ * @param[out] *pHarvestedCount Is where the count of completions harvested will be stored. Can be NULL
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_HarvestTxFIFOQueue(XCAN *pComp, eXCAN_FIFOQueue queue, XCAN_TxCompletion* pCompletions, size_t maxCount, size_t* pHarvestedCount);
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// XCAN TX abort
+//********************************************************************************************************************
+
+/*! @brief Abort a set of TX FIFO Queues and TX Priority Queue slots together
+ *
+ * Perform one unlock sequence per ABORT register (TX_FQ_CTRL1 and TX_PQ_CTRL1) for all the queues and slots, wait all of them inactive (BUSY = 0) in the same
+ *   polling loop, then unlock and set back ABORT to 0. The completions of the messages sent before the abort are harvested, then the descriptors still valid are
+ *   copied out in the sent order (TX FIFO Queues by queue number, then TX Priority Queue slots by slot number) and the aborted queues are reset.
+ * Pinned TX Priority Queue slots stay pinned and are not copied out
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] fifoQueues Is the mask of the TX FIFO Queues to abort (bit n is the TX FIFO Queue n)
+ * @param[in] pqSlots Is the mask of the TX Priority Queue slots to abort (bit n is the slot n)
+ * @param[in] timeoutMs Is the maximum time to wait the queues and slots inactive. XCAN.fnGetCurrentms shall be set
+ * @param[out] *pUnsent Is the array where the unsent descriptors will be stored. Can be NULL if maxUnsent is 0
+ * @param[in] maxUnsent Is the maximum count of unsent descriptors in the array
+ * @param[out] *pUnsentCount Is where the count of unsent descriptors stored will be stored. Can be NULL
+ * @return Returns an #eERRORRESULT value enum, ERR__DEVICE_TIMEOUT if the queues are still busy after the timeout, ERR__BUFFER_FULL if unsent descriptors were dropped for lack of room
+ */
+eERRORRESULT XCAN_AbortTxQueues(XCAN *pComp, uint8_t fifoQueues, uint32_t pqSlots, uint32_t timeoutMs, XCAN_TxUnsentDescriptor* pUnsent, size_t maxUnsent, size_t* pUnsentCount);
+
+/*! @brief Requeue unsent TX descriptors
+ *
+ * Publish each kept descriptor again in its TX FIFO Queue (one START per queue) or in a free TX Priority Queue slot. Dropped descriptors release their payload buffer
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] *pUnsent Is the array of unsent descriptors got with XCAN_AbortTxQueues()
+ * @param[in] count Is the count of unsent descriptors in the array
+ * @param[in] fnKeep Is the function that decides to requeue or drop each descriptor. Can be NULL to requeue all
+ * @param[in] *pContext Is the context given to fnKeep
+ * @param[out] *pRequeuedCount Is where the count of descriptors requeued will be stored. Can be NULL
+ * @return Returns an #eERRORRESULT value enum, ERR__BUFFER_FULL if a queue has no more room (the descriptors not requeued are the last ones of the array)
+ */
+eERRORRESULT XCAN_RequeueTxDescriptors(XCAN *pComp, const XCAN_TxUnsentDescriptor* pUnsent, size_t count, XCAN_TxRequeueFilter_Func fnKeep, void* pContext, size_t* pRequeuedCount);
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// XCAN RX FIFO Queues
+//********************************************************************************************************************
+
+/*! @brief Check the rolling counter of an RX header descriptor
+ *
+ * Compare the RIC1.RC with the one expected for the RX FIFO Queue and call XCAN.fnRollingCounterError in case of gap or reorder.
+ * The expected rolling counter is then set after the descriptors used by this RX message
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] queue Is the RX FIFO Queue of the descriptor
+ * @param[in] ric1 Is the RIC1 word of the RX header descriptor
+ * @param[in] descCount Is the count of descriptors used by the RX message (1 in Continuous Mode)
+ * @return Returns 'true' if the rolling counter is the one expected, else 'false'
+ */
+bool XCAN_CheckRxRollingCounter(XCAN *pComp, eXCAN_FIFOQueue queue, uint32_t ric1, uint16_t descCount);
+
+/*! @brief Configure an RX FIFO Queue of the X_CAN device in Continuous Mode
+ *
+ * MH_CFG.RX_CONT_DC shall be set (XCAN_MH_CFG_CONTINUOUS_MODE_ACTIVE). Initialize the descriptors with their rolling counters, set the link list, the data container and the initial read address pointer, then enable the RX FIFO Queue.
+ * The RX FIFO Queue registers are only writable when the RX FIFO Queue is not busy
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] *pConf Is the RX FIFO Queue configuration
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_ConfigureRxContinuousQueue(XCAN *pComp, const XCAN_RxContinuousQueueConfig* pConf);
+
+/*! @brief Read the RX messages available in an RX FIFO Queue in Continuous Mode without copying them
+ *
+ * Each message is returned as a view with its decoded header and its payload pointing directly in the data container, in 2 parts if it wraps at the end of the data container.
+ * The views stay valid until the messages are released with XCAN_ReleaseRxContinuousMessages(). The rolling counter of each descriptor is checked with XCAN_CheckRxRollingCounter()
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] queue Is the RX FIFO Queue to read
+ * @param[out] *pViews Is the array where the message views will be stored, in the received order
+ * @param[in] maxCount Is the count of elements of the pViews array
+ * @param[out] *pReadCount Is where the count of messages read will be stored
+ * @return Returns an #eERRORRESULT value enum, ERR__OUT_OF_RANGE if the MH wrote an RX_AP outside the data container
+ */
+eERRORRESULT XCAN_ReadRxContinuousMessages(XCAN *pComp, eXCAN_FIFOQueue queue, XCAN_RxMessageView* pViews, size_t maxCount, size_t* pReadCount);
+
+/*! @brief Release the oldest RX messages read of an RX FIFO Queue in Continuous Mode
+ *
+ * The descriptors are given back to the MH and the RX_FQ_RD_ADD_PTn register is written once with the last word of the last message released
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] queue Is the RX FIFO Queue of the messages
+ * @param[in] count Is the count of messages to release, in the read order. Cannot be more than the messages read and not yet released
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_ReleaseRxContinuousMessages(XCAN *pComp, eXCAN_FIFOQueue queue, size_t count);
+
+/*! @brief Set the watermarks of the data container of an RX FIFO Queue in Continuous Mode
+ *
+ * XCAN.fnRxHighWatermark is called when the bytes of the RX messages read and not yet released reach highBytes
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] queue Is the RX FIFO Queue to set
+ * @param[in] highBytes Is the fill in bytes that calls XCAN.fnRxHighWatermark. 0 to disable
+ * @param[in] lowBytes Is the fill in bytes at or under which XCAN.fnRxHighWatermark can be called again. Shall be lower than highBytes
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_SetRxWatermarks(XCAN *pComp, eXCAN_FIFOQueue queue, uint32_t highBytes, uint32_t lowBytes);
+
+/*! @brief Get the fill of the data container of an RX FIFO Queue in Continuous Mode
+ *
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] queue Is the RX FIFO Queue to check
+ * @param[out] *pFillBytes Is where the bytes of the RX messages read and not yet released will be stored
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_GetRxDataContainerFill(XCAN *pComp, eXCAN_FIFOQueue queue, uint32_t* pFillBytes);
+
+/*! @brief Recover the RX FIFO Queues in Continuous Mode stopped because their data container is full
+ *
+ * Read RX_FQ_STS2 (DC_FULL) once for all the RX FIFO Queues in Continuous Mode, the RX FIFO Queues stopped for another reason are not restarted. For each full RX FIFO Queue, with the
+ * XCAN_RX_OVERFLOW_DROP_UNREAD policy, the RX messages not yet read are dropped (counted in XCAN_RxFIFOQueueRing.Dropped) and their space is given back with one RX_FQ_RD_ADD_PTn write.
+ * If the application still holds messages of the RX FIFO Queue (read and not released), nothing can be dropped and the RX FIFO Queue is not restarted: release them then call again.
+ * Then all the recovered RX FIFO Queues are restarted with one RX_FQ_CTRL0.START write. RX_STATISTICS.UNSUCC is accumulated in XCAN.RxUnsuccessful.
+ * Call it on the MH_RX_FQn_IRQ or the RX FIFO Queue stopped interrupt, or periodically
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] policy Is what to do with the RX messages not yet read
+ * @param[out] *pRestartedQueues Is where the RX FIFO Queues restarted will be stored (bit n = RX FIFO Queue n). Can be NULL
+ * @return Returns an #eERRORRESULT value enum, ERR__NOT_READY if a full RX FIFO Queue is not restarted because the application holds some of its messages (XCAN_RX_OVERFLOW_DROP_UNREAD)
+ */
+eERRORRESULT XCAN_RecoverRxDataContainerFull(XCAN *pComp, eXCAN_RxOverflowPolicy policy, uint8_t* pRestartedQueues);
+
+/*! @brief Initialize an RX buffer pool
+ *
+ * @param[out] *pPool Is the pool to initialize
+ * @param[in] *pMemory Is the memory of the pool in S_MEM. Must be aligned on a uintptr_t
+ * @param[in] bufferSize Is the size of each buffer in bytes, it will be rounded up to keep the buffers aligned
+ * @param[in] bufferCount Is the count of buffers in the memory
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_InitRxBufferPool(XCAN_RxBufferPool* pPool, uint8_t* pMemory, size_t bufferSize, uint16_t bufferCount);
+
+/*! @brief Allocate an RX buffer from a pool
+ *
+ * @param[in] *pPool Is the pool to use
+ * @param[out] **pBuffer Is where the buffer address will be stored
+ * @return Returns an #eERRORRESULT value enum, ERR__OUT_OF_MEMORY if the pool is empty
+ */
+eERRORRESULT XCAN_AllocRxBuffer(XCAN_RxBufferPool* pPool, uint8_t** pBuffer);
+
+/*! @brief Free an RX buffer to its pool
+ *
+ * @param[in] *pPool Is the pool of the buffer
+ * @param[in] *pBuffer Is the buffer to free
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_FreeRxBuffer(XCAN_RxBufferPool* pPool, uint8_t* pBuffer);
+
+/*! @brief Configure an RX FIFO Queue of the X_CAN device in Normal Mode
+ *
+ * MH_CFG.RX_CONT_DC shall be cleared. A buffer of the pool is posted on each descriptor, then the link list is set and the RX FIFO Queue is enabled.
+ * The RX FIFO Queue registers are only writable when the RX FIFO Queue is not busy
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] *pConf Is the RX FIFO Queue configuration
+ * @return Returns an #eERRORRESULT value enum, ERR__OUT_OF_MEMORY if the pool does not have a buffer for each descriptor, ERR__CONFIGURATION if the MaxDesc data containers cannot hold an RX message of MaxPayloadSize bytes
+ */
+eERRORRESULT XCAN_ConfigureRxNormalQueue(XCAN *pComp, const XCAN_RxNormalQueueConfig* pConf);
+
+/*! @brief Receive the RX messages available in an RX FIFO Queue in Normal Mode without copying them
+ *
+ * The buffers of the messages are given to the application and, in the same pass, the descriptors are given back to the MH with fresh buffers of the pool.
+ * If the pool is empty, the descriptors wait for XCAN_RearmRxNormalQueue(). Messages using more than XCAN_RX_NORMAL_MAX_DESC_PER_MESSAGE descriptors are dropped, as the messages larger than the link list
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] queue Is the RX FIFO Queue to read
+ * @param[out] *pMessages Is the array where the messages will be stored, in the received order
+ * @param[in] maxCount Is the count of elements of the pMessages array
+ * @param[out] *pReceivedCount Is where the count of messages received will be stored
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_ReceiveRxNormalMessages(XCAN *pComp, eXCAN_FIFOQueue queue, XCAN_RxNormalMessage* pMessages, size_t maxCount, size_t* pReceivedCount);
+
+/*! @brief Give back to the MH all the descriptors of an RX FIFO Queue in Normal Mode waiting for a buffer
+ *
+ * Call it after buffers have been freed to the pool. The descriptors are given back in order and the RX FIFO Queue is restarted if it was on hold
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] queue Is the RX FIFO Queue to re-arm
+ * @param[out] *pRearmedCount Is where the count of descriptors given back will be stored. Can be NULL
+ * @return Returns an #eERRORRESULT value enum, ERR__OUT_OF_MEMORY if some descriptors are still waiting for a buffer
+ */
+eERRORRESULT XCAN_RearmRxNormalQueue(XCAN *pComp, eXCAN_FIFOQueue queue, size_t* pRearmedCount);
+
+/*! @brief Receive the RX messages available in an RX FIFO Queue in Normal Mode as lists of segments without copying them
+ *
+ * Unlike XCAN_ReceiveRxNormalMessages(), a message can use any count of descriptors up to MaxDesc (chained with NEXT in the header descriptor), the payload of each descriptor is a segment.
+ * A message larger than the link list is dropped (counted in XCAN_RxFIFOQueueRing.Dropped).
+ * The segments of all the messages are stored in pSegments, the reception stops at the first message which segments do not fit, this message stays in the RX FIFO Queue.
+ * The buffers of the segments are given to the application until XCAN_ReleaseRxSegmentedMessages(), fresh buffers are posted on the descriptors in the same pass
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] queue Is the RX FIFO Queue to read
+ * @param[out] *pMessages Is the array where the messages will be stored
+ * @param[in] maxCount Is the count of elements of the pMessages array
+ * @param[out] *pSegments Is the array where the segments of the messages will be stored
+ * @param[in] maxSegments Is the count of elements of the pSegments array
+ * @param[out] *pReceivedCount Is where the count of messages received will be stored
+ * @return Returns an #eERRORRESULT value enum, ERR__BUFFER_FULL if the first message available does not fit in maxSegments
+ */
+eERRORRESULT XCAN_ReceiveRxSegmentedMessages(XCAN *pComp, eXCAN_FIFOQueue queue, XCAN_RxSegmentedMessage* pMessages, size_t maxCount, XCAN_RxSegment* pSegments, size_t maxSegments, size_t* pReceivedCount);
+
+/*! @brief Release RX messages received with XCAN_ReceiveRxSegmentedMessages()
+ *
+ * The buffers of the segments are freed to the pool of the RX FIFO Queue and the descriptors waiting for a buffer are re-armed
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] queue Is the RX FIFO Queue of the messages
+ * @param[in] *pMessages Is the messages to release
+ * @param[in] count Is the count of messages to release
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_ReleaseRxSegmentedMessages(XCAN *pComp, eXCAN_FIFOQueue queue, const XCAN_RxSegmentedMessage* pMessages, size_t count);
+
+/*! @brief Copy the payload of a segmented RX message in a contiguous buffer
+ *
+ * For the consumers that need a flat payload. The segments stay owned by the application
+ * @param[in] *pMessage Is the message to copy
+ * @param[out] *pDest Is the buffer where the payload will be copied
+ * @param[in] destSize Is the size in bytes of the pDest buffer
+ * @return Returns an #eERRORRESULT value enum, ERR__BAD_DATA_SIZE if the payload does not fit in destSize (nothing copied)
+ */
+eERRORRESULT XCAN_CopyRxSegments(const XCAN_RxSegmentedMessage* pMessage, uint8_t* pDest, size_t destSize);
+
+/*! @brief Set the drain order of the RX FIFO Queues by XCAN_PollRxFIFOQueues()
+ *
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] *pOrder Is the 8 RX FIFO Queues from the first drained to the last one. Each queue shall appear once. NULL to drain by queue number
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_SetRxPollOrder(XCAN *pComp, const eXCAN_FIFOQueue* pOrder);
+
+/*! @brief Poll all the configured RX FIFO Queues for received frames
+ *
+ * One read of the FUNC_RAW register (MH_RX_FQn_IRQ flags) gives the RX FIFO Queues with new frames, the RX FIFO Queues configured with IrqWhenReceived and without flag are skipped.
+ * The RX FIFO Queues configured without IrqWhenReceived are always checked (only a descriptor read in memory). The flags are cleared with one write to FUNC_CLR before draining.
+ * The RX FIFO Queues are drained in the order set by XCAN_SetRxPollOrder(), an RX FIFO Queue not fully drained is checked first by the next poll whatever its flag.
+ * In Normal Mode, the descriptors are re-armed in the same pass
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[out] *pFrames Is the array where the frames will be stored
+ * @param[in] maxCount Is the count of elements of the pFrames array
+ * @param[out] *pPolledCount Is where the count of frames polled will be stored
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_PollRxFIFOQueues(XCAN *pComp, XCAN_RxFrame* pFrames, size_t maxCount, size_t* pPolledCount);
+
+/*! @brief Release the frames polled by XCAN_PollRxFIFOQueues()
+ *
+ * The frames of the RX FIFO Queues in Continuous Mode are released with one RX_FQ_RD_ADD_PTn write per RX FIFO Queue.
+ * Buffers of the frames in Normal Mode are freed to their pool and the descriptors waiting for a buffer are re-armed
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] *pFrames Is the frames to release, all the frames of the last poll in the polled order
+ * @param[in] count Is the count of frames to release
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_ReleaseRxPolledFrames(XCAN *pComp, const XCAN_RxFrame* pFrames, size_t count);
+
+/*! @brief Configure the adaptive interrupt/poll RX
+ *
+ * Read the FUNC_ENA register once in the XCAN.FuncEnable shadow and enable the interrupts of the RX FIFO Queues configured with IrqWhenReceived (interrupt mode).
+ * Then XCAN_RxAdaptiveInterruptHandler() switches to poll mode at the first interrupt, and XCAN_RxAdaptivePoll() switches back to interrupt mode once the RX FIFO Queues run dry.
+ * The RX FIFO Queues shall be configured before, the RX FIFO Queues configured without IrqWhenReceived are only checked by the polls
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] *pConf Is the switching thresholds
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_ConfigureRxAdaptivePoll(XCAN *pComp, const XCAN_RxAdaptiveConfig* pConf);
+
+/*! @brief Handle an RX FIFO Queues interrupt of the adaptive interrupt/poll RX
+ *
+ * To call in the interrupt handler. Mask the RX FIFO Queues interrupts with one FUNC_ENA write and switch to poll mode, the flags are cleared by the polls.
+ * This function and XCAN_RxAdaptivePoll() never run at the same time: the interrupts are masked during the whole poll mode
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[out] *pSchedulePoll Is where 'true' will be stored if the application shall schedule XCAN_RxAdaptivePoll() calls
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_RxAdaptiveInterruptHandler(XCAN *pComp, bool* pSchedulePoll);
+
+/*! @brief Poll the RX FIFO Queues in poll mode of the adaptive interrupt/poll RX
+ *
+ * Call XCAN_PollRxFIFOQueues() with maxCount as budget. After DryPollsToIrq consecutive dry polls with all the RX FIFO Queues drained, the RX FIFO Queues
+ * interrupts are unmasked with one FUNC_ENA write and the device goes back to interrupt mode. A frame received after the last poll keeps its flag set in FUNC_RAW
+ * so the interrupt triggers as soon as it is unmasked
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[out] *pFrames Is the array where the frames will be stored
+ * @param[in] maxCount Is the count of elements of the pFrames array (poll budget)
+ * @param[out] *pPolledCount Is where the count of frames polled will be stored
+ * @param[out] *pPollAgain Is where 'true' will be stored if the device stays in poll mode and the application shall call this function again, 'false' if back in interrupt mode
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_RxAdaptivePoll(XCAN *pComp, XCAN_RxFrame* pFrames, size_t maxCount, size_t* pPolledCount, bool* pPollAgain);
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// XCAN TX Priority Queue
+//********************************************************************************************************************
+
+/*! @brief Configure the TX Priority Queue of the X_CAN device
+ *
+ * Clear the 32 descriptors, set the TX Priority Queue start address and enable the slots.
+ * The TX Priority Queue start address is only writable when no slot is busy
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] *pDescriptors Is the array of the 32 contiguous descriptors of the TX Priority Queue in S_MEM. Must be 32-bits aligned
+ * @param[in] enabledSlots Is the mask of the slots to enable (bit n is slot n)
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_ConfigureTxPriorityQueue(XCAN *pComp, XCAN_CAN_TxMessage* pDescriptors, uint32_t enabledSlots);
+
+/*! @brief Reclaim the TX Priority Queue slots that are no more busy
+ *
+ * Read the TX_PQ_STS0 register once, all started slots not busy anymore are completed. Not pinned completed slots are freed
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[out] *pCompletedSlots Is where the mask of the slots completed since the last reclaim will be stored. Can be NULL
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_ReclaimTxPQSlots(XCAN *pComp, uint32_t* pCompletedSlots);
+
+/*! @brief Transmit a message through a free slot of the TX Priority Queue
+ *
+ * The lowest free slot is used, the busy slots are only reclaimed (one TX_PQ_STS0 read) when no slot is free
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] *pMessage Is the message to transmit
+ * @param[in] irqWhenSent Set to 'true' to trigger an interrupt when the message has been sent
+ * @param[out] *pSlot Is where the slot used will be stored. Can be NULL
+ * @return Returns an #eERRORRESULT value enum, ERR__BUFFER_FULL if no slot is free
+ */
+eERRORRESULT XCAN_TransmitMessageToTxPQ(XCAN *pComp, const XCAN_CANMessage* pMessage, bool irqWhenSent, uint8_t* pSlot);
+
+/*! @brief Pin a TX Priority Queue slot to a periodic message
+ *
+ * The descriptor of the slot is built once and the slot is never allocated by XCAN_TransmitMessageToTxPQ() until it is unpinned.
+ * The message is not sent, use XCAN_RestartPinnedTxPQSlot() to send it
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] *pMessage Is the periodic message. For payloads in a data container (CAN-FD > 4 bytes and CAN-XL), the payload buffer is the data container of the slot. With XCAN_PAYLOAD_FROM_POOL, the buffer is freed when the slot is unpinned
+ * @param[in] irqWhenSent Set to 'true' to trigger an interrupt each time the message has been sent
+ * @param[out] *pSlot Is where the slot pinned will be stored
+ * @return Returns an #eERRORRESULT value enum, ERR__BUFFER_FULL if no slot is free
+ */
+eERRORRESULT XCAN_PinTxPQSlot(XCAN *pComp, const XCAN_CANMessage* pMessage, bool irqWhenSent, uint8_t* pSlot);
+
+/*! @brief Patch the payload of a pinned TX Priority Queue slot and restart it
+ *
+ * Only the payload words of the descriptor are patched (TD0/TD1), then the TIC1 is refreshed and the slot is started
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] slot Is the pinned slot to restart
+ * @param[in] *pData Is the new payload with the same size as the pinned message. For payloads in a data container, it shall be the data container updated by the caller. Can be NULL to send the same payload
+ * @return Returns an #eERRORRESULT value enum, ERR__NOT_READY if the previous message of the slot is not sent yet
+ */
+eERRORRESULT XCAN_RestartPinnedTxPQSlot(XCAN *pComp, uint8_t slot, const uint8_t* pData);
+
+/*! @brief Unpin a TX Priority Queue slot
+ *
+ * The slot will be free to be allocated once its last message is completed, its payload buffer from the TX payload pool is freed at the same time
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] slot Is the pinned slot to release
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_UnpinTxPQSlot(XCAN *pComp, uint8_t slot);
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// XCAN RX Filters
+//********************************************************************************************************************
+
+/*! @brief Configure the RX filters of the X_CAN device
+ *
+ * Set the RX filter elements table address (RX_FILTER_MEM_ADD) and the filtering (RX_FILTER_CTRL). The THRESHOLD and ANFF settings are kept.
+ * The MH shall not be started. The table can be built with XCAN_CompileRxFilters()
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] *pConf Is the RX filters configuration
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_ConfigureRxFilters(XCAN *pComp, const XCAN_RxFilterConfig* pConf);
+
+/*! @brief Set the RX filtering threshold of the X_CAN device
+ *
+ * When the RX filtering result is not known before the RX DMA FIFO level reaches the threshold, the message is stored in the default RX FIFO Queue with R1.FAB set.
+ * The MH shall not be busy. XCAN_RecommendRxFilterThreshold() gives a threshold for a filter elements table
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] threshold Is the RX DMA FIFO level in 32-bits words (1 to 31). 0 to disable the threshold mechanism
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_SetRxFilterThreshold(XCAN *pComp, uint8_t threshold);
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// XCAN TX Filter
+//********************************************************************************************************************
+
+/*! @brief Configure the TX filter of the X_CAN device
+ *
+ * The TX filter is disabled while the registers are written, then TX_FILTER_CTRL0 is written last. The MH shall not be busy (MH_STS.BUSY = 0)
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] *pConf Is the TX filter configuration
+ * @return Returns an #eERRORRESULT value enum, ERR__NOT_READY if the MH is busy
+ */
+eERRORRESULT XCAN_ConfigureTxFilter(XCAN *pComp, const XCAN_TxFilterConfig* pConf);
+
+/*! @brief Get the TX queue of the last message rejected by the TX filter
+ *
+ * Call it on the MH_TX_FILTER_IRQ interrupt
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[out] *pRejection Is where the rejection information will be stored
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_GetTxFilterRejection(XCAN *pComp, XCAN_TxFilterRejection* pRejection);
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* XCAN_H_INC */
@@ -0,0 +1,336 @@
+/*!*****************************************************************************
+ * @file    XCAN_DescCRC.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN descriptors 9-bits CRC
+ * @details
+ * The CRC of a descriptor is the remainder of M(x).x^9 divided by P(x), M(x)
+ *   being the descriptor words, first word MSB as highest degree.
+ * The table driven CRC process a 32-bits word as: crc' = (W ^ (crc << 23)).x^9
+ *   mod P, that is the XOR of the 4 tables Tk[byte k of the word].
+ * The carry-less multiply CRC folds each word with the constant x^(32p+9) mod P
+ *   (p is the word position from the end) and reduces the XOR of the products
+ *   with a Barrett reduction.
+ * Bench/XCAN_DescCRC_Bench.c checks every tables entry and folding constant
+ *   with the bitwise CRC of its index.
+ ******************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "XCAN_DescCRC.h"
+//-----------------------------------------------------------------------------
+#if defined(XCAN_DESC_CRC_USE_CLMUL)
+#  if defined(__x86_64__) && defined(__PCLMUL__)
+#    include <wmmintrin.h>
+#    define XCAN_DESC_CRC_CLMUL_AVAILABLE
+#  elif defined(__aarch64__) && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES))
+#    include <arm_neon.h>
+#    define XCAN_DESC_CRC_CLMUL_AVAILABLE
+#  endif
+#endif
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#if (XCAN_DESC_CRC9_POLY != 0x119u)
+#  error The CRC9 lookup tables and constants of XCAN_DescCRC.c are generated for the polynomial 0x119, regenerate them for the new XCAN_DESC_CRC9_POLY
+#endif
+#if (XCAN_DESC_CRC_SLICE != 1) && (XCAN_DESC_CRC_SLICE != 4) && (XCAN_DESC_CRC_SLICE != 8)
+#  error XCAN_DESC_CRC_SLICE shall be 1, 4 or 8
+#endif
+
+//-----------------------------------------------------------------------------
+
+#if (XCAN_DESC_CRC_SLICE >= 1)
+//! CRC9 table for a byte at position 0 from the end of the slice: T0[i] = (i.x^9) mod P
+static const uint16_t XCAN_DESC_CRC9_TABLE0[256] =
+{
+  0x000, 0x119, 0x12B, 0x032, 0x14F, 0x056, 0x064, 0x17D, 0x187, 0x09E, 0x0AC, 0x1B5, 0x0C8, 0x1D1, 0x1E3, 0x0FA,
+  0x017, 0x10E, 0x13C, 0x025, 0x158, 0x041, 0x073, 0x16A, 0x190, 0x089, 0x0BB, 0x1A2, 0x0DF, 0x1C6, 0x1F4, 0x0ED,
+  0x02E, 0x137, 0x105, 0x01C, 0x161, 0x078, 0x04A, 0x153, 0x1A9, 0x0B0, 0x082, 0x19B, 0x0E6, 0x1FF, 0x1CD, 0x0D4,
+  0x039, 0x120, 0x112, 0x00B, 0x176, 0x06F, 0x05D, 0x144, 0x1BE, 0x0A7, 0x095, 0x18C, 0x0F1, 0x1E8, 0x1DA, 0x0C3,
+  0x05C, 0x145, 0x177, 0x06E, 0x113, 0x00A, 0x038, 0x121, 0x1DB, 0x0C2, 0x0F0, 0x1E9, 0x094, 0x18D, 0x1BF, 0x0A6,
+  0x04B, 0x152, 0x160, 0x079, 0x104, 0x01D, 0x02F, 0x136, 0x1CC, 0x0D5, 0x0E7, 0x1FE, 0x083, 0x19A, 0x1A8, 0x0B1,
+  0x072, 0x16B, 0x159, 0x040, 0x13D, 0x024, 0x016, 0x10F, 0x1F5, 0x0EC, 0x0DE, 0x1C7, 0x0BA, 0x1A3, 0x191, 0x088,
+  0x065, 0x17C, 0x14E, 0x057, 0x12A, 0x033, 0x001, 0x118, 0x1E2, 0x0FB, 0x0C9, 0x1D0, 0x0AD, 0x1B4, 0x186, 0x09F,
+  0x0B8, 0x1A1, 0x193, 0x08A, 0x1F7, 0x0EE, 0x0DC, 0x1C5, 0x13F, 0x026, 0x014, 0x10D, 0x070, 0x169, 0x15B, 0x042,
+  0x0AF, 0x1B6, 0x184, 0x09D, 0x1E0, 0x0F9, 0x0CB, 0x1D2, 0x128, 0x031, 0x003, 0x11A, 0x067, 0x17E, 0x14C, 0x055,
+  0x096, 0x18F, 0x1BD, 0x0A4, 0x1D9, 0x0C0, 0x0F2, 0x1EB, 0x111, 0x008, 0x03A, 0x123, 0x05E, 0x147, 0x175, 0x06C,
+  0x081, 0x198, 0x1AA, 0x0B3, 0x1CE, 0x0D7, 0x0E5, 0x1FC, 0x106, 0x01F, 0x02D, 0x134, 0x049, 0x150, 0x162, 0x07B,
+  0x0E4, 0x1FD, 0x1CF, 0x0D6, 0x1AB, 0x0B2, 0x080, 0x199, 0x163, 0x07A, 0x048, 0x151, 0x02C, 0x135, 0x107, 0x01E,
+  0x0F3, 0x1EA, 0x1D8, 0x0C1, 0x1BC, 0x0A5, 0x097, 0x18E, 0x174, 0x06D, 0x05F, 0x146, 0x03B, 0x122, 0x110, 0x009,
+  0x0CA, 0x1D3, 0x1E1, 0x0F8, 0x185, 0x09C, 0x0AE, 0x1B7, 0x14D, 0x054, 0x066, 0x17F, 0x002, 0x11B, 0x129, 0x030,
+  0x0DD, 0x1C4, 0x1F6, 0x0EF, 0x192, 0x08B, 0x0B9, 0x1A0, 0x15A, 0x043, 0x071, 0x168, 0x015, 0x10C, 0x13E, 0x027,
+};
+#endif
+
+#if (XCAN_DESC_CRC_SLICE >= 4)
+//! CRC9 tables for a byte at position k from the end of the slice: Tk[i] = (i.x^(8k+9)) mod P
+static const uint16_t XCAN_DESC_CRC9_TABLE1[256] =
+{
+  0x000, 0x170, 0x1F9, 0x089, 0x0EB, 0x19B, 0x112, 0x062, 0x1D6, 0x0A6, 0x02F, 0x15F, 0x13D, 0x04D, 0x0C4, 0x1B4,
+  0x0B5, 0x1C5, 0x14C, 0x03C, 0x05E, 0x12E, 0x1A7, 0x0D7, 0x163, 0x013, 0x09A, 0x1EA, 0x188, 0x0F8, 0x071, 0x101,
+  0x16A, 0x01A, 0x093, 0x1E3, 0x181, 0x0F1, 0x078, 0x108, 0x0BC, 0x1CC, 0x145, 0x035, 0x057, 0x127, 0x1AE, 0x0DE,
+  0x1DF, 0x0AF, 0x026, 0x156, 0x134, 0x044, 0x0CD, 0x1BD, 0x009, 0x179, 0x1F0, 0x080, 0x0E2, 0x192, 0x11B, 0x06B,
+  0x1CD, 0x0BD, 0x034, 0x144, 0x126, 0x056, 0x0DF, 0x1AF, 0x01B, 0x16B, 0x1E2, 0x092, 0x0F0, 0x180, 0x109, 0x079,
+  0x178, 0x008, 0x081, 0x1F1, 0x193, 0x0E3, 0x06A, 0x11A, 0x0AE, 0x1DE, 0x157, 0x027, 0x045, 0x135, 0x1BC, 0x0CC,
+  0x0A7, 0x1D7, 0x15E, 0x02E, 0x04C, 0x13C, 0x1B5, 0x0C5, 0x171, 0x001, 0x088, 0x1F8, 0x19A, 0x0EA, 0x063, 0x113,
+  0x012, 0x162, 0x1EB, 0x09B, 0x0F9, 0x189, 0x100, 0x070, 0x1C4, 0x0B4, 0x03D, 0x14D, 0x12F, 0x05F, 0x0D6, 0x1A6,
+  0x083, 0x1F3, 0x17A, 0x00A, 0x068, 0x118, 0x191, 0x0E1, 0x155, 0x025, 0x0AC, 0x1DC, 0x1BE, 0x0CE, 0x047, 0x137,
+  0x036, 0x146, 0x1CF, 0x0BF, 0x0DD, 0x1AD, 0x124, 0x054, 0x1E0, 0x090, 0x019, 0x169, 0x10B, 0x07B, 0x0F2, 0x182,
+  0x1E9, 0x099, 0x010, 0x160, 0x102, 0x072, 0x0FB, 0x18B, 0x03F, 0x14F, 0x1C6, 0x0B6, 0x0D4, 0x1A4, 0x12D, 0x05D,
+  0x15C, 0x02C, 0x0A5, 0x1D5, 0x1B7, 0x0C7, 0x04E, 0x13E, 0x08A, 0x1FA, 0x173, 0x003, 0x061, 0x111, 0x198, 0x0E8,
+  0x14E, 0x03E, 0x0B7, 0x1C7, 0x1A5, 0x0D5, 0x05C, 0x12C, 0x098, 0x1E8, 0x161, 0x011, 0x073, 0x103, 0x18A, 0x0FA,
+  0x1FB, 0x08B, 0x002, 0x172, 0x110, 0x060, 0x0E9, 0x199, 0x02D, 0x15D, 0x1D4, 0x0A4, 0x0C6, 0x1B6, 0x13F, 0x04F,
+  0x024, 0x154, 0x1DD, 0x0AD, 0x0CF, 0x1BF, 0x136, 0x046, 0x1F2, 0x082, 0x00B, 0x17B, 0x119, 0x069, 0x0E0, 0x190,
+  0x091, 0x1E1, 0x168, 0x018, 0x07A, 0x10A, 0x183, 0x0F3, 0x147, 0x037, 0x0BE, 0x1CE, 0x1AC, 0x0DC, 0x055, 0x125,
+};
+
+static const uint16_t XCAN_DESC_CRC9_TABLE2[256] =
+{
+  0x000, 0x106, 0x115, 0x013, 0x133, 0x035, 0x026, 0x120, 0x17F, 0x079, 0x06A, 0x16C, 0x04C, 0x14A, 0x159, 0x05F,
+  0x1E7, 0x0E1, 0x0F2, 0x1F4, 0x0D4, 0x1D2, 0x1C1, 0x0C7, 0x098, 0x19E, 0x18D, 0x08B, 0x1AB, 0x0AD, 0x0BE, 0x1B8,
+  0x0D7, 0x1D1, 0x1C2, 0x0C4, 0x1E4, 0x0E2, 0x0F1, 0x1F7, 0x1A8, 0x0AE, 0x0BD, 0x1BB, 0x09B, 0x19D, 0x18E, 0x088,
+  0x130, 0x036, 0x025, 0x123, 0x003, 0x105, 0x116, 0x010, 0x04F, 0x149, 0x15A, 0x05C, 0x17C, 0x07A, 0x069, 0x16F,
+  0x1AE, 0x0A8, 0x0BB, 0x1BD, 0x09D, 0x19B, 0x188, 0x08E, 0x0D1, 0x1D7, 0x1C4, 0x0C2, 0x1E2, 0x0E4, 0x0F7, 0x1F1,
+  0x049, 0x14F, 0x15C, 0x05A, 0x17A, 0x07C, 0x06F, 0x169, 0x136, 0x030, 0x023, 0x125, 0x005, 0x103, 0x110, 0x016,
+  0x179, 0x07F, 0x06C, 0x16A, 0x04A, 0x14C, 0x15F, 0x059, 0x006, 0x100, 0x113, 0x015, 0x135, 0x033, 0x020, 0x126,
+  0x09E, 0x198, 0x18B, 0x08D, 0x1AD, 0x0AB, 0x0B8, 0x1BE, 0x1E1, 0x0E7, 0x0F4, 0x1F2, 0x0D2, 0x1D4, 0x1C7, 0x0C1,
+  0x045, 0x143, 0x150, 0x056, 0x176, 0x070, 0x063, 0x165, 0x13A, 0x03C, 0x02F, 0x129, 0x009, 0x10F, 0x11C, 0x01A,
+  0x1A2, 0x0A4, 0x0B7, 0x1B1, 0x091, 0x197, 0x184, 0x082, 0x0DD, 0x1DB, 0x1C8, 0x0CE, 0x1EE, 0x0E8, 0x0FB, 0x1FD,
+  0x092, 0x194, 0x187, 0x081, 0x1A1, 0x0A7, 0x0B4, 0x1B2, 0x1ED, 0x0EB, 0x0F8, 0x1FE, 0x0DE, 0x1D8, 0x1CB, 0x0CD,
+  0x175, 0x073, 0x060, 0x166, 0x046, 0x140, 0x153, 0x055, 0x00A, 0x10C, 0x11F, 0x019, 0x139, 0x03F, 0x02C, 0x12A,
+  0x1EB, 0x0ED, 0x0FE, 0x1F8, 0x0D8, 0x1DE, 0x1CD, 0x0CB, 0x094, 0x192, 0x181, 0x087, 0x1A7, 0x0A1, 0x0B2, 0x1B4,
+  0x00C, 0x10A, 0x119, 0x01F, 0x13F, 0x039, 0x02A, 0x12C, 0x173, 0x075, 0x066, 0x160, 0x040, 0x146, 0x155, 0x053,
+  0x13C, 0x03A, 0x029, 0x12F, 0x00F, 0x109, 0x11A, 0x01C, 0x043, 0x145, 0x156, 0x050, 0x170, 0x076, 0x065, 0x163,
+  0x0DB, 0x1DD, 0x1CE, 0x0C8, 0x1E8, 0x0EE, 0x0FD, 0x1FB, 0x1A4, 0x0A2, 0x0B1, 0x1B7, 0x097, 0x191, 0x182, 0x084,
+};
+
+static const uint16_t XCAN_DESC_CRC9_TABLE3[256] =
+{
+  0x000, 0x08A, 0x114, 0x19E, 0x131, 0x1BB, 0x025, 0x0AF, 0x17B, 0x1F1, 0x06F, 0x0E5, 0x04A, 0x0C0, 0x15E, 0x1D4,
+  0x1EF, 0x165, 0x0FB, 0x071, 0x0DE, 0x054, 0x1CA, 0x140, 0x094, 0x01E, 0x180, 0x10A, 0x1A5, 0x12F, 0x0B1, 0x03B,
+  0x0C7, 0x04D, 0x1D3, 0x159, 0x1F6, 0x17C, 0x0E2, 0x068, 0x1BC, 0x136, 0x0A8, 0x022, 0x08D, 0x007, 0x199, 0x113,
+  0x128, 0x1A2, 0x03C, 0x0B6, 0x019, 0x093, 0x10D, 0x187, 0x053, 0x0D9, 0x147, 0x1CD, 0x162, 0x1E8, 0x076, 0x0FC,
+  0x18E, 0x104, 0x09A, 0x010, 0x0BF, 0x035, 0x1AB, 0x121, 0x0F5, 0x07F, 0x1E1, 0x16B, 0x1C4, 0x14E, 0x0D0, 0x05A,
+  0x061, 0x0EB, 0x175, 0x1FF, 0x150, 0x1DA, 0x044, 0x0CE, 0x11A, 0x190, 0x00E, 0x084, 0x02B, 0x0A1, 0x13F, 0x1B5,
+  0x149, 0x1C3, 0x05D, 0x0D7, 0x078, 0x0F2, 0x16C, 0x1E6, 0x032, 0x0B8, 0x126, 0x1AC, 0x103, 0x189, 0x017, 0x09D,
+  0x0A6, 0x02C, 0x1B2, 0x138, 0x197, 0x11D, 0x083, 0x009, 0x1DD, 0x157, 0x0C9, 0x043, 0x0EC, 0x066, 0x1F8, 0x172,
+  0x005, 0x08F, 0x111, 0x19B, 0x134, 0x1BE, 0x020, 0x0AA, 0x17E, 0x1F4, 0x06A, 0x0E0, 0x04F, 0x0C5, 0x15B, 0x1D1,
+  0x1EA, 0x160, 0x0FE, 0x074, 0x0DB, 0x051, 0x1CF, 0x145, 0x091, 0x01B, 0x185, 0x10F, 0x1A0, 0x12A, 0x0B4, 0x03E,
+  0x0C2, 0x048, 0x1D6, 0x15C, 0x1F3, 0x179, 0x0E7, 0x06D, 0x1B9, 0x133, 0x0AD, 0x027, 0x088, 0x002, 0x19C, 0x116,
+  0x12D, 0x1A7, 0x039, 0x0B3, 0x01C, 0x096, 0x108, 0x182, 0x056, 0x0DC, 0x142, 0x1C8, 0x167, 0x1ED, 0x073, 0x0F9,
+  0x18B, 0x101, 0x09F, 0x015, 0x0BA, 0x030, 0x1AE, 0x124, 0x0F0, 0x07A, 0x1E4, 0x16E, 0x1C1, 0x14B, 0x0D5, 0x05F,
+  0x064, 0x0EE, 0x170, 0x1FA, 0x155, 0x1DF, 0x041, 0x0CB, 0x11F, 0x195, 0x00B, 0x081, 0x02E, 0x0A4, 0x13A, 0x1B0,
+  0x14C, 0x1C6, 0x058, 0x0D2, 0x07D, 0x0F7, 0x169, 0x1E3, 0x037, 0x0BD, 0x123, 0x1A9, 0x106, 0x18C, 0x012, 0x098,
+  0x0A3, 0x029, 0x1B7, 0x13D, 0x192, 0x118, 0x086, 0x00C, 0x1D8, 0x152, 0x0CC, 0x046, 0x0E9, 0x063, 0x1FD, 0x177,
+};
+#endif
+
+#if (XCAN_DESC_CRC_SLICE >= 8)
+static const uint16_t XCAN_DESC_CRC9_TABLE4[256] =
+{
+  0x000, 0x00A, 0x014, 0x01E, 0x028, 0x022, 0x03C, 0x036, 0x050, 0x05A, 0x044, 0x04E, 0x078, 0x072, 0x06C, 0x066,
+  0x0A0, 0x0AA, 0x0B4, 0x0BE, 0x088, 0x082, 0x09C, 0x096, 0x0F0, 0x0FA, 0x0E4, 0x0EE, 0x0D8, 0x0D2, 0x0CC, 0x0C6,
+  0x140, 0x14A, 0x154, 0x15E, 0x168, 0x162, 0x17C, 0x176, 0x110, 0x11A, 0x104, 0x10E, 0x138, 0x132, 0x12C, 0x126,
+  0x1E0, 0x1EA, 0x1F4, 0x1FE, 0x1C8, 0x1C2, 0x1DC, 0x1D6, 0x1B0, 0x1BA, 0x1A4, 0x1AE, 0x198, 0x192, 0x18C, 0x186,
+  0x199, 0x193, 0x18D, 0x187, 0x1B1, 0x1BB, 0x1A5, 0x1AF, 0x1C9, 0x1C3, 0x1DD, 0x1D7, 0x1E1, 0x1EB, 0x1F5, 0x1FF,
+  0x139, 0x133, 0x12D, 0x127, 0x111, 0x11B, 0x105, 0x10F, 0x169, 0x163, 0x17D, 0x177, 0x141, 0x14B, 0x155, 0x15F,
+  0x0D9, 0x0D3, 0x0CD, 0x0C7, 0x0F1, 0x0FB, 0x0E5, 0x0EF, 0x089, 0x083, 0x09D, 0x097, 0x0A1, 0x0AB, 0x0B5, 0x0BF,
+  0x079, 0x073, 0x06D, 0x067, 0x051, 0x05B, 0x045, 0x04F, 0x029, 0x023, 0x03D, 0x037, 0x001, 0x00B, 0x015, 0x01F,
+  0x02B, 0x021, 0x03F, 0x035, 0x003, 0x009, 0x017, 0x01D, 0x07B, 0x071, 0x06F, 0x065, 0x053, 0x059, 0x047, 0x04D,
+  0x08B, 0x081, 0x09F, 0x095, 0x0A3, 0x0A9, 0x0B7, 0x0BD, 0x0DB, 0x0D1, 0x0CF, 0x0C5, 0x0F3, 0x0F9, 0x0E7, 0x0ED,
+  0x16B, 0x161, 0x17F, 0x175, 0x143, 0x149, 0x157, 0x15D, 0x13B, 0x131, 0x12F, 0x125, 0x113, 0x119, 0x107, 0x10D,
+  0x1CB, 0x1C1, 0x1DF, 0x1D5, 0x1E3, 0x1E9, 0x1F7, 0x1FD, 0x19B, 0x191, 0x18F, 0x185, 0x1B3, 0x1B9, 0x1A7, 0x1AD,
+  0x1B2, 0x1B8, 0x1A6, 0x1AC, 0x19A, 0x190, 0x18E, 0x184, 0x1E2, 0x1E8, 0x1F6, 0x1FC, 0x1CA, 0x1C0, 0x1DE, 0x1D4,
+  0x112, 0x118, 0x106, 0x10C, 0x13A, 0x130, 0x12E, 0x124, 0x142, 0x148, 0x156, 0x15C, 0x16A, 0x160, 0x17E, 0x174,
+  0x0F2, 0x0F8, 0x0E6, 0x0EC, 0x0DA, 0x0D0, 0x0CE, 0x0C4, 0x0A2, 0x0A8, 0x0B6, 0x0BC, 0x08A, 0x080, 0x09E, 0x094,
+  0x052, 0x058, 0x046, 0x04C, 0x07A, 0x070, 0x06E, 0x064, 0x002, 0x008, 0x016, 0x01C, 0x02A, 0x020, 0x03E, 0x034,
+};
+
+static const uint16_t XCAN_DESC_CRC9_TABLE5[256] =
+{
+  0x000, 0x056, 0x0AC, 0x0FA, 0x158, 0x10E, 0x1F4, 0x1A2, 0x1A9, 0x1FF, 0x105, 0x153, 0x0F1, 0x0A7, 0x05D, 0x00B,
+  0x04B, 0x01D, 0x0E7, 0x0B1, 0x113, 0x145, 0x1BF, 0x1E9, 0x1E2, 0x1B4, 0x14E, 0x118, 0x0BA, 0x0EC, 0x016, 0x040,
+  0x096, 0x0C0, 0x03A, 0x06C, 0x1CE, 0x198, 0x162, 0x134, 0x13F, 0x169, 0x193, 0x1C5, 0x067, 0x031, 0x0CB, 0x09D,
+  0x0DD, 0x08B, 0x071, 0x027, 0x185, 0x1D3, 0x129, 0x17F, 0x174, 0x122, 0x1D8, 0x18E, 0x02C, 0x07A, 0x080, 0x0D6,
+  0x12C, 0x17A, 0x180, 0x1D6, 0x074, 0x022, 0x0D8, 0x08E, 0x085, 0x0D3, 0x029, 0x07F, 0x1DD, 0x18B, 0x171, 0x127,
+  0x167, 0x131, 0x1CB, 0x19D, 0x03F, 0x069, 0x093, 0x0C5, 0x0CE, 0x098, 0x062, 0x034, 0x196, 0x1C0, 0x13A, 0x16C,
+  0x1BA, 0x1EC, 0x116, 0x140, 0x0E2, 0x0B4, 0x04E, 0x018, 0x013, 0x045, 0x0BF, 0x0E9, 0x14B, 0x11D, 0x1E7, 0x1B1,
+  0x1F1, 0x1A7, 0x15D, 0x10B, 0x0A9, 0x0FF, 0x005, 0x053, 0x058, 0x00E, 0x0F4, 0x0A2, 0x100, 0x156, 0x1AC, 0x1FA,
+  0x141, 0x117, 0x1ED, 0x1BB, 0x019, 0x04F, 0x0B5, 0x0E3, 0x0E8, 0x0BE, 0x044, 0x012, 0x1B0, 0x1E6, 0x11C, 0x14A,
+  0x10A, 0x15C, 0x1A6, 0x1F0, 0x052, 0x004, 0x0FE, 0x0A8, 0x0A3, 0x0F5, 0x00F, 0x059, 0x1FB, 0x1AD, 0x157, 0x101,
+  0x1D7, 0x181, 0x17B, 0x12D, 0x08F, 0x0D9, 0x023, 0x075, 0x07E, 0x028, 0x0D2, 0x084, 0x126, 0x170, 0x18A, 0x1DC,
+  0x19C, 0x1CA, 0x130, 0x166, 0x0C4, 0x092, 0x068, 0x03E, 0x035, 0x063, 0x099, 0x0CF, 0x16D, 0x13B, 0x1C1, 0x197,
+  0x06D, 0x03B, 0x0C1, 0x097, 0x135, 0x163, 0x199, 0x1CF, 0x1C4, 0x192, 0x168, 0x13E, 0x09C, 0x0CA, 0x030, 0x066,
+  0x026, 0x070, 0x08A, 0x0DC, 0x17E, 0x128, 0x1D2, 0x184, 0x18F, 0x1D9, 0x123, 0x175, 0x0D7, 0x081, 0x07B, 0x02D,
+  0x0FB, 0x0AD, 0x057, 0x001, 0x1A3, 0x1F5, 0x10F, 0x159, 0x152, 0x104, 0x1FE, 0x1A8, 0x00A, 0x05C, 0x0A6, 0x0F0,
+  0x0B0, 0x0E6, 0x01C, 0x04A, 0x1E8, 0x1BE, 0x144, 0x112, 0x119, 0x14F, 0x1B5, 0x1E3, 0x041, 0x017, 0x0ED, 0x0BB,
+};
+
+static const uint16_t XCAN_DESC_CRC9_TABLE6[256] =
+{
+  0x000, 0x19B, 0x02F, 0x1B4, 0x05E, 0x1C5, 0x071, 0x1EA, 0x0BC, 0x127, 0x093, 0x108, 0x0E2, 0x179, 0x0CD, 0x156,
+  0x178, 0x0E3, 0x157, 0x0CC, 0x126, 0x0BD, 0x109, 0x092, 0x1C4, 0x05F, 0x1EB, 0x070, 0x19A, 0x001, 0x1B5, 0x02E,
+  0x1E9, 0x072, 0x1C6, 0x05D, 0x1B7, 0x02C, 0x198, 0x003, 0x155, 0x0CE, 0x17A, 0x0E1, 0x10B, 0x090, 0x124, 0x0BF,
+  0x091, 0x10A, 0x0BE, 0x125, 0x0CF, 0x154, 0x0E0, 0x17B, 0x02D, 0x1B6, 0x002, 0x199, 0x073, 0x1E8, 0x05C, 0x1C7,
+  0x0CB, 0x150, 0x0E4, 0x17F, 0x095, 0x10E, 0x0BA, 0x121, 0x077, 0x1EC, 0x058, 0x1C3, 0x029, 0x1B2, 0x006, 0x19D,
+  0x1B3, 0x028, 0x19C, 0x007, 0x1ED, 0x076, 0x1C2, 0x059, 0x10F, 0x094, 0x120, 0x0BB, 0x151, 0x0CA, 0x17E, 0x0E5,
+  0x122, 0x0B9, 0x10D, 0x096, 0x17C, 0x0E7, 0x153, 0x0C8, 0x19E, 0x005, 0x1B1, 0x02A, 0x1C0, 0x05B, 0x1EF, 0x074,
+  0x05A, 0x1C1, 0x075, 0x1EE, 0x004, 0x19F, 0x02B, 0x1B0, 0x0E6, 0x17D, 0x0C9, 0x152, 0x0B8, 0x123, 0x097, 0x10C,
+  0x196, 0x00D, 0x1B9, 0x022, 0x1C8, 0x053, 0x1E7, 0x07C, 0x12A, 0x0B1, 0x105, 0x09E, 0x174, 0x0EF, 0x15B, 0x0C0,
+  0x0EE, 0x175, 0x0C1, 0x15A, 0x0B0, 0x12B, 0x09F, 0x104, 0x052, 0x1C9, 0x07D, 0x1E6, 0x00C, 0x197, 0x023, 0x1B8,
+  0x07F, 0x1E4, 0x050, 0x1CB, 0x021, 0x1BA, 0x00E, 0x195, 0x0C3, 0x158, 0x0EC, 0x177, 0x09D, 0x106, 0x0B2, 0x129,
+  0x107, 0x09C, 0x128, 0x0B3, 0x159, 0x0C2, 0x176, 0x0ED, 0x1BB, 0x020, 0x194, 0x00F, 0x1E5, 0x07E, 0x1CA, 0x051,
+  0x15D, 0x0C6, 0x172, 0x0E9, 0x103, 0x098, 0x12C, 0x0B7, 0x1E1, 0x07A, 0x1CE, 0x055, 0x1BF, 0x024, 0x190, 0x00B,
+  0x025, 0x1BE, 0x00A, 0x191, 0x07B, 0x1E0, 0x054, 0x1CF, 0x099, 0x102, 0x0B6, 0x12D, 0x0C7, 0x15C, 0x0E8, 0x173,
+  0x0B4, 0x12F, 0x09B, 0x100, 0x0EA, 0x171, 0x0C5, 0x15E, 0x008, 0x193, 0x027, 0x1BC, 0x056, 0x1CD, 0x079, 0x1E2,
+  0x1CC, 0x057, 0x1E3, 0x078, 0x192, 0x009, 0x1BD, 0x026, 0x170, 0x0EB, 0x15F, 0x0C4, 0x12E, 0x0B5, 0x101, 0x09A,
+};
+
+static const uint16_t XCAN_DESC_CRC9_TABLE7[256] =
+{
+  0x000, 0x035, 0x06A, 0x05F, 0x0D4, 0x0E1, 0x0BE, 0x08B, 0x1A8, 0x19D, 0x1C2, 0x1F7, 0x17C, 0x149, 0x116, 0x123,
+  0x049, 0x07C, 0x023, 0x016, 0x09D, 0x0A8, 0x0F7, 0x0C2, 0x1E1, 0x1D4, 0x18B, 0x1BE, 0x135, 0x100, 0x15F, 0x16A,
+  0x092, 0x0A7, 0x0F8, 0x0CD, 0x046, 0x073, 0x02C, 0x019, 0x13A, 0x10F, 0x150, 0x165, 0x1EE, 0x1DB, 0x184, 0x1B1,
+  0x0DB, 0x0EE, 0x0B1, 0x084, 0x00F, 0x03A, 0x065, 0x050, 0x173, 0x146, 0x119, 0x12C, 0x1A7, 0x192, 0x1CD, 0x1F8,
+  0x124, 0x111, 0x14E, 0x17B, 0x1F0, 0x1C5, 0x19A, 0x1AF, 0x08C, 0x0B9, 0x0E6, 0x0D3, 0x058, 0x06D, 0x032, 0x007,
+  0x16D, 0x158, 0x107, 0x132, 0x1B9, 0x18C, 0x1D3, 0x1E6, 0x0C5, 0x0F0, 0x0AF, 0x09A, 0x011, 0x024, 0x07B, 0x04E,
+  0x1B6, 0x183, 0x1DC, 0x1E9, 0x162, 0x157, 0x108, 0x13D, 0x01E, 0x02B, 0x074, 0x041, 0x0CA, 0x0FF, 0x0A0, 0x095,
+  0x1FF, 0x1CA, 0x195, 0x1A0, 0x12B, 0x11E, 0x141, 0x174, 0x057, 0x062, 0x03D, 0x008, 0x083, 0x0B6, 0x0E9, 0x0DC,
+  0x151, 0x164, 0x13B, 0x10E, 0x185, 0x1B0, 0x1EF, 0x1DA, 0x0F9, 0x0CC, 0x093, 0x0A6, 0x02D, 0x018, 0x047, 0x072,
+  0x118, 0x12D, 0x172, 0x147, 0x1CC, 0x1F9, 0x1A6, 0x193, 0x0B0, 0x085, 0x0DA, 0x0EF, 0x064, 0x051, 0x00E, 0x03B,
+  0x1C3, 0x1F6, 0x1A9, 0x19C, 0x117, 0x122, 0x17D, 0x148, 0x06B, 0x05E, 0x001, 0x034, 0x0BF, 0x08A, 0x0D5, 0x0E0,
+  0x18A, 0x1BF, 0x1E0, 0x1D5, 0x15E, 0x16B, 0x134, 0x101, 0x022, 0x017, 0x048, 0x07D, 0x0F6, 0x0C3, 0x09C, 0x0A9,
+  0x075, 0x040, 0x01F, 0x02A, 0x0A1, 0x094, 0x0CB, 0x0FE, 0x1DD, 0x1E8, 0x1B7, 0x182, 0x109, 0x13C, 0x163, 0x156,
+  0x03C, 0x009, 0x056, 0x063, 0x0E8, 0x0DD, 0x082, 0x0B7, 0x194, 0x1A1, 0x1FE, 0x1CB, 0x140, 0x175, 0x12A, 0x11F,
+  0x0E7, 0x0D2, 0x08D, 0x0B8, 0x033, 0x006, 0x059, 0x06C, 0x14F, 0x17A, 0x125, 0x110, 0x19B, 0x1AE, 0x1F1, 0x1C4,
+  0x0AE, 0x09B, 0x0C4, 0x0F1, 0x07A, 0x04F, 0x010, 0x025, 0x106, 0x133, 0x16C, 0x159, 0x1D2, 0x1E7, 0x1B8, 0x18D,
+};
+#endif
+
+#ifdef XCAN_DESC_CRC_CLMUL_AVAILABLE
+#define XCAN_DESC_CRC_CLMUL_MAX_WORDS  ( 8 ) //!< Maximum words processed by the carry-less multiply CRC
+
+//! Folding constants: x^(32p+9) mod P for a word at position p from the end of the descriptor
+static const uint64_t XCAN_DESC_CRC9_FOLD[XCAN_DESC_CRC_CLMUL_MAX_WORDS] = { 0x119, 0x00A, 0x1BB, 0x0E1, 0x0E3, 0x069, 0x05C, 0x199, };
+#define XCAN_DESC_CRC9_BARRETT_MU  ( 0xF86B7D3Dull )                        //!< Barrett constant floor(x^40 / P)
+#define XCAN_DESC_CRC9_FULL_POLY   ( 0x200ull | XCAN_DESC_CRC9_POLY )       //!< Polynomial with the x^9 term
+#endif
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// Compute the 9-bits CRC of a descriptor bit per bit
+//=============================================================================
+uint16_t XCAN_ComputeDescCRC9_Bitwise(const uint32_t* data, size_t count)
+{
+#ifdef CHECK_NULL_PARAM
+  if (data == NULL) return 0;
+#endif
+  uint32_t CRC = 0;
+  for (size_t zWord = 0; zWord < count; ++zWord)
+  {
+    const uint32_t Word = data[zWord];
+    for (int32_t zBit = 31; zBit >= 0; --zBit)
+    {
+      const uint32_t Feedback = ((CRC >> 8) ^ (Word >> zBit)) & 0x1u;                      // MSB of the CRC XOR the current message bit
+      CRC = (CRC << 1) & XCAN_DESC_CRC9_Mask;
+      if (Feedback > 0) CRC ^= XCAN_DESC_CRC9_POLY;
+    }
+  }
+  return (uint16_t)CRC;
+}
+
+
+
+#ifdef XCAN_DESC_CRC_CLMUL_AVAILABLE
+//=============================================================================
+// [STATIC] Carry-less multiply of two polynomials which product fits in 64-bits
+//=============================================================================
+static inline uint64_t __XCAN_CLMUL64(uint64_t a, uint64_t b)
+{
+#  if defined(__x86_64__)
+  return (uint64_t)_mm_cvtsi128_si64(_mm_clmulepi64_si128(_mm_cvtsi64_si128((long long)a), _mm_cvtsi64_si128((long long)b), 0x00));
+#  else
+  return vgetq_lane_u64(vreinterpretq_u64_p128(vmull_p64((poly64_t)a, (poly64_t)b)), 0);
+#  endif
+}
+
+
+
+//=============================================================================
+// [STATIC] Compute the 9-bits CRC of a descriptor with carry-less multiplies
+//=============================================================================
+static uint16_t __XCAN_ComputeDescCRC9_CLMUL(const uint32_t* data, size_t count)
+{
+  //--- Fold all words, each product is at most 40-bits ---
+  uint64_t Folded = 0;
+  for (size_t zWord = 0; zWord < count; ++zWord)
+    Folded ^= __XCAN_CLMUL64((uint64_t)data[zWord], XCAN_DESC_CRC9_FOLD[count - 1u - zWord]);
+
+  //--- Barrett reduction of the 40-bits remainder ---
+  const uint64_t Quotient = __XCAN_CLMUL64(Folded >> 9, XCAN_DESC_CRC9_BARRETT_MU) >> 31;
+  return (uint16_t)((Folded ^ __XCAN_CLMUL64(Quotient, XCAN_DESC_CRC9_FULL_POLY)) & XCAN_DESC_CRC9_Mask);
+}
+#endif
+
+
+
+//=============================================================================
+// Compute the 9-bits CRC of a descriptor
+//=============================================================================
+uint16_t XCAN_ComputeDescCRC9(const uint32_t* data, size_t count)
+{
+#ifdef CHECK_NULL_PARAM
+  if (data == NULL) return 0;
+#endif
+#ifdef XCAN_DESC_CRC_CLMUL_AVAILABLE
+  if (count <= XCAN_DESC_CRC_CLMUL_MAX_WORDS) return __XCAN_ComputeDescCRC9_CLMUL(data, count);
+#endif
+  uint32_t CRC = 0;
+  size_t zWord = 0;
+#if (XCAN_DESC_CRC_SLICE >= 8)
+  for (; (zWord + 1u) < count; zWord += 2)                                                 // Slice by 8: 2 words per step
+  {
+    const uint32_t Hi = data[zWord] ^ (CRC << 23);
+    const uint32_t Lo = data[zWord + 1u];
+    CRC = XCAN_DESC_CRC9_TABLE7[Hi >> 24] ^ XCAN_DESC_CRC9_TABLE6[(Hi >> 16) & 0xFF] ^ XCAN_DESC_CRC9_TABLE5[(Hi >> 8) & 0xFF] ^ XCAN_DESC_CRC9_TABLE4[Hi & 0xFF]
+        ^ XCAN_DESC_CRC9_TABLE3[Lo >> 24] ^ XCAN_DESC_CRC9_TABLE2[(Lo >> 16) & 0xFF] ^ XCAN_DESC_CRC9_TABLE1[(Lo >> 8) & 0xFF] ^ XCAN_DESC_CRC9_TABLE0[Lo & 0xFF];
+  }
+#endif
+#if (XCAN_DESC_CRC_SLICE >= 4)
+  for (; zWord < count; ++zWord)                                                           // Slice by 4: 1 word per step
+  {
+    const uint32_t Word = data[zWord] ^ (CRC << 23);
+    CRC = XCAN_DESC_CRC9_TABLE3[Word >> 24] ^ XCAN_DESC_CRC9_TABLE2[(Word >> 16) & 0xFF] ^ XCAN_DESC_CRC9_TABLE1[(Word >> 8) & 0xFF] ^ XCAN_DESC_CRC9_TABLE0[Word & 0xFF];
+  }
+#else
+  for (; zWord < count; ++zWord)                                                           // Slice by 1: 1 byte per step, MSB first
+  {
+    const uint32_t Word = data[zWord];
+    for (int32_t zShift = 24; zShift >= 0; zShift -= 8)
+      CRC = ((CRC << 8) & XCAN_DESC_CRC9_Mask) ^ XCAN_DESC_CRC9_TABLE0[((CRC >> 1) ^ (Word >> zShift)) & 0xFF];
+  }
+#endif
+  return (uint16_t)CRC;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
@@ -0,0 +1,104 @@
+/*!*****************************************************************************
+ * @file    XCAN_DescCRC.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN descriptors 9-bits CRC
+ * @details
+ * Compute the TIC1.CRC of the TX descriptors and the RIC1.CRC of the RX
+ *   descriptors when MH_SFTY_CTRL.TX_DESC_CRC_EN/RX_DESC_CRC_EN are set.
+ * The descriptor words are processed from the first word to the last, each
+ *   word from bit 31 to bit 0, without initial value nor final XOR.
+ * Both functions are compatible with the XCAN.fnComputeCRC9 interface.
+ * Configuration (in Conf_XCAN.h):
+ *   - XCAN_DESC_CRC9_POLY: CRC polynomial without the x^9 term (default 0x119)
+ *   - XCAN_DESC_CRC_SLICE: 1, 4 or 8 bytes processed per step (default 8)
+ *   - XCAN_DESC_CRC_USE_CLMUL: define it to use the carry-less multiply
+ *     instructions (x86-64 PCLMULQDQ or AArch64 PMULL) when available
+ ******************************************************************************/
+/* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#ifndef XCAN_DESCCRC_H_INC
+#define XCAN_DESCCRC_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include "XCAN_core.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+  extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+//! CRC9 polynomial of the descriptors without the x^9 term. Can be overridden in Conf_XCAN.h, the lookup tables are generated for 0x119 (x^9 + x^8 + x^4 + x^3 + 1)
+#ifndef XCAN_DESC_CRC9_POLY
+#  define XCAN_DESC_CRC9_POLY  ( 0x119u )
+#endif
+
+//! Count of bytes processed per step by the table driven CRC (1, 4 or 8). Can be overridden in Conf_XCAN.h to reduce the tables size (512 bytes per byte sliced)
+#ifndef XCAN_DESC_CRC_SLICE
+#  define XCAN_DESC_CRC_SLICE  ( 8 )
+#endif
+
+#define XCAN_DESC_CRC9_Mask  ( 0x1FFu ) //!< CRC9 value mask
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// XCAN descriptors CRC
+//********************************************************************************************************************
+
+/*! @brief Compute the 9-bits CRC of a descriptor bit per bit
+ *
+ * This is the reference implementation, slow but without any table
+ * @param[in] *data Is the descriptor words to process, the CRC bit field of the first word shall be set to 0
+ * @param[in] count Is the count of words to process (8 for TX descriptors, 4 for RX descriptors)
+ * @return The computed 9-bits CRC
+ */
+uint16_t XCAN_ComputeDescCRC9_Bitwise(const uint32_t* data, size_t count);
+
+/*! @brief Compute the 9-bits CRC of a descriptor
+ *
+ * Use the carry-less multiply instructions if XCAN_DESC_CRC_USE_CLMUL is defined and available, else the lookup tables sliced by XCAN_DESC_CRC_SLICE bytes
+ * @param[in] *data Is the descriptor words to process, the CRC bit field of the first word shall be set to 0
+ * @param[in] count Is the count of words to process (8 for TX descriptors, 4 for RX descriptors)
+ * @return The computed 9-bits CRC
+ */
+uint16_t XCAN_ComputeDescCRC9(const uint32_t* data, size_t count);
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* XCAN_DESCCRC_H_INC */
@@ -0,0 +1,401 @@
+/*!*****************************************************************************
+ * @file    XCAN_FilterCompiler.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN RX filter elements table compiler
+ * @details
+ * All the subscriptions are converted to ranges or masks in the work memory,
+ *   sorted and merged in place, then written as filter elements
+ ******************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "XCAN_FilterCompiler.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define XCAN_RX_FILTER_GROUP_COUNT             ( 4u * XCAN_FIFO_QUEUE_COUNT )                   //!< Count of groups: each RX FIFO Queue with standard and extended IDs, accepted and black listed
+#define XCAN_RX_FILTER_GROUP_IS_EXTENDED(grp)  ( (((grp) / XCAN_FIFO_QUEUE_COUNT) & 1u) > 0 )   //!< The group is for extended IDs
+#define XCAN_RX_FILTER_GROUP_IS_BLACKLIST(grp) ( (grp) >= (2u * XCAN_FIFO_QUEUE_COUNT) )        //!< The group is a black list
+#define XCAN_RX_FILTER_GROUP_QUEUE(grp)        ( (grp) % XCAN_FIFO_QUEUE_COUNT )                //!< RX FIFO Queue of the group
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// [STATIC] Compare 2 work entries: ranges before masks, then by group and first ID
+//=============================================================================
+static int __XCAN_CompareRxFilterByGroup(const void* pA, const void* pB)
+{
+  const XCAN_RxFilterRange* pRangeA = (const XCAN_RxFilterRange*)pA;
+  const XCAN_RxFilterRange* pRangeB = (const XCAN_RxFilterRange*)pB;
+  if (pRangeA->IsMask != pRangeB->IsMask) return (pRangeA->IsMask ? 1 : -1);
+  if (pRangeA->Group  != pRangeB->Group ) return (pRangeA->Group < pRangeB->Group ? -1 : 1);
+  if (pRangeA->First  != pRangeB->First ) return (pRangeA->First < pRangeB->First ? -1 : 1);
+  if (pRangeA->Last   != pRangeB->Last  ) return (pRangeA->Last  < pRangeB->Last  ? -1 : 1);
+  return 0;
+}
+
+
+
+//=============================================================================
+// [STATIC] Compare 2 ranges: by ID type, black list first, then by first ID
+//=============================================================================
+static int __XCAN_CompareRxFilterByID(const void* pA, const void* pB)
+{
+  const XCAN_RxFilterRange* pRangeA = (const XCAN_RxFilterRange*)pA;
+  const XCAN_RxFilterRange* pRangeB = (const XCAN_RxFilterRange*)pB;
+  const bool ExtendedA  = XCAN_RX_FILTER_GROUP_IS_EXTENDED(pRangeA->Group);
+  const bool ExtendedB  = XCAN_RX_FILTER_GROUP_IS_EXTENDED(pRangeB->Group);
+  const bool BlackListA = XCAN_RX_FILTER_GROUP_IS_BLACKLIST(pRangeA->Group);
+  const bool BlackListB = XCAN_RX_FILTER_GROUP_IS_BLACKLIST(pRangeB->Group);
+  if (ExtendedA  != ExtendedB ) return (ExtendedB ? -1 : 1);
+  if (BlackListA != BlackListB) return (BlackListA ? -1 : 1);
+  if (pRangeA->First != pRangeB->First) return (pRangeA->First < pRangeB->First ? -1 : 1);
+  return 0;
+}
+
+
+
+//=============================================================================
+// [STATIC] Is a range accepted by a mask
+//=============================================================================
+static bool __XCAN_MaskCoversRange(const XCAN_RxFilterRange* pMask, const XCAN_RxFilterRange* pRange)
+{
+  if ((pRange->First & pMask->Last) != pMask->First) return false;
+  uint32_t Diff = pRange->First ^ pRange->Last;                                            // All the IDs of the range share the bits over the highest different bit
+  uint32_t LowBits = 0;
+  while (Diff != 0) { LowBits = (LowBits << 1) | 1u; Diff >>= 1; }
+  return ((pMask->Last & LowBits) == 0);
+}
+
+
+
+//=============================================================================
+// [STATIC] Are 2 work entries of the same ID type and black list class
+//=============================================================================
+static inline bool __XCAN_IsSameRxFilterClass(const XCAN_RxFilterRange* pA, const XCAN_RxFilterRange* pB)
+{
+  return (XCAN_RX_FILTER_GROUP_IS_EXTENDED(pA->Group) == XCAN_RX_FILTER_GROUP_IS_EXTENDED(pB->Group))
+      && (XCAN_RX_FILTER_GROUP_IS_BLACKLIST(pA->Group) == XCAN_RX_FILTER_GROUP_IS_BLACKLIST(pB->Group));
+}
+
+
+
+//=============================================================================
+// [STATIC] Are 2 work entries of different RX FIFO Queues with the same ID type and black list class
+//=============================================================================
+static inline bool __XCAN_IsOtherRxFilterQueue(const XCAN_RxFilterRange* pA, const XCAN_RxFilterRange* pB)
+{
+  return (pA->Group != pB->Group) && __XCAN_IsSameRxFilterClass(pA, pB);
+}
+
+
+
+//=============================================================================
+// [STATIC] Does a mask accept an ID between first and last
+//=============================================================================
+static bool __XCAN_MaskMatchesRange(const XCAN_RxFilterRange* pMask, uint32_t first, uint32_t last)
+{
+  const uint32_t Value = pMask->First, Mask = pMask->Last;
+  const uint32_t Diff = (first ^ Value) & Mask;                                            // Checked bits of first that are not the ones of the mask
+  if (Diff == 0) return true;
+  uint32_t High = Diff;                                                                    // Highest checked bit to change
+  while ((High & (High - 1u)) != 0) High &= (High - 1u);
+
+  //--- Lowest ID over first accepted by the mask ---
+  uint32_t Bit = High;                                                                     // Bit set to get over first, the bits under it are the lowest possible
+  if ((Value & High) == 0)                                                                 // The bit shall be cleared: carry in the lowest free bit over it that is cleared in first
+  {
+    const uint32_t FreeCleared = ~first & ~Mask & ~((High << 1) - 1u);
+    if (FreeCleared == 0) return false;
+    Bit = FreeCleared & (~FreeCleared + 1u);
+  }
+  const uint32_t LowBits = (Bit << 1) - 1u;
+  const uint32_t Lowest  = (first & ~LowBits) | Bit | (Value & (LowBits >> 1));
+  return (Lowest <= last);
+}
+
+
+
+//=============================================================================
+// [STATIC] Can a mask accept an ID between first and last, estimated with the lowest and highest IDs of the mask
+//=============================================================================
+static bool __XCAN_MaskMayMatchRange(const XCAN_RxFilterRange* pMask, uint32_t first, uint32_t last)
+{
+  const uint32_t IDMax   = (XCAN_RX_FILTER_GROUP_IS_EXTENDED(pMask->Group) ? XCAN_RX_FILTER_EID_MAX : XCAN_RX_FILTER_SID_MAX);
+  const uint32_t MaskMin = pMask->First;
+  const uint32_t MaskMax = MaskMin | (~pMask->Last & IDMax);
+  return (MaskMin <= last) && (first <= MaskMax);
+}
+
+
+
+//=============================================================================
+// [STATIC] Set an RX filter element
+//=============================================================================
+static void __XCAN_SetRxFilterElement(XCAN_RxFilterElement* pElement, eXCAN_RxFilterType type, uint8_t group, uint32_t id1, uint32_t id2)
+{
+  pElement->Type      = type;
+  pElement->Extended  = XCAN_RX_FILTER_GROUP_IS_EXTENDED(group);
+  pElement->BlackList = XCAN_RX_FILTER_GROUP_IS_BLACKLIST(group);
+  pElement->ID1       = id1;
+  pElement->ID2       = id2;
+  pElement->Queue     = (eXCAN_FIFOQueue)XCAN_RX_FILTER_GROUP_QUEUE(group);
+}
+
+
+
+//=============================================================================
+// [STATIC] Count the filter elements needed by the ranges and the masks
+//=============================================================================
+static size_t __XCAN_CountRxFilterElements(const XCAN_RxFilterRange* pRanges, size_t rangeCount, size_t maskCount)
+{
+  uint16_t Singles[XCAN_RX_FILTER_GROUP_COUNT] = { 0 };
+  size_t Count = maskCount;
+  for (size_t zRange = 0; zRange < rangeCount; ++zRange)
+  {
+    if (pRanges[zRange].First == pRanges[zRange].Last) Singles[pRanges[zRange].Group]++;
+    else ++Count;
+  }
+  for (size_t zGroup = 0; zGroup < XCAN_RX_FILTER_GROUP_COUNT; ++zGroup) Count += (Singles[zGroup] + 1u) / 2u; // The single IDs of a group are packed by 2
+  return Count;
+}
+
+
+
+//=============================================================================
+// [STATIC] Convert the subscriptions in ranges and masks
+//=============================================================================
+static eERRORRESULT __XCAN_ConvertRxSubscriptions(const XCAN_RxFilterCompilerConfig* pConf)
+{
+  for (size_t zSub = 0; zSub < pConf->SubscriptionCount; ++zSub)
+  {
+    const XCAN_RxSubscription* pSub = &pConf->Subscriptions[zSub];
+    XCAN_RxFilterRange* pRange = &pConf->Work[zSub];
+    const uint32_t IDMax = (pSub->Extended ? XCAN_RX_FILTER_EID_MAX : XCAN_RX_FILTER_SID_MAX);
+    if (pSub->Queue >= XCAN_FIFO_QUEUE_COUNT) return ERR__PARAMETER_ERROR;
+    if (pSub->ID1 > IDMax) return ERR__OUT_OF_RANGE;
+    pRange->Group  = (uint8_t)pSub->Queue + (pSub->Extended ? XCAN_FIFO_QUEUE_COUNT : 0u) + (pSub->BlackList ? (2u * XCAN_FIFO_QUEUE_COUNT) : 0u);
+    pRange->IsMask = false;
+    switch (pSub->Type)
+    {
+      case XCAN_RX_FILTER_EXACT:
+        pRange->First = pSub->ID1;
+        pRange->Last  = pSub->ID1;
+        break;
+      case XCAN_RX_FILTER_RANGE:
+        if ((pSub->ID2 > IDMax) || (pSub->ID2 < pSub->ID1)) return ERR__OUT_OF_RANGE;
+        pRange->First = pSub->ID1;
+        pRange->Last  = pSub->ID2;
+        break;
+      case XCAN_RX_FILTER_MASK:
+      {
+        const uint32_t Mask = pSub->ID2 & IDMax;
+        const uint32_t Free = ~Mask & IDMax;                                               // Bits of the ID not checked
+        pRange->First = pSub->ID1 & Mask;
+        if ((Free & (Free + 1u)) == 0) pRange->Last = pRange->First | Free;                // Only low bits are free: the mask is a range
+        else { pRange->Last = Mask; pRange->IsMask = true; }
+        break;
+      }
+      default: return ERR__PARAMETER_ERROR;
+    }
+  }
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Compile subscriptions in an RX filter elements table
+//=============================================================================
+eERRORRESULT XCAN_CompileRxFilters(const XCAN_RxFilterCompilerConfig* pConf, XCAN_RxFilterElement* pElements, size_t maxElements, size_t* pElementCount, uint32_t* pExtraIDs)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pConf == NULL) || (pElements == NULL) || (pElementCount == NULL)) return ERR__PARAMETER_ERROR;
+  if (((pConf->Subscriptions == NULL) || (pConf->Work == NULL)) && (pConf->SubscriptionCount > 0)) return ERR__PARAMETER_ERROR;
+#endif
+  XCAN_RxFilterRange* pWork = pConf->Work;
+  if (maxElements > XCAN_RX_FILTER_MAX_ELEMENTS) maxElements = XCAN_RX_FILTER_MAX_ELEMENTS;
+  eERRORRESULT Error = __XCAN_ConvertRxSubscriptions(pConf);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling __XCAN_ConvertRxSubscriptions() then return the error
+  if (pConf->SubscriptionCount > 0) qsort(pWork, pConf->SubscriptionCount, sizeof(XCAN_RxFilterRange), __XCAN_CompareRxFilterByGroup);
+
+  //--- Remove the duplicated masks ---
+  size_t RangeCount = 0;
+  while ((RangeCount < pConf->SubscriptionCount) && (pWork[RangeCount].IsMask == false)) ++RangeCount;
+  size_t MaskCount = 0;
+  for (size_t zMask = RangeCount; zMask < pConf->SubscriptionCount; ++zMask)
+  {
+    if ((MaskCount > 0) && (__XCAN_CompareRxFilterByGroup(&pWork[RangeCount + MaskCount - 1u], &pWork[zMask]) == 0)) continue;
+    pWork[RangeCount + MaskCount] = pWork[zMask];
+    ++MaskCount;
+  }
+  const XCAN_RxFilterRange* pMasks = &pWork[RangeCount];
+
+  //--- Merge the ranges of each group, remove the ones accepted by a mask of the group ---
+  size_t Count = 0;
+  for (size_t zRange = 0; zRange < RangeCount; ++zRange)
+  {
+    const XCAN_RxFilterRange* pRange = &pWork[zRange];
+    bool Covered = false;
+    for (size_t zMask = 0; (zMask < MaskCount) && (Covered == false); ++zMask)
+      Covered = (pMasks[zMask].Group == pRange->Group) && __XCAN_MaskCoversRange(&pMasks[zMask], pRange);
+    if (Covered) continue;
+    XCAN_RxFilterRange* pPrevious = (Count > 0 ? &pWork[Count - 1u] : NULL);
+    if ((pPrevious != NULL) && (pPrevious->Group == pRange->Group) && (pRange->First <= (pPrevious->Last + 1u))) // Overlapping or adjacent
+    {
+      if (pRange->Last > pPrevious->Last) pPrevious->Last = pRange->Last;
+      continue;
+    }
+    pWork[Count++] = *pRange;
+  }
+  if (Count < RangeCount)                                                                  // Move the masks after the remaining ranges
+    for (size_t zMask = 0; zMask < MaskCount; ++zMask) pWork[Count + zMask] = pWork[RangeCount + zMask];
+  RangeCount = Count;
+  pMasks = &pWork[RangeCount];
+
+  //--- Check that an ID is not subscribed on 2 RX FIFO Queues (a black list can overlap the accepted IDs) ---
+  if (RangeCount > 0) qsort(pWork, RangeCount, sizeof(XCAN_RxFilterRange), __XCAN_CompareRxFilterByID);
+  for (size_t zRange = 1; zRange < RangeCount; ++zRange)
+  {
+    if (__XCAN_IsSameRxFilterClass(&pWork[zRange - 1u], &pWork[zRange]) == false) continue;
+    if (pWork[zRange].First <= pWork[zRange - 1u].Last) return ERR__CONFIGURATION;         // The ranges of a group are disjoint, so the overlap is between 2 RX FIFO Queues
+  }
+  for (size_t zMask = 0; zMask < MaskCount; ++zMask)
+  {
+    const XCAN_RxFilterRange* pMask = &pMasks[zMask];
+    for (size_t zRange = 0; zRange < RangeCount; ++zRange)
+      if (__XCAN_IsOtherRxFilterQueue(pMask, &pWork[zRange]) && __XCAN_MaskMatchesRange(pMask, pWork[zRange].First, pWork[zRange].Last)) return ERR__CONFIGURATION;
+    for (size_t zOther = zMask + 1u; zOther < MaskCount; ++zOther)
+      if (__XCAN_IsOtherRxFilterQueue(pMask, &pMasks[zOther]) && (((pMask->First ^ pMasks[zOther].First) & pMask->Last & pMasks[zOther].Last) == 0)) return ERR__CONFIGURATION;
+  }
+
+  //--- Merge the closest ranges of a group until the table fits ---
+  size_t ElementCount = __XCAN_CountRxFilterElements(pWork, RangeCount, MaskCount);
+  uint32_t ExtraIDs = 0;
+  while (ElementCount > maxElements)
+  {
+    size_t Best = RangeCount;
+    uint32_t BestGap = UINT32_MAX;
+    for (size_t zRange = 1; zRange < RangeCount; ++zRange)                                 // Only consecutive ranges can be merged, no range of another RX FIFO Queue is between them
+    {
+      if (pWork[zRange - 1u].Group != pWork[zRange].Group) continue;
+      const uint32_t GapFirst = pWork[zRange - 1u].Last + 1u, GapLast = pWork[zRange].First - 1u;
+      const uint32_t Gap = GapLast - GapFirst + 1u;
+      if ((Gap >= BestGap) || (Gap > (pConf->MaxExtraIDs - ExtraIDs))) continue;
+      bool Shared = false;                                                                 // An ID of the gap can be accepted by a mask of another RX FIFO Queue
+      for (size_t zMask = 0; (zMask < MaskCount) && (Shared == false); ++zMask)
+        Shared = __XCAN_IsOtherRxFilterQueue(&pMasks[zMask], &pWork[zRange]) && __XCAN_MaskMayMatchRange(&pMasks[zMask], GapFirst, GapLast);
+      if (XCAN_RX_FILTER_GROUP_IS_BLACKLIST(pWork[zRange].Group))                          // A black list gap shall not cover an accepted ID
+      {
+        const bool Extended = XCAN_RX_FILTER_GROUP_IS_EXTENDED(pWork[zRange].Group);
+        for (size_t zEntry = 0; (zEntry < (RangeCount + MaskCount)) && (Shared == false); ++zEntry)
+        {
+          const XCAN_RxFilterRange* pEntry = &pWork[zEntry];
+          if (XCAN_RX_FILTER_GROUP_IS_BLACKLIST(pEntry->Group) || (XCAN_RX_FILTER_GROUP_IS_EXTENDED(pEntry->Group) != Extended)) continue;
+          Shared = (pEntry->IsMask ? __XCAN_MaskMayMatchRange(pEntry, GapFirst, GapLast) : ((pEntry->First <= GapLast) && (GapFirst <= pEntry->Last)));
+        }
+      }
+      if (Shared == false) { Best = zRange; BestGap = Gap; }
+    }
+    if (Best == RangeCount) break;                                                         // No more merge allowed
+    pWork[Best - 1u].Last = pWork[Best].Last;
+    for (size_t zRange = Best + 1u; zRange < (RangeCount + MaskCount); ++zRange) pWork[zRange - 1u] = pWork[zRange];
+    --RangeCount;
+    pMasks = &pWork[RangeCount];
+    ExtraIDs += BestGap;
+    ElementCount = __XCAN_CountRxFilterElements(pWork, RangeCount, MaskCount);
+  }
+  *pElementCount = ElementCount;
+  if (pExtraIDs != NULL) *pExtraIDs = ExtraIDs;
+  if (ElementCount > maxElements) return ERR__BUFFER_FULL;
+
+  //--- Write the filter elements, black list first ---
+  int16_t Pending[XCAN_RX_FILTER_GROUP_COUNT];                                             // Element of each group with a single ID waiting for a second one
+  for (size_t zGroup = 0; zGroup < XCAN_RX_FILTER_GROUP_COUNT; ++zGroup) Pending[zGroup] = -1;
+  size_t Index = 0;
+  for (size_t zPass = 0; zPass < 2u; ++zPass)
+  {
+    const bool BlackList = (zPass == 0);
+    for (size_t zRange = 0; zRange < RangeCount; ++zRange)
+    {
+      const XCAN_RxFilterRange* pRange = &pWork[zRange];
+      if (XCAN_RX_FILTER_GROUP_IS_BLACKLIST(pRange->Group) != BlackList) continue;
+      if (pRange->First != pRange->Last)
+      {
+        __XCAN_SetRxFilterElement(&pElements[Index], XCAN_RX_FILTER_RANGE, pRange->Group, pRange->First, pRange->Last);
+        ++Index;
+      }
+      else if (Pending[pRange->Group] >= 0)                                                // Second single ID of the group
+      {
+        XCAN_RxFilterElement* pDual = &pElements[Pending[pRange->Group]];
+        pDual->Type = XCAN_RX_FILTER_DUAL;
+        pDual->ID2  = pRange->First;
+        Pending[pRange->Group] = -1;
+      }
+      else
+      {
+        __XCAN_SetRxFilterElement(&pElements[Index], XCAN_RX_FILTER_EXACT, pRange->Group, pRange->First, pRange->First);
+        Pending[pRange->Group] = (int16_t)Index;
+        ++Index;
+      }
+    }
+    for (size_t zMask = 0; zMask < MaskCount; ++zMask)
+    {
+      const XCAN_RxFilterRange* pMask = &pMasks[zMask];
+      if (XCAN_RX_FILTER_GROUP_IS_BLACKLIST(pMask->Group) != BlackList) continue;
+      __XCAN_SetRxFilterElement(&pElements[Index], XCAN_RX_FILTER_MASK, pMask->Group, pMask->First, pMask->Last);
+      ++Index;
+    }
+  }
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Find the RX filter element that matches a message ID, as the X_CAN does
+//=============================================================================
+eERRORRESULT XCAN_MatchRxFilters(const XCAN_RxFilterElement* pElements, size_t count, bool extended, uint32_t id, uint8_t* pIndex)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pElements == NULL) || (pIndex == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (count > XCAN_RX_FILTER_MAX_ELEMENTS) count = XCAN_RX_FILTER_MAX_ELEMENTS;
+  for (size_t zElt = 0; zElt < count; ++zElt)
+  {
+    if (pElements[zElt].Extended != extended) continue;
+    const uint32_t ID1 = pElements[zElt].ID1;
+    const uint32_t ID2 = pElements[zElt].ID2;
+    bool Match;
+    switch (pElements[zElt].Type)
+    {
+      case XCAN_RX_FILTER_EXACT: Match = (id == ID1); break;
+      case XCAN_RX_FILTER_DUAL : Match = (id == ID1) || (id == ID2); break;
+      case XCAN_RX_FILTER_RANGE: Match = (id >= ID1) && (id <= ID2); break;
+      default                  : Match = ((id & ID2) == (ID1 & ID2)); break;
+    }
+    if (Match) { *pIndex = (uint8_t)zElt; return ERR_OK; }
+  }
+  return ERR__NO_DATA_AVAILABLE;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
@@ -0,0 +1,168 @@
+/*!*****************************************************************************
+ * @file    XCAN_FilterCompiler.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN RX filter elements table compiler
+ * @details
+ * Build the smallest RX filter elements table for L_MEM from a list of
+ *   subscriptions (exact IDs, ID ranges, ID/mask pairs), each one with the RX
+ *   FIFO Queue of its messages. The X_CAN evaluates the filter elements one
+ *   by one, so the filtering time of a message grows with NB_FE.
+ * The compiler:
+ *   - turns the exact IDs and the masks of contiguous low bits into ranges
+ *   - removes the ranges already accepted by a mask of the same RX FIFO Queue
+ *   - merges the overlapping and adjacent ranges of the same RX FIFO Queue
+ *   - packs the remaining single IDs of an RX FIFO Queue by 2 (DUAL elements)
+ *   - optionally merges the closest ranges of an RX FIFO Queue when the table
+ *     does not fit, accepting a bounded count of IDs not subscribed (to be
+ *     rejected by the application). A gap that a mask of another RX FIFO
+ *     Queue can accept is never merged, and a black list gap never covers an
+ *     accepted ID
+ * The black list elements are placed first, then the ranges and IDs elements
+ *   and the masks elements last, the X_CAN stops at the first element that
+ *   matches. A black list subscription can overlap the accepted IDs, it takes
+ *   precedence over them
+ * The elements produced are a model of the filter elements (type, IDs, black
+ *   list, RX FIFO Queue), not the layout of the filter elements in L_MEM. The
+ *   application converts them to the layout of the X_CAN MH user manual
+ *   before writing them in L_MEM
+ ******************************************************************************/
+/* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#ifndef XCAN_FILTERCOMPILER_H_INC
+#define XCAN_FILTERCOMPILER_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include "XCAN.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+  extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define XCAN_RX_FILTER_SID_MAX  ( 0x7FFu )      //!< Maximum standard ID
+#define XCAN_RX_FILTER_EID_MAX  ( 0x1FFFFFFFu ) //!< Maximum extended ID
+
+//-----------------------------------------------------------------------------
+
+//! RX filter element types
+typedef enum
+{
+  XCAN_RX_FILTER_EXACT = 0, //!< The ID is equal to ID1
+  XCAN_RX_FILTER_DUAL  = 1, //!< The ID is equal to ID1 or ID2
+  XCAN_RX_FILTER_RANGE = 2, //!< The ID is between ID1 and ID2 (included)
+  XCAN_RX_FILTER_MASK  = 3, //!< The ID bits set in the mask ID2 are equal to the ones of ID1
+} eXCAN_RxFilterType;
+
+//! RX filter element model (not the layout of the filter elements in L_MEM)
+typedef struct XCAN_RxFilterElement
+{
+  eXCAN_RxFilterType Type; //!< Type of the element
+  bool Extended;           //!< 'true' for 29-bits extended IDs, 'false' for 11-bits standard IDs
+  bool BlackList;          //!< The messages that match are black listed (R1.BLK = 1)
+  uint32_t ID1;            //!< First identifier (right aligned)
+  uint32_t ID2;            //!< Second identifier, last identifier of the range or mask, not used with XCAN_RX_FILTER_EXACT
+  eXCAN_FIFOQueue Queue;   //!< RX FIFO Queue where the messages are stored
+} XCAN_RxFilterElement;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// XCAN RX Filter compiler
+//********************************************************************************************************************
+
+//! RX subscription structure
+typedef struct XCAN_RxSubscription
+{
+  eXCAN_RxFilterType Type; //!< XCAN_RX_FILTER_EXACT (ID1), XCAN_RX_FILTER_RANGE (ID1 to ID2) or XCAN_RX_FILTER_MASK (ID1 with the mask ID2). XCAN_RX_FILTER_DUAL is not accepted, use 2 exact subscriptions
+  bool Extended;           //!< 'true' for 29-bits extended IDs, 'false' for 11-bits standard IDs
+  bool BlackList;          //!< 'true' to black list the messages of the subscription (R1.BLK = 1), takes precedence over the other subscriptions
+  uint32_t ID1;            //!< Identifier (right aligned)
+  uint32_t ID2;            //!< Last identifier of the range or mask, not used with XCAN_RX_FILTER_EXACT
+  eXCAN_FIFOQueue Queue;   //!< RX FIFO Queue where the messages are stored
+} XCAN_RxSubscription;
+
+//! RX filter compiler work entry (Managed by the compiler)
+typedef struct XCAN_RxFilterRange
+{
+  uint32_t First; //!< First ID of the range, or ID of a mask
+  uint32_t Last;  //!< Last ID of the range, or mask
+  uint8_t Group;  //!< RX FIFO Queue of the range, plus XCAN_FIFO_QUEUE_COUNT for extended IDs, plus 2*XCAN_FIFO_QUEUE_COUNT for black list
+  bool IsMask;    //!< The entry is a mask
+} XCAN_RxFilterRange;
+
+//! RX filter compiler configuration structure
+typedef struct XCAN_RxFilterCompilerConfig
+{
+  const XCAN_RxSubscription* Subscriptions; //!< Subscriptions to compile
+  size_t SubscriptionCount;                 //!< Count of subscriptions
+  XCAN_RxFilterRange* Work;                 //!< Work memory of the compiler, SubscriptionCount elements
+  uint32_t MaxExtraIDs;                     //!< Maximum count of IDs not subscribed that can be accepted to fit the table in maxElements. 0 to get an exact table
+} XCAN_RxFilterCompilerConfig;
+
+//-----------------------------------------------------------------------------
+
+
+
+/*! @brief Compile subscriptions in an RX filter elements table
+ *
+ * The table is converted to the L_MEM layout by the application, then configured with XCAN_ConfigureRxFilters()
+ * @param[in] *pConf Is the compiler configuration
+ * @param[out] *pElements Is the RX filter elements table
+ * @param[in] maxElements Is the count of elements of the pElements array (up to XCAN_RX_FILTER_MAX_ELEMENTS are used)
+ * @param[out] *pElementCount Is where the count of elements of the table will be stored, or the count needed if the table does not fit
+ * @param[out] *pExtraIDs Is where the count of IDs not subscribed added by the merges of ranges will be stored (some of them can already be accepted by a mask). Can be NULL
+ * @return Returns an #eERRORRESULT value enum, ERR__CONFIGURATION if an ID is subscribed (or black listed) on 2 RX FIFO Queues, ERR__BUFFER_FULL if the table does not fit
+ */
+eERRORRESULT XCAN_CompileRxFilters(const XCAN_RxFilterCompilerConfig* pConf, XCAN_RxFilterElement* pElements, size_t maxElements, size_t* pElementCount, uint32_t* pExtraIDs);
+
+/*! @brief Find the RX filter element that matches a message ID, as the X_CAN does
+ *
+ * Give the FIDX that will be reported in R1 for this ID, to configure the subscribers of a dispatcher for example
+ * @param[in] *pElements Is the RX filter elements table
+ * @param[in] count Is the count of elements of the table
+ * @param[in] extended Is 'true' for an extended ID
+ * @param[in] id Is the message ID (right aligned)
+ * @param[out] *pIndex Is where the index of the first element that matches will be stored
+ * @return Returns an #eERRORRESULT value enum, ERR__NO_DATA_AVAILABLE if no element matches
+ */
+eERRORRESULT XCAN_MatchRxFilters(const XCAN_RxFilterElement* pElements, size_t count, bool extended, uint32_t id, uint8_t* pIndex);
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* XCAN_FILTERCOMPILER_H_INC */
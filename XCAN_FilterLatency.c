@@ -0,0 +1,141 @@
+/*!*****************************************************************************
+ * @file    XCAN_FilterLatency.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN RX filtering latency model and threshold tuner
+ * @details
+ * A word of the RX DMA FIFO is received in 32 bits time at the data bitrate,
+ *   the stuff bits are not counted so that the estimation stays on the safe side
+ ******************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "XCAN_FilterLatency.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define XCAN_BITS_PER_WORD  ( 32ull )          //!< Bits of an RX DMA FIFO word
+#define XCAN_NS_PER_SECOND  ( 1000000000ull )  //!< Nanoseconds in a second
+#define XCAN_PPM_PER_UNIT   ( 1000000ull )     //!< Parts per million in a unit
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// Estimate the worst case RX filtering latency of a filter elements table and recommend the threshold
+//=============================================================================
+eERRORRESULT XCAN_RecommendRxFilterThreshold(const XCAN_FilterLatencyConfig* pConf, const XCAN_RxFilterElement* pElements, size_t count, XCAN_FilterLatencyResult* pResult)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pConf == NULL) || (pResult == NULL) || ((pElements == NULL) && (count > 0))) return ERR__PARAMETER_ERROR;
+#endif
+  if ((pConf->MHClockHz == 0) || (pConf->DataBitrate == 0)) return ERR__PARAMETER_ERROR;
+  if (count > XCAN_RX_FILTER_MAX_ELEMENTS) return ERR__OUT_OF_RANGE;
+
+  //--- Worst case: no element matches ---
+  uint64_t Cycles = pConf->FixedCycles;
+  uint16_t SlowestCycles = 0;
+  for (size_t zType = 0; zType < XCAN_RX_FILTER_TYPE_COUNT; ++zType)
+    if (pConf->ElementCycles[zType] > SlowestCycles) SlowestCycles = pConf->ElementCycles[zType];
+  for (size_t zElt = 0; zElt < count; ++zElt)
+  {
+    if ((uint32_t)pElements[zElt].Type >= XCAN_RX_FILTER_TYPE_COUNT) return ERR__PARAMETER_ERROR; // The type indexes ElementCycles[]
+    Cycles += pConf->ElementCycles[pElements[zElt].Type];
+  }
+  pResult->WorstCaseCycles = (uint32_t)Cycles;
+  pResult->WorstCaseNs     = (uint32_t)(((Cycles * XCAN_NS_PER_SECOND) + pConf->MHClockHz - 1u) / pConf->MHClockHz);
+
+  //--- Convert to RX DMA FIFO words: Cycles / MHClockHz seconds at DataBitrate / 32 words per second ---
+  const uint64_t CyclesPerWordNum = XCAN_BITS_PER_WORD * pConf->MHClockHz;                 // Cycles per word = CyclesPerWordNum / DataBitrate
+  pResult->NeededWords = (uint32_t)(((Cycles * pConf->DataBitrate) + CyclesPerWordNum - 1u) / CyclesPerWordNum);
+  const uint32_t Threshold = pResult->NeededWords + pConf->MarginWords;
+  pResult->ThresholdCoversWorstCase = (Threshold <= XCAN_RX_FILTER_THRESHOLD_MAX);
+  pResult->Threshold = (uint8_t)(Threshold > XCAN_RX_FILTER_THRESHOLD_MAX ? XCAN_RX_FILTER_THRESHOLD_MAX : (Threshold == 0 ? 1u : Threshold));
+
+  //--- Longest table covered by the maximum threshold ---
+  uint32_t MaxElements = 0;
+  if (pConf->MarginWords < XCAN_RX_FILTER_THRESHOLD_MAX)
+  {
+    const uint64_t MaxCycles = ((uint64_t)(XCAN_RX_FILTER_THRESHOLD_MAX - pConf->MarginWords) * CyclesPerWordNum) / pConf->DataBitrate;
+    if ((MaxCycles > pConf->FixedCycles) && (SlowestCycles > 0))
+    {
+      const uint64_t Elements = (MaxCycles - pConf->FixedCycles) / SlowestCycles;
+      MaxElements = (uint32_t)(Elements > XCAN_RX_FILTER_MAX_ELEMENTS ? XCAN_RX_FILTER_MAX_ELEMENTS : Elements);
+    }
+    else if (SlowestCycles == 0) MaxElements = XCAN_RX_FILTER_MAX_ELEMENTS;
+  }
+  pResult->MaxElements = (uint8_t)MaxElements;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Initialize the RX filtering threshold tuner and set the initial threshold
+//=============================================================================
+eERRORRESULT XCAN_InitFilterTuner(XCAN *pComp, XCAN_FilterTuner* pTuner, uint8_t threshold, uint32_t maxTimeoutsPpm, uint32_t windowMessages)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pTuner == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if ((threshold == 0) || (threshold > XCAN_RX_FILTER_THRESHOLD_MAX)) return ERR__OUT_OF_RANGE;
+  if (windowMessages == 0) return ERR__PARAMETER_ERROR;
+  pTuner->Threshold      = threshold;
+  pTuner->MaxTimeoutsPpm = maxTimeoutsPpm;
+  pTuner->WindowMessages = windowMessages;
+  pTuner->WindowReceived = 0;
+  pTuner->WindowTimeouts = 0;
+  pTuner->Received       = 0;
+  pTuner->Timeouts       = 0;
+  return XCAN_SetRxFilterThreshold(pComp, threshold);
+}
+
+
+
+//=============================================================================
+// Count the RX messages routed by the threshold and tune the threshold
+//=============================================================================
+eERRORRESULT XCAN_UpdateFilterTuner(XCAN *pComp, XCAN_FilterTuner* pTuner, const XCAN_RxMessageView* pViews, size_t count, bool* pChanged)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pTuner == NULL) || ((pViews == NULL) && (count > 0))) return ERR__PARAMETER_ERROR;
+#endif
+  if (pChanged != NULL) *pChanged = false;
+  uint32_t Timeouts = 0;
+  for (size_t zMsg = 0; zMsg < count; ++zMsg) Timeouts += ((pViews[zMsg].R1 & XCAN_R1_FAB) > 0 ? 1u : 0u);
+  pTuner->Received       += (uint32_t)count;
+  pTuner->Timeouts       += Timeouts;
+  pTuner->WindowReceived += (uint32_t)count;
+  pTuner->WindowTimeouts += Timeouts;
+  if (pTuner->WindowReceived < pTuner->WindowMessages) return ERR_OK;
+
+  //--- End of the window ---
+  const bool TooMany = (((uint64_t)pTuner->WindowTimeouts * XCAN_PPM_PER_UNIT) > ((uint64_t)pTuner->MaxTimeoutsPpm * pTuner->WindowReceived));
+  pTuner->WindowReceived = 0;
+  pTuner->WindowTimeouts = 0;
+  if ((TooMany == false) || (pTuner->Threshold >= XCAN_RX_FILTER_THRESHOLD_MAX)) return ERR_OK;
+  eERRORRESULT Error = XCAN_SetRxFilterThreshold(pComp, pTuner->Threshold + 1u);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_SetRxFilterThreshold() then return the error
+  pTuner->Threshold++;
+  if (pChanged != NULL) *pChanged = true;
+  return ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
@@ -0,0 +1,150 @@
+/*!*****************************************************************************
+ * @file    XCAN_FilterLatency.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN RX filtering latency model and threshold tuner
+ * @details
+ * The MH evaluates the RX filter elements while the message is received in
+ *   the RX DMA FIFO. With ANFF set, a message which filtering result is not
+ *   known when the RX DMA FIFO level reaches THRESHOLD words is stored in the
+ *   default RX FIFO Queue (ANMF_FQ) with R1.FAB set, and needs a second pass
+ *   in software.
+ * The model gives the worst case filtering time of a filter elements table
+ *   (no match: all the elements are evaluated) from the MH clock cycles of
+ *   each element type, and converts it to RX DMA FIFO words received at the
+ *   data bitrate. The cycles shall be taken from the MH documentation or
+ *   measured on the target, the model does not know them.
+ * The tuner counts at runtime the messages routed because of the threshold
+ *   (R1.FAB) and raises THRESHOLD while they are above a target rate
+ ******************************************************************************/
+/* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#ifndef XCAN_FILTERLATENCY_H_INC
+#define XCAN_FILTERLATENCY_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include "XCAN.h"
+#include "XCAN_FilterCompiler.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+  extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define XCAN_RX_FILTER_TYPE_COUNT  ( 4u ) //!< Count of RX filter element types (see #eXCAN_RxFilterType)
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// XCAN RX Filtering latency model
+//********************************************************************************************************************
+
+//! RX filtering latency model configuration structure
+typedef struct XCAN_FilterLatencyConfig
+{
+  uint32_t MHClockHz;                                 //!< MH clock frequency in Hz
+  uint16_t FixedCycles;                               //!< MH clock cycles of the RX filtering of a message without the elements evaluation
+  uint16_t ElementCycles[XCAN_RX_FILTER_TYPE_COUNT];  //!< MH clock cycles of the evaluation of an element (L_MEM read included), by #eXCAN_RxFilterType
+  uint32_t DataBitrate;                               //!< Fastest bitrate of the RX payload in bit/s (CAN-FD or CAN-XL data phase)
+  uint8_t MarginWords;                                //!< Words added to the needed threshold for the uncertainty of the model
+} XCAN_FilterLatencyConfig;
+
+//! RX filtering latency estimation structure
+typedef struct XCAN_FilterLatencyResult
+{
+  uint32_t WorstCaseCycles;     //!< MH clock cycles of the filtering of a message that matches no element
+  uint32_t WorstCaseNs;         //!< Worst case filtering time in ns
+  uint32_t NeededWords;         //!< RX DMA FIFO words received at DataBitrate during the worst case filtering
+  uint8_t Threshold;            //!< Recommended THRESHOLD (1 to XCAN_RX_FILTER_THRESHOLD_MAX), to be used with ANFF
+  bool ThresholdCoversWorstCase; //!< 'true' if no message should be routed by the threshold with this table, 'false' if the table is too long for the data bitrate
+  uint8_t MaxElements;          //!< Count of elements of the slowest type for which the threshold still covers the worst case
+} XCAN_FilterLatencyResult;
+
+//! RX filtering threshold tuner structure
+typedef struct XCAN_FilterTuner
+{
+  uint8_t Threshold;            //!< Current THRESHOLD
+  uint32_t MaxTimeoutsPpm;      //!< Maximum messages routed by the threshold, in parts per million of the messages received
+  uint32_t WindowMessages;      //!< Count of messages of a check window
+  uint32_t WindowReceived;      //!< Messages received in the current window
+  uint32_t WindowTimeouts;      //!< Messages routed by the threshold in the current window
+  uint32_t Received;            //!< Total messages received
+  uint32_t Timeouts;            //!< Total messages routed by the threshold (R1.FAB set)
+} XCAN_FilterTuner;
+
+//-----------------------------------------------------------------------------
+
+
+
+/*! @brief Estimate the worst case RX filtering latency of a filter elements table and recommend the threshold
+ *
+ * @param[in] *pConf Is the latency model configuration
+ * @param[in] *pElements Is the RX filter elements table
+ * @param[in] count Is the count of elements of the table
+ * @param[out] *pResult Is where the estimation will be stored
+ * @return Returns an #eERRORRESULT value enum, ERR__PARAMETER_ERROR if an element has an unknown type
+ */
+eERRORRESULT XCAN_RecommendRxFilterThreshold(const XCAN_FilterLatencyConfig* pConf, const XCAN_RxFilterElement* pElements, size_t count, XCAN_FilterLatencyResult* pResult);
+
+/*! @brief Initialize the RX filtering threshold tuner and set the initial threshold
+ *
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[out] *pTuner Is the tuner to initialize
+ * @param[in] threshold Is the initial threshold, XCAN_FilterLatencyResult.Threshold for example (1 to XCAN_RX_FILTER_THRESHOLD_MAX)
+ * @param[in] maxTimeoutsPpm Is the maximum rate of messages routed by the threshold in parts per million
+ * @param[in] windowMessages Is the count of messages received between 2 checks (1 or more)
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_InitFilterTuner(XCAN *pComp, XCAN_FilterTuner* pTuner, uint8_t threshold, uint32_t maxTimeoutsPpm, uint32_t windowMessages);
+
+/*! @brief Count the RX messages routed by the threshold and tune the threshold
+ *
+ * Call it with all the RX messages received (of all RX FIFO Queues). At the end of each window, the threshold is raised by one word if the rate of
+ * messages routed by the threshold is over the maximum. The threshold is never lowered
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] *pTuner Is the tuner to use
+ * @param[in] *pViews Is the RX messages received
+ * @param[in] count Is the count of messages
+ * @param[out] *pChanged Is where 'true' will be stored if the threshold has been changed. Can be NULL
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_UpdateFilterTuner(XCAN *pComp, XCAN_FilterTuner* pTuner, const XCAN_RxMessageView* pViews, size_t count, bool* pChanged);
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* XCAN_FILTERLATENCY_H_INC */
@@ -0,0 +1,210 @@
+/*!*****************************************************************************
+ * @file    XCAN_FilterProfiler.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN RX filter elements ordering by hit frequency
+ * @details
+ * The order is a greedy topological sort: an element is ready when all the
+ *   elements before it in the current table that can match a same ID are
+ *   placed, and the most hit ready element is placed next
+ ******************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "XCAN_FilterProfiler.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// Reset the RX filter profiler
+//=============================================================================
+eERRORRESULT XCAN_ResetFilterProfiler(XCAN_FilterProfiler* pProf)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pProf == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  for (size_t zElt = 0; zElt < XCAN_RX_FILTER_MAX_ELEMENTS; ++zElt) pProf->Hits[zElt] = 0;
+  pProf->Total = 0;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Count the filter elements matched by RX messages
+//=============================================================================
+eERRORRESULT XCAN_ProfileRxMessages(XCAN_FilterProfiler* pProf, const XCAN_RxMessageView* pViews, size_t count)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pProf == NULL) || ((pViews == NULL) && (count > 0))) return ERR__PARAMETER_ERROR;
+#endif
+  for (size_t zMsg = 0; zMsg < count; ++zMsg)
+  {
+    const uint32_t R1 = pViews[zMsg].R1;
+    if ((R1 & XCAN_R1_FM) == 0) continue;                                                  // No element matched
+    const size_t Index = (R1 & XCAN_R1_FIDX_Mask) >> XCAN_R1_FIDX_Pos;
+    if (Index >= XCAN_RX_FILTER_MAX_ELEMENTS) continue;
+    pProf->Hits[Index]++;
+    pProf->Total++;
+  }
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// [STATIC] Check if an RX filter element matches an ID
+//=============================================================================
+static bool __XCAN_RxFilterElementMatch(const XCAN_RxFilterElement* pElement, uint32_t id)
+{
+  const uint32_t ID1 = pElement->ID1;
+  const uint32_t ID2 = pElement->ID2;
+  switch (pElement->Type)
+  {
+    case XCAN_RX_FILTER_EXACT: return (id == ID1);
+    case XCAN_RX_FILTER_DUAL : return (id == ID1) || (id == ID2);
+    case XCAN_RX_FILTER_RANGE: return (id >= ID1) && (id <= ID2);
+    default                  : return ((id & ID2) == (ID1 & ID2));
+  }
+}
+
+
+
+//=============================================================================
+// [STATIC] Check if 2 RX filter elements can match a same ID
+//=============================================================================
+static bool __XCAN_RxFilterElementsOverlap(const XCAN_RxFilterElement* pA, const XCAN_RxFilterElement* pB)
+{
+  if (pA->Extended != pB->Extended) return false;                                          // A standard ID never matches an extended element
+  const eXCAN_RxFilterType TypeA = pA->Type;
+  const eXCAN_RxFilterType TypeB = pB->Type;
+  if ((TypeB == XCAN_RX_FILTER_EXACT) || (TypeB == XCAN_RX_FILTER_DUAL))                  // Work with the IDs of the element B
+  {
+    const XCAN_RxFilterElement* pSwap = pA; pA = pB; pB = pSwap;
+  }
+  const uint32_t ID1A = pA->ID1, ID2A = pA->ID2;
+  const uint32_t ID1B = pB->ID1, ID2B = pB->ID2;
+  switch (pA->Type)
+  {
+    case XCAN_RX_FILTER_EXACT: return __XCAN_RxFilterElementMatch(pB, ID1A);
+    case XCAN_RX_FILTER_DUAL : return __XCAN_RxFilterElementMatch(pB, ID1A) || __XCAN_RxFilterElementMatch(pB, ID2A);
+    default: break;
+  }
+
+  //--- Ranges and masks ---
+  if ((TypeA == XCAN_RX_FILTER_RANGE) && (TypeB == XCAN_RX_FILTER_RANGE)) return (ID1A <= ID2B) && (ID1B <= ID2A);
+  if ((TypeA == XCAN_RX_FILTER_MASK) && (TypeB == XCAN_RX_FILTER_MASK)) return (((ID1A ^ ID1B) & ID2A & ID2B) == 0);
+  const uint32_t First = (TypeA == XCAN_RX_FILTER_RANGE ? ID1A : ID1B), Last = (TypeA == XCAN_RX_FILTER_RANGE ? ID2A : ID2B);
+  const uint32_t ID    = (TypeA == XCAN_RX_FILTER_MASK  ? ID1A : ID1B), Mask = (TypeA == XCAN_RX_FILTER_MASK  ? ID2A : ID2B);
+  const uint32_t MaskMin = ID & Mask;                                                      // Lowest and highest IDs matched by the mask
+  const uint32_t MaskMax = MaskMin | (~Mask & XCAN_RX_FILTER_EID_MAX);
+  return (MaskMin <= Last) && (First <= MaskMax);                                          // Conservative: the mask may have no ID inside the range
+}
+
+
+
+//=============================================================================
+// Compute the order of the RX filter elements by hit frequency
+//=============================================================================
+eERRORRESULT XCAN_OrderRxFilters(const XCAN_FilterProfiler* pProf, const XCAN_RxFilterElement* pElements, size_t count, XCAN_RxFilterElement* pReordered, XCAN_FilterOrder* pOrder)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pProf == NULL) || (pOrder == NULL)) return ERR__PARAMETER_ERROR;
+  if (((pElements == NULL) || (pReordered == NULL)) && (count > 0)) return ERR__PARAMETER_ERROR;
+#endif
+  if (count > XCAN_RX_FILTER_MAX_ELEMENTS) return ERR__OUT_OF_RANGE;
+  uint8_t Pending[XCAN_RX_FILTER_MAX_ELEMENTS];                                            // Count of elements before each element that can match a same ID and are not placed yet
+  bool Placed[XCAN_RX_FILTER_MAX_ELEMENTS];
+
+  for (size_t zElt = 0; zElt < count; ++zElt)
+  {
+    Pending[zElt] = 0;
+    Placed[zElt]  = false;
+    for (size_t zPrev = 0; zPrev < zElt; ++zPrev)
+      if (__XCAN_RxFilterElementsOverlap(&pElements[zPrev], &pElements[zElt])) Pending[zElt]++;
+  }
+
+  //--- Place the most hit ready element first ---
+  pOrder->CostBefore = 0;
+  pOrder->CostAfter  = 0;
+  for (size_t zPos = 0; zPos < count; ++zPos)
+  {
+    size_t Best = count;
+    for (size_t zElt = 0; zElt < count; ++zElt)
+    {
+      if (Placed[zElt] || (Pending[zElt] > 0)) continue;
+      if ((Best == count) || (pProf->Hits[zElt] > pProf->Hits[Best])) Best = zElt;         // The first element of same hits is kept, the order is stable
+    }
+    Placed[Best] = true;                                                                   // The first pending element is always ready, Best is found
+    for (size_t zNext = Best + 1u; zNext < count; ++zNext)
+      if ((Placed[zNext] == false) && __XCAN_RxFilterElementsOverlap(&pElements[Best], &pElements[zNext])) Pending[zNext]--;
+    pReordered[zPos]        = pElements[Best];
+    pOrder->OldIndex[zPos]  = (uint8_t)Best;
+    pOrder->CostBefore     += (uint64_t)pProf->Hits[Best] * (Best + 1u);
+    pOrder->CostAfter      += (uint64_t)pProf->Hits[Best] * (zPos + 1u);
+  }
+  pOrder->Count = (uint8_t)count;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Apply a new order of the RX filter elements
+//=============================================================================
+eERRORRESULT XCAN_ApplyRxFilterOrder(XCAN *pComp, const XCAN_RxFilterConfig* pConf, const XCAN_FilterOrder* pOrder, XCAN_RxDispatcher* pDisp, XCAN_FilterProfiler* pProf)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pComp == NULL) || (pConf == NULL) || (pOrder == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (pConf->ElementCount != pOrder->Count) return ERR__PARAMETER_ERROR;
+  eERRORRESULT Error;
+
+  //--- Switch the table in a maintenance window ---
+  uint32_t Status;
+  Error = XCAN_ReadREG32(pComp, RegXCAN_MH_STS, &Status);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_ReadREG32() then return the error
+  if ((Status & XCAN_MH_STS_BUSY) > 0) return ERR__NOT_READY;                              // The MH can be filtering a message with the current table
+  Error = XCAN_ConfigureRxFilters(pComp, pConf);
+  if (Error != ERR_OK) return Error;                                                       // If there is an error while calling XCAN_ConfigureRxFilters() then return the error
+
+  //--- Move the filter indexes ---
+  if (pDisp != NULL)
+  {
+    uint8_t Subscribers[XCAN_RX_FILTER_MAX_ELEMENTS];
+    for (size_t zElt = 0; zElt < pOrder->Count; ++zElt) Subscribers[zElt] = pDisp->FilterSubscriber[pOrder->OldIndex[zElt]];
+    for (size_t zElt = 0; zElt < pOrder->Count; ++zElt) pDisp->FilterSubscriber[zElt] = Subscribers[zElt];
+  }
+  if (pProf != NULL)
+  {
+    uint32_t Hits[XCAN_RX_FILTER_MAX_ELEMENTS];
+    pProf->Total = 0;
+    for (size_t zElt = 0; zElt < pOrder->Count; ++zElt) Hits[zElt] = pProf->Hits[pOrder->OldIndex[zElt]] / 2u; // Age the hits
+    for (size_t zElt = 0; zElt < XCAN_RX_FILTER_MAX_ELEMENTS; ++zElt)
+    {
+      pProf->Hits[zElt] = (zElt < pOrder->Count ? Hits[zElt] : 0);
+      pProf->Total += pProf->Hits[zElt];
+    }
+  }
+  return ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
@@ -0,0 +1,139 @@
+/*!*****************************************************************************
+ * @file    XCAN_FilterProfiler.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN RX filter elements ordering by hit frequency
+ * @details
+ * The MH evaluates the RX filter elements in the table order and stops at the
+ *   first match, an element that matches often should be at the start of the
+ *   table. The profiler counts the matches of each element with the filter
+ *   index (R1.FIDX) of the RX messages, then computes a new order with the
+ *   most hit elements first.
+ * Two elements that can match a same ID keep their relative order, so each
+ *   ID is still accepted by the same element (black list elements and
+ *   specific elements in front of wider ones stay in front of them).
+ * The new table is written by the application in another L_MEM area and
+ *   applied when the MH is idle (MH_STS.BUSY = 0), the filter indexes of the
+ *   dispatcher and of the profiler are moved with the elements
+ ******************************************************************************/
+/* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#ifndef XCAN_FILTERPROFILER_H_INC
+#define XCAN_FILTERPROFILER_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include "XCAN.h"
+#include "XCAN_FilterCompiler.h"
+#include "XCAN_RxDispatcher.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+  extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// XCAN RX Filter profiler
+//********************************************************************************************************************
+
+//! RX filter profiler structure
+typedef struct XCAN_FilterProfiler
+{
+  uint32_t Hits[XCAN_RX_FILTER_MAX_ELEMENTS]; //!< Count of messages that matched each filter element, by filter index
+  uint32_t Total;                             //!< Count of messages that matched a filter element
+} XCAN_FilterProfiler;
+
+//! RX filter elements order structure
+typedef struct XCAN_FilterOrder
+{
+  uint8_t OldIndex[XCAN_RX_FILTER_MAX_ELEMENTS]; //!< Current filter index of each element of the new table
+  uint8_t Count;                                 //!< Count of elements of the table
+  uint64_t CostBefore;                           //!< Count of elements evaluated for the messages profiled with the current table
+  uint64_t CostAfter;                            //!< Count of elements evaluated for the messages profiled with the new table
+} XCAN_FilterOrder;
+
+//-----------------------------------------------------------------------------
+
+
+
+/*! @brief Reset the RX filter profiler
+ *
+ * @param[out] *pProf Is the profiler to reset
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_ResetFilterProfiler(XCAN_FilterProfiler* pProf);
+
+/*! @brief Count the filter elements matched by RX messages
+ *
+ * The messages without filter match (R1.FM = 0) are not counted, they evaluate all the elements whatever the order
+ * @param[in] *pProf Is the profiler to use
+ * @param[in] *pViews Is the RX messages received
+ * @param[in] count Is the count of messages
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_ProfileRxMessages(XCAN_FilterProfiler* pProf, const XCAN_RxMessageView* pViews, size_t count);
+
+/*! @brief Compute the order of the RX filter elements by hit frequency
+ *
+ * The most hit elements are put first, the elements that can match a same ID keep their relative order (the overlap of a range and a mask is
+ * estimated conservatively). The elements with the same hit count keep their order
+ * @param[in] *pProf Is the profiler with the hits of the current table
+ * @param[in] *pElements Is the current RX filter elements table
+ * @param[in] count Is the count of elements of the table
+ * @param[out] *pReordered Is where the new RX filter elements table will be stored, count elements. It shall be written in L_MEM by the application
+ * @param[out] *pOrder Is where the new order will be stored, to be used with XCAN_ApplyRxFilterOrder()
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_OrderRxFilters(const XCAN_FilterProfiler* pProf, const XCAN_RxFilterElement* pElements, size_t count, XCAN_RxFilterElement* pReordered, XCAN_FilterOrder* pOrder);
+
+/*! @brief Apply a new order of the RX filter elements
+ *
+ * The new table shall already be in L_MEM at pConf->ElementsAddress, outside of the current table. The MH shall be idle (MH_STS.BUSY = 0) and
+ * all the messages received with the current table shall have been dispatched. The subscribers of the dispatcher are moved to the new filter
+ * indexes, and the hits of the profiler too after being halved, so that the next order follows the recent traffic
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] *pConf Is the RX filters configuration of the new table
+ * @param[in] *pOrder Is the new order, computed by XCAN_OrderRxFilters()
+ * @param[in] *pDisp Is the dispatcher to update. Can be NULL
+ * @param[in] *pProf Is the profiler to update. Can be NULL
+ * @return Returns an #eERRORRESULT value enum, ERR__NOT_READY if the MH is busy (the table is not changed, retry at the next maintenance window)
+ */
+eERRORRESULT XCAN_ApplyRxFilterOrder(XCAN *pComp, const XCAN_RxFilterConfig* pConf, const XCAN_FilterOrder* pOrder, XCAN_RxDispatcher* pDisp, XCAN_FilterProfiler* pProf);
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* XCAN_FILTERPROFILER_H_INC */
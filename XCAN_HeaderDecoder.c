@@ -0,0 +1,267 @@
+/*!*****************************************************************************
+ * @file    XCAN_HeaderDecoder.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN RX message headers batch decoder
+ * @details
+ * All the fields are extracted without branch: the frame type bits (FDF, XLF,
+ *   XTD) are turned into all-ones masks with an arithmetic shift, then each
+ *   field is selected with these masks. The SIMD kernels do exactly the same
+ *   operations on 4 (SSE2, NEON) or 8 (AVX2) headers at once.
+ * The SIMD kernels deinterleave the R0/R1 words with a shuffle, and narrow the
+ *   32-bits results to 16-bits with a signed saturation (all DLC and flags
+ *   values are below 0x8000, SSE4.1 is not needed).
+ ******************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "XCAN_HeaderDecoder.h"
+//-----------------------------------------------------------------------------
+#if defined(XCAN_HEADER_DECODER_USE_SIMD)
+#  if defined(__AVX2__)
+#    include <immintrin.h>
+#    define XCAN_HEADER_DECODER_AVX2_AVAILABLE
+#  elif defined(__SSE2__)
+#    include <emmintrin.h>
+#    define XCAN_HEADER_DECODER_SSE2_AVAILABLE
+#  elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    include <arm_neon.h>
+#    define XCAN_HEADER_DECODER_NEON_AVAILABLE
+#  endif
+#endif
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define XCAN_RXH_SEC_Pos           (  6 ) //!< Bit position of XCAN_RXH_SEC, XCAN_RXH_RRS is the next bit as R0.RRS follows R0.SEC
+#define XCAN_RXH_R0_SEC_RRS_SHIFT  ( XCAN_R0_SEC_Pos - XCAN_RXH_SEC_Pos ) //!< R0.SEC and R0.RRS to XCAN_RXH_SEC and XCAN_RXH_RRS
+#define XCAN_RXH_R1_RTR_SHIFT      ( 23 ) //!< R1.RTR (bit 26) to XCAN_RXH_RTR
+#define XCAN_RXH_R1_BRS_SHIFT      ( 21 ) //!< R1.BRS (bit 25) to XCAN_RXH_BRS
+#define XCAN_RXH_R1_ESI_SHIFT      ( 15 ) //!< R1.ESI (bit 20) to XCAN_RXH_ESI
+#define XCAN_RXH_R1_FILTER_SHIFT   (  4 ) //!< R1.FM, R1.BLK, R1.FAB (bits 8-10) to XCAN_RXH_FILTER_MATCH, XCAN_RXH_BLACK_LIST, XCAN_RXH_FILTER_ABORT
+#define XCAN_RXH_FILTER_Mask       ( XCAN_RXH_FILTER_MATCH | XCAN_RXH_BLACK_LIST | XCAN_RXH_FILTER_ABORT )
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// [STATIC] Decode one RX message header
+//=============================================================================
+static inline void __XCAN_DecodeRxHeader(uint32_t r0, uint32_t r1, const XCAN_RxHeaderArrays* pOut, size_t index)
+{
+  const uint32_t FDF = (uint32_t)((int32_t)r0 >> 31);                                      // All ones if FDF = 1
+  const uint32_t XLF = (uint32_t)((int32_t)(r0 << 1) >> 31);                               // All ones if XLF = 1
+  const uint32_t XTD = (uint32_t)((int32_t)(r0 << 2) >> 31) & ~XLF;                        // All ones if XTD = 1, there is no extended ID with CAN-XL
+  const uint32_t FD  = FDF & ~XLF;                                                         // All ones if the frame is a CAN-FD frame
+  uint32_t Flags = (FD & XCAN_RXH_CANFD) | (XTD & XCAN_RXH_EXTENDED_ID) | (~(FDF | XLF) & (r1 >> XCAN_RXH_R1_RTR_SHIFT) & XCAN_RXH_RTR);
+  Flags |= XLF & (XCAN_RXH_CANXL | ((r0 >> XCAN_RXH_R0_SEC_RRS_SHIFT) & (XCAN_RXH_SEC | XCAN_RXH_RRS)));
+  Flags |= FD & (((r1 >> XCAN_RXH_R1_BRS_SHIFT) & XCAN_RXH_BRS) | ((r1 >> XCAN_RXH_R1_ESI_SHIFT) & XCAN_RXH_ESI));
+  Flags |= (r1 << XCAN_RXH_R1_FILTER_SHIFT) & XCAN_RXH_FILTER_Mask;
+  pOut->ID[index]    = (XTD & XCAN_R0_ID_Mask & r0) | (~XTD & XCAN_R0_SID_GET(r0));
+  pOut->DLC[index]   = (uint16_t)((r1 >> XCAN_R1_DLC_Pos) & ((XCAN_R1_DLC_Mask | (XLF & XCAN_R1_CANXL_DLC_Mask)) >> XCAN_R1_DLC_Pos));
+  pOut->Flags[index] = (uint16_t)Flags;
+  pOut->FIDX[index]  = (uint8_t)(r1 & XCAN_R1_FIDX_Mask);
+}
+
+
+
+//=============================================================================
+// Decode a batch of RX message headers one by one
+//=============================================================================
+eERRORRESULT XCAN_DecodeRxHeaders_Scalar(const uint32_t* pHeaders, size_t count, const XCAN_RxHeaderArrays* pOut)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pHeaders == NULL) || (pOut == NULL)) return ERR__PARAMETER_ERROR;
+  if ((pOut->ID == NULL) || (pOut->DLC == NULL) || (pOut->Flags == NULL) || (pOut->FIDX == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  for (size_t zHeader = 0; zHeader < count; ++zHeader)
+    __XCAN_DecodeRxHeader(pHeaders[2 * zHeader], pHeaders[2 * zHeader + 1u], pOut, zHeader);
+  return ERR_OK;
+}
+
+
+
+#if defined(XCAN_HEADER_DECODER_AVX2_AVAILABLE)
+//=============================================================================
+// [STATIC] Decode 8 RX message headers with AVX2 instructions
+//=============================================================================
+static inline void __XCAN_DecodeRxHeaders8_AVX2(const uint32_t* pHeaders, const XCAN_RxHeaderArrays* pOut, size_t index)
+{
+  //--- Deinterleave R0 and R1 ---
+  const __m256 Lo = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)&pHeaders[0]));  // Headers 0-3
+  const __m256 Hi = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)&pHeaders[8]));  // Headers 4-7
+  const __m256i R0 = _mm256_permute4x64_epi64(_mm256_castps_si256(_mm256_shuffle_ps(Lo, Hi, 0x88)), 0xD8); // Shuffle gives headers 0,1,4,5,2,3,6,7
+  const __m256i R1 = _mm256_permute4x64_epi64(_mm256_castps_si256(_mm256_shuffle_ps(Lo, Hi, 0xDD)), 0xD8);
+
+  //--- Decode ---
+  const __m256i FDF = _mm256_srai_epi32(R0, 31);
+  const __m256i XLF = _mm256_srai_epi32(_mm256_slli_epi32(R0, 1), 31);
+  const __m256i XTD = _mm256_andnot_si256(XLF, _mm256_srai_epi32(_mm256_slli_epi32(R0, 2), 31));
+  const __m256i FD  = _mm256_andnot_si256(XLF, FDF);
+  __m256i Flags = _mm256_or_si256(_mm256_and_si256(FD, _mm256_set1_epi32(XCAN_RXH_CANFD)), _mm256_and_si256(XTD, _mm256_set1_epi32(XCAN_RXH_EXTENDED_ID)));
+  Flags = _mm256_or_si256(Flags, _mm256_andnot_si256(_mm256_or_si256(FDF, XLF), _mm256_and_si256(_mm256_srli_epi32(R1, XCAN_RXH_R1_RTR_SHIFT), _mm256_set1_epi32(XCAN_RXH_RTR))));
+  Flags = _mm256_or_si256(Flags, _mm256_and_si256(XLF, _mm256_or_si256(_mm256_set1_epi32(XCAN_RXH_CANXL), _mm256_and_si256(_mm256_srli_epi32(R0, XCAN_RXH_R0_SEC_RRS_SHIFT), _mm256_set1_epi32(XCAN_RXH_SEC | XCAN_RXH_RRS)))));
+  Flags = _mm256_or_si256(Flags, _mm256_and_si256(FD, _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(R1, XCAN_RXH_R1_BRS_SHIFT), _mm256_set1_epi32(XCAN_RXH_BRS)),
+                                                                      _mm256_and_si256(_mm256_srli_epi32(R1, XCAN_RXH_R1_ESI_SHIFT), _mm256_set1_epi32(XCAN_RXH_ESI)))));
+  Flags = _mm256_or_si256(Flags, _mm256_and_si256(_mm256_slli_epi32(R1, XCAN_RXH_R1_FILTER_SHIFT), _mm256_set1_epi32(XCAN_RXH_FILTER_Mask)));
+  const __m256i ID  = _mm256_or_si256(_mm256_and_si256(XTD, _mm256_and_si256(R0, _mm256_set1_epi32((int)XCAN_R0_ID_Mask))),
+                                      _mm256_andnot_si256(XTD, _mm256_and_si256(_mm256_srli_epi32(R0, XCAN_R0_SID_Pos), _mm256_set1_epi32(XCAN_R0_SID_Mask >> XCAN_R0_SID_Pos))));
+  const __m256i DLC = _mm256_and_si256(_mm256_srli_epi32(R1, XCAN_R1_DLC_Pos), _mm256_or_si256(_mm256_set1_epi32(XCAN_R1_DLC_Mask >> XCAN_R1_DLC_Pos), _mm256_and_si256(XLF, _mm256_set1_epi32(XCAN_R1_CANXL_DLC_Mask >> XCAN_R1_DLC_Pos))));
+  const __m256i FIDX = _mm256_and_si256(R1, _mm256_set1_epi32(XCAN_R1_FIDX_Mask));
+
+  //--- Narrow and store ---
+  const __m128i FIDX16 = _mm_packs_epi32(_mm256_castsi256_si128(FIDX), _mm256_extracti128_si256(FIDX, 1));
+  _mm256_storeu_si256((__m256i*)&pOut->ID[index], ID);
+  _mm_storeu_si128((__m128i*)&pOut->DLC[index], _mm_packs_epi32(_mm256_castsi256_si128(DLC), _mm256_extracti128_si256(DLC, 1)));
+  _mm_storeu_si128((__m128i*)&pOut->Flags[index], _mm_packs_epi32(_mm256_castsi256_si128(Flags), _mm256_extracti128_si256(Flags, 1)));
+  _mm_storel_epi64((__m128i*)&pOut->FIDX[index], _mm_packus_epi16(FIDX16, FIDX16));
+}
+#endif
+
+
+
+#if defined(XCAN_HEADER_DECODER_SSE2_AVAILABLE)
+//=============================================================================
+// [STATIC] Decode 4 RX message headers with SSE2 instructions
+//=============================================================================
+static inline void __XCAN_DecodeRxHeaders4_SSE2(const uint32_t* pHeaders, __m128i* pID, __m128i* pDLC, __m128i* pFlags, __m128i* pFIDX)
+{
+  //--- Deinterleave R0 and R1 ---
+  const __m128 Lo = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)&pHeaders[0]));       // Headers 0-1
+  const __m128 Hi = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)&pHeaders[4]));       // Headers 2-3
+  const __m128i R0 = _mm_castps_si128(_mm_shuffle_ps(Lo, Hi, 0x88));
+  const __m128i R1 = _mm_castps_si128(_mm_shuffle_ps(Lo, Hi, 0xDD));
+
+  //--- Decode ---
+  const __m128i FDF = _mm_srai_epi32(R0, 31);
+  const __m128i XLF = _mm_srai_epi32(_mm_slli_epi32(R0, 1), 31);
+  const __m128i XTD = _mm_andnot_si128(XLF, _mm_srai_epi32(_mm_slli_epi32(R0, 2), 31));
+  const __m128i FD  = _mm_andnot_si128(XLF, FDF);
+  __m128i Flags = _mm_or_si128(_mm_and_si128(FD, _mm_set1_epi32(XCAN_RXH_CANFD)), _mm_and_si128(XTD, _mm_set1_epi32(XCAN_RXH_EXTENDED_ID)));
+  Flags = _mm_or_si128(Flags, _mm_andnot_si128(_mm_or_si128(FDF, XLF), _mm_and_si128(_mm_srli_epi32(R1, XCAN_RXH_R1_RTR_SHIFT), _mm_set1_epi32(XCAN_RXH_RTR))));
+  Flags = _mm_or_si128(Flags, _mm_and_si128(XLF, _mm_or_si128(_mm_set1_epi32(XCAN_RXH_CANXL), _mm_and_si128(_mm_srli_epi32(R0, XCAN_RXH_R0_SEC_RRS_SHIFT), _mm_set1_epi32(XCAN_RXH_SEC | XCAN_RXH_RRS)))));
+  Flags = _mm_or_si128(Flags, _mm_and_si128(FD, _mm_or_si128(_mm_and_si128(_mm_srli_epi32(R1, XCAN_RXH_R1_BRS_SHIFT), _mm_set1_epi32(XCAN_RXH_BRS)),
+                                                              _mm_and_si128(_mm_srli_epi32(R1, XCAN_RXH_R1_ESI_SHIFT), _mm_set1_epi32(XCAN_RXH_ESI)))));
+  *pFlags = _mm_or_si128(Flags, _mm_and_si128(_mm_slli_epi32(R1, XCAN_RXH_R1_FILTER_SHIFT), _mm_set1_epi32(XCAN_RXH_FILTER_Mask)));
+  *pID    = _mm_or_si128(_mm_and_si128(XTD, _mm_and_si128(R0, _mm_set1_epi32((int)XCAN_R0_ID_Mask))),
+                         _mm_andnot_si128(XTD, _mm_and_si128(_mm_srli_epi32(R0, XCAN_R0_SID_Pos), _mm_set1_epi32(XCAN_R0_SID_Mask >> XCAN_R0_SID_Pos))));
+  *pDLC   = _mm_and_si128(_mm_srli_epi32(R1, XCAN_R1_DLC_Pos), _mm_or_si128(_mm_set1_epi32(XCAN_R1_DLC_Mask >> XCAN_R1_DLC_Pos), _mm_and_si128(XLF, _mm_set1_epi32(XCAN_R1_CANXL_DLC_Mask >> XCAN_R1_DLC_Pos))));
+  *pFIDX  = _mm_and_si128(R1, _mm_set1_epi32(XCAN_R1_FIDX_Mask));
+}
+
+
+
+//=============================================================================
+// [STATIC] Decode 8 RX message headers with SSE2 instructions
+//=============================================================================
+static inline void __XCAN_DecodeRxHeaders8_SSE2(const uint32_t* pHeaders, const XCAN_RxHeaderArrays* pOut, size_t index)
+{
+  __m128i IDLo, DLCLo, FlagsLo, FIDXLo, IDHi, DLCHi, FlagsHi, FIDXHi;
+  __XCAN_DecodeRxHeaders4_SSE2(&pHeaders[0], &IDLo, &DLCLo, &FlagsLo, &FIDXLo);
+  __XCAN_DecodeRxHeaders4_SSE2(&pHeaders[8], &IDHi, &DLCHi, &FlagsHi, &FIDXHi);
+
+  //--- Narrow and store ---
+  const __m128i FIDX16 = _mm_packs_epi32(FIDXLo, FIDXHi);
+  _mm_storeu_si128((__m128i*)&pOut->ID[index + 0u], IDLo);
+  _mm_storeu_si128((__m128i*)&pOut->ID[index + 4u], IDHi);
+  _mm_storeu_si128((__m128i*)&pOut->DLC[index], _mm_packs_epi32(DLCLo, DLCHi));
+  _mm_storeu_si128((__m128i*)&pOut->Flags[index], _mm_packs_epi32(FlagsLo, FlagsHi));
+  _mm_storel_epi64((__m128i*)&pOut->FIDX[index], _mm_packus_epi16(FIDX16, FIDX16));
+}
+#endif
+
+
+
+#if defined(XCAN_HEADER_DECODER_NEON_AVAILABLE)
+//=============================================================================
+// [STATIC] Decode 4 RX message headers with NEON instructions
+//=============================================================================
+static inline void __XCAN_DecodeRxHeaders4_NEON(const uint32_t* pHeaders, uint32x4_t* pID, uint16x4_t* pDLC, uint16x4_t* pFlags, uint16x4_t* pFIDX)
+{
+  //--- Deinterleave R0 and R1 ---
+  const uint32x4x2_t Words = vld2q_u32(pHeaders);
+  const uint32x4_t R0 = Words.val[0];
+  const uint32x4_t R1 = Words.val[1];
+
+  //--- Decode ---
+  const uint32x4_t FDF = vreinterpretq_u32_s32(vshrq_n_s32(vreinterpretq_s32_u32(R0), 31));
+  const uint32x4_t XLF = vreinterpretq_u32_s32(vshrq_n_s32(vreinterpretq_s32_u32(vshlq_n_u32(R0, 1)), 31));
+  const uint32x4_t XTD = vbicq_u32(vreinterpretq_u32_s32(vshrq_n_s32(vreinterpretq_s32_u32(vshlq_n_u32(R0, 2)), 31)), XLF);
+  const uint32x4_t FD  = vbicq_u32(FDF, XLF);
+  uint32x4_t Flags = vorrq_u32(vandq_u32(FD, vdupq_n_u32(XCAN_RXH_CANFD)), vandq_u32(XTD, vdupq_n_u32(XCAN_RXH_EXTENDED_ID)));
+  Flags = vorrq_u32(Flags, vbicq_u32(vandq_u32(vshrq_n_u32(R1, XCAN_RXH_R1_RTR_SHIFT), vdupq_n_u32(XCAN_RXH_RTR)), vorrq_u32(FDF, XLF)));
+  Flags = vorrq_u32(Flags, vandq_u32(XLF, vorrq_u32(vdupq_n_u32(XCAN_RXH_CANXL), vandq_u32(vshrq_n_u32(R0, XCAN_RXH_R0_SEC_RRS_SHIFT), vdupq_n_u32(XCAN_RXH_SEC | XCAN_RXH_RRS)))));
+  Flags = vorrq_u32(Flags, vandq_u32(FD, vorrq_u32(vandq_u32(vshrq_n_u32(R1, XCAN_RXH_R1_BRS_SHIFT), vdupq_n_u32(XCAN_RXH_BRS)),
+                                                   vandq_u32(vshrq_n_u32(R1, XCAN_RXH_R1_ESI_SHIFT), vdupq_n_u32(XCAN_RXH_ESI)))));
+  Flags = vorrq_u32(Flags, vandq_u32(vshlq_n_u32(R1, XCAN_RXH_R1_FILTER_SHIFT), vdupq_n_u32(XCAN_RXH_FILTER_Mask)));
+  *pID    = vbslq_u32(XTD, vandq_u32(R0, vdupq_n_u32(XCAN_R0_ID_Mask)), vshrq_n_u32(vandq_u32(R0, vdupq_n_u32(XCAN_R0_SID_Mask)), XCAN_R0_SID_Pos));
+  *pDLC   = vmovn_u32(vandq_u32(vshrq_n_u32(R1, XCAN_R1_DLC_Pos), vbslq_u32(XLF, vdupq_n_u32(XCAN_R1_CANXL_DLC_Mask >> XCAN_R1_DLC_Pos), vdupq_n_u32(XCAN_R1_DLC_Mask >> XCAN_R1_DLC_Pos))));
+  *pFlags = vmovn_u32(Flags);
+  *pFIDX  = vmovn_u32(vandq_u32(R1, vdupq_n_u32(XCAN_R1_FIDX_Mask)));
+}
+
+
+
+//=============================================================================
+// [STATIC] Decode 8 RX message headers with NEON instructions
+//=============================================================================
+static inline void __XCAN_DecodeRxHeaders8_NEON(const uint32_t* pHeaders, const XCAN_RxHeaderArrays* pOut, size_t index)
+{
+  uint32x4_t IDLo, IDHi;
+  uint16x4_t DLCLo, FlagsLo, FIDXLo, DLCHi, FlagsHi, FIDXHi;
+  __XCAN_DecodeRxHeaders4_NEON(&pHeaders[0], &IDLo, &DLCLo, &FlagsLo, &FIDXLo);
+  __XCAN_DecodeRxHeaders4_NEON(&pHeaders[8], &IDHi, &DLCHi, &FlagsHi, &FIDXHi);
+
+  //--- Store ---
+  vst1q_u32(&pOut->ID[index + 0u], IDLo);
+  vst1q_u32(&pOut->ID[index + 4u], IDHi);
+  vst1q_u16(&pOut->DLC[index], vcombine_u16(DLCLo, DLCHi));
+  vst1q_u16(&pOut->Flags[index], vcombine_u16(FlagsLo, FlagsHi));
+  vst1_u8(&pOut->FIDX[index], vmovn_u16(vcombine_u16(FIDXLo, FIDXHi)));
+}
+#endif
+
+
+
+//=============================================================================
+// Decode a batch of RX message headers
+//=============================================================================
+eERRORRESULT XCAN_DecodeRxHeaders(const uint32_t* pHeaders, size_t count, const XCAN_RxHeaderArrays* pOut)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pHeaders == NULL) || (pOut == NULL)) return ERR__PARAMETER_ERROR;
+  if ((pOut->ID == NULL) || (pOut->DLC == NULL) || (pOut->Flags == NULL) || (pOut->FIDX == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  size_t zHeader = 0;
+#if defined(XCAN_HEADER_DECODER_AVX2_AVAILABLE)
+  for (; (zHeader + XCAN_RX_HEADER_DECODER_BATCH) <= count; zHeader += XCAN_RX_HEADER_DECODER_BATCH)
+    __XCAN_DecodeRxHeaders8_AVX2(&pHeaders[2 * zHeader], pOut, zHeader);
+#elif defined(XCAN_HEADER_DECODER_SSE2_AVAILABLE)
+  for (; (zHeader + XCAN_RX_HEADER_DECODER_BATCH) <= count; zHeader += XCAN_RX_HEADER_DECODER_BATCH)
+    __XCAN_DecodeRxHeaders8_SSE2(&pHeaders[2 * zHeader], pOut, zHeader);
+#elif defined(XCAN_HEADER_DECODER_NEON_AVAILABLE)
+  for (; (zHeader + XCAN_RX_HEADER_DECODER_BATCH) <= count; zHeader += XCAN_RX_HEADER_DECODER_BATCH)
+    __XCAN_DecodeRxHeaders8_NEON(&pHeaders[2 * zHeader], pOut, zHeader);
+#endif
+  for (; zHeader < count; ++zHeader)                                                       // Remaining headers one by one
+    __XCAN_DecodeRxHeader(pHeaders[2 * zHeader], pHeaders[2 * zHeader + 1u], pOut, zHeader);
+  return ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
@@ -0,0 +1,130 @@
+/*!*****************************************************************************
+ * @file    XCAN_HeaderDecoder.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN RX message headers batch decoder
+ * @details
+ * Decode a batch of RX message headers (R0, R1) into separated arrays of
+ *   identifiers, DLCs, flags and filter indexes (structure of arrays) for the
+ *   applications that process a lot of messages at once (loggers, gateways).
+ * The headers are decoded 8 by 8 with the SIMD instructions when available,
+ *   the remaining headers are decoded one by one.
+ * Configuration (in Conf_XCAN.h):
+ *   - XCAN_HEADER_DECODER_USE_SIMD: define it to use the x86 AVX2 or SSE2
+ *     instructions or the ARM NEON instructions when available
+ ******************************************************************************/
+/* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#ifndef XCAN_HEADERDECODER_H_INC
+#define XCAN_HEADERDECODER_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include "XCAN.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+  extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define XCAN_RX_HEADER_DECODER_BATCH  ( 8u ) //!< Count of headers decoded per SIMD step. Arrays sized to a multiple of this value are decoded without the one by one tail
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// XCAN RX message headers decoder
+//********************************************************************************************************************
+
+//! RX message header flags enum. The flags from XCAN_RXH_CANFD to XCAN_RXH_RRS have the same values as #eXCAN_MessageCtrlFlags
+typedef enum
+{
+  XCAN_RXH_NO_FLAGS      = 0x0000, //!< No flags (CAN2.0 frame with standard ID)
+  XCAN_RXH_CANFD         = 0x0001, //!< The frame is a CAN-FD frame (FDF = 1 and XLF = 0)
+  XCAN_RXH_CANXL         = 0x0002, //!< The frame is a CAN-XL frame (XLF = 1)
+  XCAN_RXH_EXTENDED_ID   = 0x0004, //!< The message ID is extended (XTD = 1). Never set with CAN-XL
+  XCAN_RXH_RTR           = 0x0008, //!< The frame is a remote frame (RTR = 1). Only set with CAN2.0
+  XCAN_RXH_BRS           = 0x0010, //!< The data bitrate was switched (BRS = 1). Only set with CAN-FD
+  XCAN_RXH_ESI           = 0x0020, //!< The Error State Indicator is recessive (ESI = 1). Only set with CAN-FD
+  XCAN_RXH_SEC           = 0x0040, //!< Simple Extended Content (SEC = 1). Only set with CAN-XL
+  XCAN_RXH_RRS           = 0x0080, //!< Remote Request Substitution (RRS = 1). Only set with CAN-XL
+  XCAN_RXH_FILTER_MATCH  = 0x1000, //!< A filter element has detected a match (FM = 1)
+  XCAN_RXH_BLACK_LIST    = 0x2000, //!< The message belongs to a black list (BLK = 1)
+  XCAN_RXH_FILTER_ABORT  = 0x4000, //!< The filtering process was ending before completing with no match (FAB = 1)
+} eXCAN_RxHeaderFlags;
+
+typedef eXCAN_RxHeaderFlags setXCAN_RxHeaderFlags; //! Set of RX message header flags (can be OR'ed)
+
+//-----------------------------------------------------------------------------
+
+
+
+//! Decoded RX message headers arrays. Each array shall have at least the count of headers to decode elements
+typedef struct XCAN_RxHeaderArrays
+{
+  uint32_t* ID;    //!< Message IDs: extended ID (29-bits) if XCAN_RXH_EXTENDED_ID is set, else standard ID or CAN-XL priority ID (11-bits)
+  uint16_t* DLC;   //!< Data Length Codes: 4-bits for CAN2.0 and CAN-FD, 11-bits for CAN-XL (payload size - 1)
+  uint16_t* Flags; //!< Flags of the messages (set of #eXCAN_RxHeaderFlags)
+  uint8_t* FIDX;   //!< Filter indexes that have been triggered
+} XCAN_RxHeaderArrays;
+
+//-----------------------------------------------------------------------------
+
+
+
+/*! @brief Decode a batch of RX message headers one by one
+ *
+ * This is the reference implementation, without any SIMD instruction
+ * @param[in] *pHeaders Is the headers to decode, 2 words per header (R0 then R1) as received in the data containers
+ * @param[in] count Is the count of headers to decode
+ * @param[out] *pOut Is the arrays where the decoded headers will be stored
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_DecodeRxHeaders_Scalar(const uint32_t* pHeaders, size_t count, const XCAN_RxHeaderArrays* pOut);
+
+/*! @brief Decode a batch of RX message headers
+ *
+ * Use the AVX2, SSE2 or NEON instructions if XCAN_HEADER_DECODER_USE_SIMD is defined and available, else decode the headers one by one
+ * @param[in] *pHeaders Is the headers to decode, 2 words per header (R0 then R1) as received in the data containers. No alignment needed
+ * @param[in] count Is the count of headers to decode
+ * @param[out] *pOut Is the arrays where the decoded headers will be stored
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_DecodeRxHeaders(const uint32_t* pHeaders, size_t count, const XCAN_RxHeaderArrays* pOut);
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* XCAN_HEADERDECODER_H_INC */
@@ -0,0 +1,207 @@
+/*!*****************************************************************************
+ * @file    XCAN_LockFreeQueue.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Lock-free queues between interrupt context and application threads
+ * @details
+ * The SPSC queue publishes with a release store of its index and keeps a copy
+ *   of the index of the other side to only read it when the queue looks full
+ *   or empty. The MPSC queue is a bounded queue with a sequence per element
+ *   (D. Vyukov): the producers reserve an element with a compare and swap on
+ *   Head, and publish it with a release store of its sequence
+ ******************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "XCAN_LockFreeQueue.h"
+#include <string.h>
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#if !defined(__GNUC__) && !defined(__clang__)
+#  error XCAN_LockFreeQueue needs the __atomic builtins of GCC or Clang
+#endif
+
+#define XCAN_LOAD_ACQUIRE(ptr)          __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define XCAN_LOAD_RELAXED(ptr)          __atomic_load_n((ptr), __ATOMIC_RELAXED)
+#define XCAN_STORE_RELEASE(ptr, value)  __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// Get the lock-free queue size that holds a whole RX or TX FIFO Queue
+//=============================================================================
+uint32_t XCAN_GetLockFreeQueueSize(uint16_t maxDesc)
+{
+  uint32_t Size = 1;
+  while (Size < maxDesc) Size <<= 1;
+  return Size;
+}
+
+
+
+//=============================================================================
+// Initialize a single producer single consumer queue
+//=============================================================================
+eERRORRESULT XCAN_InitSPSCQueue(XCAN_SPSCQueue* pQueue, void* pBuffer, uint32_t elementSize, uint32_t size)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pQueue == NULL) || (pBuffer == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if ((size == 0) || ((size & (size - 1u)) != 0) || (elementSize == 0)) return ERR__PARAMETER_ERROR; // The queue size shall be a power of 2
+  pQueue->Buffer      = (uint8_t*)pBuffer;
+  pQueue->Mask        = size - 1u;
+  pQueue->ElementSize = elementSize;
+  pQueue->Head        = 0;
+  pQueue->CachedTail  = 0;
+  pQueue->Tail        = 0;
+  pQueue->CachedHead  = 0;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Push elements in a single producer single consumer queue
+//=============================================================================
+eERRORRESULT XCAN_PushSPSCQueue(XCAN_SPSCQueue* pQueue, const void* pElements, size_t count, size_t* pPushedCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pQueue == NULL) || ((pElements == NULL) && (count > 0))) return ERR__PARAMETER_ERROR;
+#endif
+  const uint32_t Head = pQueue->Head;                                                      // Only written by this producer
+  uint32_t Free = (pQueue->Mask + 1u) - (Head - pQueue->CachedTail);
+  if (Free < count)                                                                        // Looks full, read the real Tail
+  {
+    pQueue->CachedTail = XCAN_LOAD_ACQUIRE(&pQueue->Tail);
+    Free = (pQueue->Mask + 1u) - (Head - pQueue->CachedTail);
+  }
+  const size_t Count = (count < Free ? count : Free);
+  const uint8_t* pSrc = (const uint8_t*)pElements;
+  for (size_t zElt = 0; zElt < Count; ++zElt)
+    memcpy(&pQueue->Buffer[((Head + zElt) & pQueue->Mask) * pQueue->ElementSize], &pSrc[zElt * pQueue->ElementSize], pQueue->ElementSize);
+  XCAN_STORE_RELEASE(&pQueue->Head, Head + (uint32_t)Count);                               // Publish the elements
+  if (pPushedCount != NULL) *pPushedCount = Count;
+  return (Count < count ? ERR__BUFFER_FULL : ERR_OK);
+}
+
+
+
+//=============================================================================
+// Pop elements from a single producer single consumer queue
+//=============================================================================
+eERRORRESULT XCAN_PopSPSCQueue(XCAN_SPSCQueue* pQueue, void* pElements, size_t maxCount, size_t* pPoppedCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pQueue == NULL) || (pElements == NULL) || (pPoppedCount == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  const uint32_t Tail = pQueue->Tail;                                                      // Only written by this consumer
+  uint32_t Available = pQueue->CachedHead - Tail;
+  if (Available < maxCount)                                                                // Looks empty, read the real Head
+  {
+    pQueue->CachedHead = XCAN_LOAD_ACQUIRE(&pQueue->Head);
+    Available = pQueue->CachedHead - Tail;
+  }
+  const size_t Count = (maxCount < Available ? maxCount : Available);
+  uint8_t* pDst = (uint8_t*)pElements;
+  for (size_t zElt = 0; zElt < Count; ++zElt)
+    memcpy(&pDst[zElt * pQueue->ElementSize], &pQueue->Buffer[((Tail + zElt) & pQueue->Mask) * pQueue->ElementSize], pQueue->ElementSize);
+  XCAN_STORE_RELEASE(&pQueue->Tail, Tail + (uint32_t)Count);                               // Free the elements
+  *pPoppedCount = Count;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Initialize a multiple producers single consumer queue
+//=============================================================================
+eERRORRESULT XCAN_InitMPSCQueue(XCAN_MPSCQueue* pQueue, void* pBuffer, uint32_t* pSequences, uint32_t elementSize, uint32_t size)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pQueue == NULL) || (pBuffer == NULL) || (pSequences == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if ((size == 0) || ((size & (size - 1u)) != 0) || (elementSize == 0)) return ERR__PARAMETER_ERROR; // The queue size shall be a power of 2
+  pQueue->Buffer      = (uint8_t*)pBuffer;
+  pQueue->Sequences   = pSequences;
+  pQueue->Mask        = size - 1u;
+  pQueue->ElementSize = elementSize;
+  pQueue->Head        = 0;
+  pQueue->Tail        = 0;
+  for (uint32_t zElt = 0; zElt < size; ++zElt) pSequences[zElt] = zElt;                   // Each element is free for the push at its index
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Push an element in a multiple producers single consumer queue
+//=============================================================================
+eERRORRESULT XCAN_PushMPSCQueue(XCAN_MPSCQueue* pQueue, const void* pElement)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pQueue == NULL) || (pElement == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  uint32_t Head = XCAN_LOAD_RELAXED(&pQueue->Head);
+  while (true)
+  {
+    const uint32_t Sequence = XCAN_LOAD_ACQUIRE(&pQueue->Sequences[Head & pQueue->Mask]);
+    const int32_t Diff = (int32_t)(Sequence - Head);
+    if (Diff == 0)                                                                         // The element is free, try to reserve it
+    {
+      if (__atomic_compare_exchange_n(&pQueue->Head, &Head, Head + 1u, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+    }                                                                                      // Else Head has been updated with the current value
+    else if (Diff < 0) return ERR__BUFFER_FULL;                                            // The element has not been popped yet
+    else Head = XCAN_LOAD_RELAXED(&pQueue->Head);                                          // Another producer took this element
+  }
+  memcpy(&pQueue->Buffer[(Head & pQueue->Mask) * pQueue->ElementSize], pElement, pQueue->ElementSize);
+  XCAN_STORE_RELEASE(&pQueue->Sequences[Head & pQueue->Mask], Head + 1u);                  // Publish the element
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Pop elements from a multiple producers single consumer queue
+//=============================================================================
+eERRORRESULT XCAN_PopMPSCQueue(XCAN_MPSCQueue* pQueue, void* pElements, size_t maxCount, size_t* pPoppedCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pQueue == NULL) || (pElements == NULL) || (pPoppedCount == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  uint32_t Tail = pQueue->Tail;                                                            // Only written by this consumer
+  uint8_t* pDst = (uint8_t*)pElements;
+  size_t Count = 0;
+  while (Count < maxCount)
+  {
+    uint32_t* pSequence = &pQueue->Sequences[Tail & pQueue->Mask];
+    if (XCAN_LOAD_ACQUIRE(pSequence) != (Tail + 1u)) break;                                // Not yet written by its producer
+    memcpy(&pDst[Count * pQueue->ElementSize], &pQueue->Buffer[(Tail & pQueue->Mask) * pQueue->ElementSize], pQueue->ElementSize);
+    XCAN_STORE_RELEASE(pSequence, Tail + pQueue->Mask + 1u);                               // Free the element for the push of the next lap
+    ++Tail;
+    ++Count;
+  }
+  pQueue->Tail = Tail;
+  *pPoppedCount = Count;
+  return ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
@@ -0,0 +1,185 @@
+/*!*****************************************************************************
+ * @file    XCAN_LockFreeQueue.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Lock-free queues between interrupt context and application threads
+ * @details
+ * Bounded ring queues of fixed size elements without lock, to move the
+ *   messages between the interrupt handler and the threads of the application
+ *   without priority inversion:
+ *   - SPSC: one producer, one consumer (RX messages from the interrupt handler
+ *     to the consumer thread)
+ *   - MPSC: many producers, one consumer (messages of many threads to the one
+ *     thread that feeds a TX FIFO Queue)
+ * The head and tail indexes are on separate cache lines so that the producers
+ *   and the consumer do not invalidate each other cache lines on each access.
+ * The queue sizes are powers of 2, XCAN_GetLockFreeQueueSize() gives the
+ *   size that holds a whole RX or TX FIFO Queue of MaxDesc descriptors.
+ * The queues use the GCC/Clang __atomic builtins.
+ * Configuration (in Conf_XCAN.h):
+ *   - XCAN_CACHE_LINE_SIZE: size in bytes of a cache line of the target (64 by default)
+ ******************************************************************************/
+/* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#ifndef XCAN_LOCKFREEQUEUE_H_INC
+#define XCAN_LOCKFREEQUEUE_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include "XCAN.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+  extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#ifndef XCAN_CACHE_LINE_SIZE
+#  define XCAN_CACHE_LINE_SIZE  ( 64u ) //!< Size in bytes of a cache line of the target
+#endif
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// XCAN Lock-free queues
+//********************************************************************************************************************
+
+//! Single producer single consumer queue structure (Managed by the queue functions)
+typedef struct XCAN_SPSCQueue
+{
+  uint8_t* Buffer;                                             //!< Elements of the queue, Size * ElementSize bytes
+  uint32_t Mask;                                               //!< Queue size - 1
+  uint32_t ElementSize;                                        //!< Size in bytes of an element
+  uint8_t _Pad0[XCAN_CACHE_LINE_SIZE];
+  uint32_t Head;                                               //!< Free running index of the next element to push. Written by the producer only
+  uint32_t CachedTail;                                         //!< Last Tail read by the producer
+  uint8_t _Pad1[XCAN_CACHE_LINE_SIZE - (2 * sizeof(uint32_t))];
+  uint32_t Tail;                                               //!< Free running index of the next element to pop. Written by the consumer only
+  uint32_t CachedHead;                                         //!< Last Head read by the consumer
+  uint8_t _Pad2[XCAN_CACHE_LINE_SIZE - (2 * sizeof(uint32_t))];
+} XCAN_SPSCQueue;
+
+//! Multiple producers single consumer queue structure (Managed by the queue functions)
+typedef struct XCAN_MPSCQueue
+{
+  uint8_t* Buffer;                                             //!< Elements of the queue, Size * ElementSize bytes
+  uint32_t* Sequences;                                         //!< Sequence of each element, it tells if the element is free or written
+  uint32_t Mask;                                               //!< Queue size - 1
+  uint32_t ElementSize;                                        //!< Size in bytes of an element
+  uint8_t _Pad0[XCAN_CACHE_LINE_SIZE];
+  uint32_t Head;                                               //!< Free running index of the next element to push. Shared by the producers
+  uint8_t _Pad1[XCAN_CACHE_LINE_SIZE - sizeof(uint32_t)];
+  uint32_t Tail;                                               //!< Free running index of the next element to pop. Written by the consumer only
+  uint8_t _Pad2[XCAN_CACHE_LINE_SIZE - sizeof(uint32_t)];
+} XCAN_MPSCQueue;
+
+//-----------------------------------------------------------------------------
+
+
+
+/*! @brief Get the lock-free queue size that holds a whole RX or TX FIFO Queue
+ *
+ * @param[in] maxDesc Is the count of descriptors of the FIFO Queue (MaxDesc programmed in RX_FQ_SIZEn or TX_FQ_SIZEn)
+ * @return Returns the smallest power of 2 that is at least maxDesc
+ */
+uint32_t XCAN_GetLockFreeQueueSize(uint16_t maxDesc);
+
+/*! @brief Initialize a single producer single consumer queue
+ *
+ * @param[out] *pQueue Is the queue to initialize
+ * @param[in] *pBuffer Is the memory of the elements, size * elementSize bytes
+ * @param[in] elementSize Is the size in bytes of an element
+ * @param[in] size Is the count of elements of the queue, must be a power of 2
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_InitSPSCQueue(XCAN_SPSCQueue* pQueue, void* pBuffer, uint32_t elementSize, uint32_t size);
+
+/*! @brief Push elements in a single producer single consumer queue
+ *
+ * Shall only be called by the producer. The elements are published all at once
+ * @param[in] *pQueue Is the queue to use
+ * @param[in] *pElements Is the elements to push
+ * @param[in] count Is the count of elements to push
+ * @param[out] *pPushedCount Is where the count of elements pushed will be stored. Can be NULL
+ * @return Returns an #eERRORRESULT value enum, ERR__BUFFER_FULL if not all the elements have been pushed
+ */
+eERRORRESULT XCAN_PushSPSCQueue(XCAN_SPSCQueue* pQueue, const void* pElements, size_t count, size_t* pPushedCount);
+
+/*! @brief Pop elements from a single producer single consumer queue
+ *
+ * Shall only be called by the consumer. The elements are freed all at once
+ * @param[in] *pQueue Is the queue to use
+ * @param[out] *pElements Is the array where the elements will be stored
+ * @param[in] maxCount Is the count of elements of the pElements array
+ * @param[out] *pPoppedCount Is where the count of elements popped will be stored
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_PopSPSCQueue(XCAN_SPSCQueue* pQueue, void* pElements, size_t maxCount, size_t* pPoppedCount);
+
+/*! @brief Initialize a multiple producers single consumer queue
+ *
+ * @param[out] *pQueue Is the queue to initialize
+ * @param[in] *pBuffer Is the memory of the elements, size * elementSize bytes
+ * @param[in] *pSequences Is the memory of the sequences, size elements
+ * @param[in] elementSize Is the size in bytes of an element
+ * @param[in] size Is the count of elements of the queue, must be a power of 2
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_InitMPSCQueue(XCAN_MPSCQueue* pQueue, void* pBuffer, uint32_t* pSequences, uint32_t elementSize, uint32_t size);
+
+/*! @brief Push an element in a multiple producers single consumer queue
+ *
+ * Can be called by many producers at once. A producer only reserves its element with a compare and swap, it never waits for another producer
+ * @param[in] *pQueue Is the queue to use
+ * @param[in] *pElement Is the element to push
+ * @return Returns an #eERRORRESULT value enum, ERR__BUFFER_FULL if the queue is full
+ */
+eERRORRESULT XCAN_PushMPSCQueue(XCAN_MPSCQueue* pQueue, const void* pElement);
+
+/*! @brief Pop elements from a multiple producers single consumer queue
+ *
+ * Shall only be called by the consumer. The pop stops at the first element reserved by a producer but not yet written
+ * @param[in] *pQueue Is the queue to use
+ * @param[out] *pElements Is the array where the elements will be stored
+ * @param[in] maxCount Is the count of elements of the pElements array
+ * @param[out] *pPoppedCount Is where the count of elements popped will be stored
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_PopMPSCQueue(XCAN_MPSCQueue* pQueue, void* pElements, size_t maxCount, size_t* pPoppedCount);
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* XCAN_LOCKFREEQUEUE_H_INC */
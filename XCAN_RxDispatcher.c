@@ -0,0 +1,155 @@
+/*!*****************************************************************************
+ * @file    XCAN_RxDispatcher.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN RX messages dispatcher by filter index
+ * @details
+ * The routing of a message costs one table read with its filter index, the
+ *   match of its ID has already been done by the X_CAN filters
+ ******************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "XCAN_RxDispatcher.h"
+#include <string.h>
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// Initialize the RX dispatcher
+//=============================================================================
+eERRORRESULT XCAN_InitRxDispatcher(XCAN_RxDispatcher* pDisp, const XCAN_RxDispatcherConfig* pConf)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pDisp == NULL) || (pConf == NULL)) return ERR__PARAMETER_ERROR;
+  if ((pConf->Subscribers == NULL) || (pConf->SubscribersState == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if ((pConf->SubscriberCount == 0) || (pConf->SubscriberCount == XCAN_RX_NO_SUBSCRIBER)) return ERR__PARAMETER_ERROR;
+  if ((pConf->NoMatchSubscriber != XCAN_RX_NO_SUBSCRIBER) && (pConf->NoMatchSubscriber >= pConf->SubscriberCount)) return ERR__PARAMETER_ERROR;
+  if ((pConf->BlackListSubscriber != XCAN_RX_NO_SUBSCRIBER) && (pConf->BlackListSubscriber >= pConf->SubscriberCount)) return ERR__PARAMETER_ERROR;
+
+  for (size_t zSub = 0; zSub < pConf->SubscriberCount; ++zSub)
+  {
+    const XCAN_RxSubscriberConfig* pSubConf = &pConf->Subscribers[zSub];
+    XCAN_RxSubscriber* pSub = &pConf->SubscribersState[zSub];
+    if (pSubConf->Queue == NULL) return ERR__PARAMETER_ERROR;
+    if ((pSubConf->QueueSize == 0) || ((pSubConf->QueueSize & (pSubConf->QueueSize - 1u)) != 0)) return ERR__PARAMETER_ERROR; // The queue size shall be a power of 2
+    if ((pSubConf->PayloadCopies != NULL) && (pSubConf->PayloadCopySize == 0)) return ERR__PARAMETER_ERROR;
+    pSub->Queue           = pSubConf->Queue;
+    pSub->QueueMask       = pSubConf->QueueSize - 1u;
+    pSub->Head            = 0;
+    pSub->Tail            = 0;
+    pSub->Overflows       = 0;
+    pSub->PayloadCopies   = pSubConf->PayloadCopies;
+    pSub->PayloadCopySize = pSubConf->PayloadCopySize;
+    pSub->Oversized       = 0;
+  }
+  pDisp->Subscribers         = pConf->SubscribersState;
+  pDisp->SubscriberCount     = pConf->SubscriberCount;
+  pDisp->NoMatchSubscriber   = pConf->NoMatchSubscriber;
+  pDisp->BlackListSubscriber = pConf->BlackListSubscriber;
+  pDisp->Unrouted            = 0;
+  memset(&pDisp->FilterSubscriber[0], XCAN_RX_NO_SUBSCRIBER, sizeof(pDisp->FilterSubscriber));
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Set the subscriber of a filter index
+//=============================================================================
+eERRORRESULT XCAN_SubscribeRxFilter(XCAN_RxDispatcher* pDisp, uint8_t filterIndex, uint8_t subscriber)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pDisp == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if ((subscriber != XCAN_RX_NO_SUBSCRIBER) && (subscriber >= pDisp->SubscriberCount)) return ERR__PARAMETER_ERROR;
+  pDisp->FilterSubscriber[filterIndex] = subscriber;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Dispatch RX messages to the queues of their subscribers
+//=============================================================================
+eERRORRESULT XCAN_DispatchRxMessages(XCAN_RxDispatcher* pDisp, const XCAN_RxMessageView* pViews, size_t count, size_t* pDispatchedCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pDisp == NULL) || ((pViews == NULL) && (count > 0))) return ERR__PARAMETER_ERROR;
+#endif
+  if (pDisp->Subscribers == NULL) return ERR__CONFIGURATION;
+  size_t Dispatched = 0;
+  for (size_t zMsg = 0; zMsg < count; ++zMsg)
+  {
+    const uint32_t R1 = pViews[zMsg].R1;
+    uint8_t Subscriber;
+    if ((R1 & XCAN_R1_BLK) > 0) Subscriber = pDisp->BlackListSubscriber;
+    else if ((R1 & XCAN_R1_FM) == 0) Subscriber = pDisp->NoMatchSubscriber;
+    else Subscriber = pDisp->FilterSubscriber[(R1 & XCAN_R1_FIDX_Mask) >> XCAN_R1_FIDX_Pos];
+    if (Subscriber == XCAN_RX_NO_SUBSCRIBER) { pDisp->Unrouted++; continue; }
+
+    XCAN_RxSubscriber* pSub = &pDisp->Subscribers[Subscriber];
+    if ((uint16_t)(pSub->Head - pSub->Tail) > pSub->QueueMask) { pSub->Overflows++; continue; } // The queue of the subscriber is full, drop the message
+    XCAN_RxMessageView* pView = &pSub->Queue[pSub->Head & pSub->QueueMask];
+    *pView = pViews[zMsg];
+    if (pSub->PayloadCopies != NULL)                                                       // Copy-out mode: the view shall not point in the data container anymore
+    {
+      if (((size_t)pView->PayloadPartSize[0] + pView->PayloadPartSize[1]) > pSub->PayloadCopySize) { pSub->Oversized++; continue; }
+      uint8_t* pCopy = &pSub->PayloadCopies[(size_t)(pSub->Head & pSub->QueueMask) * pSub->PayloadCopySize];
+      if (pView->PayloadPartSize[0] > 0) memcpy(&pCopy[0], pView->Payload[0], pView->PayloadPartSize[0]);
+      if (pView->PayloadPartSize[1] > 0) memcpy(&pCopy[pView->PayloadPartSize[0]], pView->Payload[1], pView->PayloadPartSize[1]);
+      pView->Payload[0]         = pCopy;
+      pView->Payload[1]         = NULL;
+      pView->PayloadPartSize[0] = pView->PayloadPartSize[0] + pView->PayloadPartSize[1];
+      pView->PayloadPartSize[1] = 0;
+    }
+    pSub->Head++;
+    ++Dispatched;
+  }
+  if (pDispatchedCount != NULL) *pDispatchedCount = Dispatched;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Pop the messages of a subscriber queue
+//=============================================================================
+eERRORRESULT XCAN_PopRxSubscriberMessages(XCAN_RxDispatcher* pDisp, uint8_t subscriber, XCAN_RxMessageView* pViews, size_t maxCount, size_t* pPoppedCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pDisp == NULL) || (pViews == NULL) || (pPoppedCount == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (subscriber >= pDisp->SubscriberCount) return ERR__PARAMETER_ERROR;
+  XCAN_RxSubscriber* pSub = &pDisp->Subscribers[subscriber];
+  size_t Popped = 0;
+  while ((Popped < maxCount) && (pSub->Head != pSub->Tail))
+  {
+    pViews[Popped] = pSub->Queue[pSub->Tail & pSub->QueueMask];
+    pSub->Tail++;
+    ++Popped;
+  }
+  *pPoppedCount = Popped;
+  return ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
@@ -0,0 +1,171 @@
+/*!*****************************************************************************
+ * @file    XCAN_RxDispatcher.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN RX messages dispatcher by filter index
+ * @details
+ * Route the RX messages to the queues of their subscribers with the filter
+ *   index (R1.FIDX) reported by the X_CAN. The filter element that accepted a
+ *   message already identifies its consumer, so the dispatcher uses FIDX as a
+ *   direct index in a table of subscribers instead of looking up the message ID.
+ * The messages without filter match (R1.FM = 0) and the messages that matched
+ *   a black list element (R1.BLK = 1) have their own subscribers.
+ * By default the queues hold the views of the messages: the payloads stay
+ *   where the driver received them and a view is only valid until its message
+ *   is released (XCAN_ReleaseRxContinuousMessages()) or its buffers freed. The
+ *   release being in order, the messages of a read shall all be popped (and
+ *   processed) by their subscribers before they are released.
+ * In copy-out mode (PayloadCopies set for a subscriber), the payloads are
+ *   copied in the storage of the subscriber when dispatched, the messages can
+ *   be released right after XCAN_DispatchRxMessages()
+ ******************************************************************************/
+/* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#ifndef XCAN_RXDISPATCHER_H_INC
+#define XCAN_RXDISPATCHER_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include "XCAN.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+  extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define XCAN_RX_FILTER_INDEX_COUNT  ( 256u ) //!< Count of filter indexes that can be reported in R1.FIDX
+#define XCAN_RX_NO_SUBSCRIBER       ( 0xFFu ) //!< Subscriber index of the messages that are not routed (dropped)
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// XCAN RX Dispatcher
+//********************************************************************************************************************
+
+//! RX subscriber configuration structure
+typedef struct XCAN_RxSubscriberConfig
+{
+  XCAN_RxMessageView* Queue; //!< Queue ring of the subscriber, QueueSize elements
+  uint16_t QueueSize;        //!< Count of messages of the queue ring, must be a power of 2
+  uint8_t* PayloadCopies;    //!< Copy-out mode: payload storage of each message of the queue ring, QueueSize * PayloadCopySize bytes. NULL to queue views pointing in the data container
+  uint16_t PayloadCopySize;  //!< Copy-out mode: maximum payload size in bytes of a message (64 for CAN-FD, up to 2048 for CAN-XL)
+} XCAN_RxSubscriberConfig;
+
+//! RX subscriber state (Managed by the dispatcher)
+typedef struct XCAN_RxSubscriber
+{
+  XCAN_RxMessageView* Queue; //!< Queue ring of the subscriber
+  uint16_t QueueMask;        //!< Queue ring size - 1
+  uint16_t Head;             //!< Free running index of the next message to push
+  uint16_t Tail;             //!< Free running index of the next message to pop
+  uint32_t Overflows;        //!< Count of messages dropped because the queue was full
+  uint8_t* PayloadCopies;    //!< Payload storage of the queue ring in copy-out mode, NULL if not used
+  uint16_t PayloadCopySize;  //!< Payload storage size of a message in copy-out mode
+  uint32_t Oversized;        //!< Count of messages dropped in copy-out mode because the payload is larger than PayloadCopySize
+} XCAN_RxSubscriber;
+
+//! RX dispatcher configuration structure
+typedef struct XCAN_RxDispatcherConfig
+{
+  const XCAN_RxSubscriberConfig* Subscribers; //!< Configuration of each subscriber, SubscriberCount elements
+  XCAN_RxSubscriber* SubscribersState;        //!< State of each subscriber, SubscriberCount elements
+  uint8_t SubscriberCount;                    //!< Count of subscribers (1 to 255)
+  uint8_t NoMatchSubscriber;                  //!< Subscriber of the messages accepted without filter match (R1.FM = 0). XCAN_RX_NO_SUBSCRIBER to drop them
+  uint8_t BlackListSubscriber;                //!< Subscriber of the messages that matched a black list element (R1.BLK = 1). XCAN_RX_NO_SUBSCRIBER to drop them
+} XCAN_RxDispatcherConfig;
+
+//! RX dispatcher structure
+typedef struct XCAN_RxDispatcher
+{
+  XCAN_RxSubscriber* Subscribers;                          //!< Subscribers states
+  uint8_t SubscriberCount;                                 //!< Count of subscribers
+  uint8_t NoMatchSubscriber;                               //!< Subscriber of the messages without filter match
+  uint8_t BlackListSubscriber;                             //!< Subscriber of the messages that matched a black list element
+  uint8_t FilterSubscriber[XCAN_RX_FILTER_INDEX_COUNT];    //!< Subscriber of each filter index. XCAN_RX_NO_SUBSCRIBER if the filter is not subscribed
+  uint32_t Unrouted;                                       //!< Count of messages dropped because no subscriber is set for them
+} XCAN_RxDispatcher;
+
+//-----------------------------------------------------------------------------
+
+
+
+/*! @brief Initialize the RX dispatcher
+ *
+ * No filter index is subscribed after the initialization
+ * @param[out] *pDisp Is the dispatcher to initialize
+ * @param[in] *pConf Is the configuration of the dispatcher
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_InitRxDispatcher(XCAN_RxDispatcher* pDisp, const XCAN_RxDispatcherConfig* pConf);
+
+/*! @brief Set the subscriber of a filter index
+ *
+ * The filter index is the index of the filter element reported in R1.FIDX when it matches
+ * @param[in] *pDisp Is the dispatcher to use
+ * @param[in] filterIndex Is the filter index to route
+ * @param[in] subscriber Is the subscriber of the messages accepted by this filter. XCAN_RX_NO_SUBSCRIBER to drop them
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_SubscribeRxFilter(XCAN_RxDispatcher* pDisp, uint8_t filterIndex, uint8_t subscriber);
+
+/*! @brief Dispatch RX messages to the queues of their subscribers
+ *
+ * Each message is routed with its R1 word: black list, no filter match or filter index. The message views are copied in the queues,
+ * and the payloads too for the subscribers in copy-out mode. A message routed to a full queue or to no subscriber is dropped and counted
+ * @param[in] *pDisp Is the dispatcher to use
+ * @param[in] *pViews Is the messages to dispatch
+ * @param[in] count Is the count of messages to dispatch
+ * @param[out] *pDispatchedCount Is where the count of messages pushed in a queue will be stored. Can be NULL
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_DispatchRxMessages(XCAN_RxDispatcher* pDisp, const XCAN_RxMessageView* pViews, size_t count, size_t* pDispatchedCount);
+
+/*! @brief Pop the messages of a subscriber queue
+ *
+ * In copy-out mode, the payload of a popped message is in a single part and stays valid until the next call of XCAN_DispatchRxMessages()
+ * @param[in] *pDisp Is the dispatcher to use
+ * @param[in] subscriber Is the subscriber to read
+ * @param[out] *pViews Is the array where the messages will be stored
+ * @param[in] maxCount Is the count of elements of the pViews array
+ * @param[out] *pPoppedCount Is where the count of messages popped will be stored
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_PopRxSubscriberMessages(XCAN_RxDispatcher* pDisp, uint8_t subscriber, XCAN_RxMessageView* pViews, size_t maxCount, size_t* pPoppedCount);
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* XCAN_RXDISPATCHER_H_INC */
@@ -0,0 +1,231 @@
+/*!*****************************************************************************
+ * @file    XCAN_SoftFilter.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Software RX filter for the subscriptions beyond the X_CAN filters
+ * @details
+ * The binary search halves the intervals count at each step with a conditional
+ *   move, its duration only depends on the intervals count
+ ******************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "XCAN_SoftFilter.h"
+#include <string.h>
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// [STATIC] Compare 2 intervals by first ID
+//=============================================================================
+static int __XCAN_CompareSoftFilterIntervals(const void* pA, const void* pB)
+{
+  const XCAN_SoftFilterInterval* pIntervalA = (const XCAN_SoftFilterInterval*)pA;
+  const XCAN_SoftFilterInterval* pIntervalB = (const XCAN_SoftFilterInterval*)pB;
+  if (pIntervalA->First != pIntervalB->First) return (pIntervalA->First < pIntervalB->First ? -1 : 1);
+  return 0;
+}
+
+
+
+//=============================================================================
+// [STATIC] Add a subscription to the standard IDs bitmap
+//=============================================================================
+static void __XCAN_AddSoftFilterSID(XCAN_SoftFilter* pFilter, const XCAN_RxSubscription* pSub)
+{
+  for (uint32_t Id = 0; Id <= XCAN_RX_FILTER_SID_MAX; ++Id)
+  {
+    bool Match;
+    switch (pSub->Type)
+    {
+      case XCAN_RX_FILTER_EXACT: Match = (Id == pSub->ID1); break;
+      case XCAN_RX_FILTER_RANGE: Match = (Id >= pSub->ID1) && (Id <= pSub->ID2); break;
+      default                  : Match = ((Id & pSub->ID2) == (pSub->ID1 & pSub->ID2)); break;
+    }
+    if (Match) pFilter->SIDBitmap[Id >> 5] |= (1u << (Id & 0x1Fu));
+  }
+}
+
+
+
+//=============================================================================
+// Build a software RX filter
+//=============================================================================
+eERRORRESULT XCAN_BuildSoftFilter(XCAN_SoftFilter* pFilter, const XCAN_SoftFilterConfig* pConf)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pFilter == NULL) || (pConf == NULL)) return ERR__PARAMETER_ERROR;
+  if ((pConf->Subscriptions == NULL) && (pConf->SubscriptionCount > 0)) return ERR__PARAMETER_ERROR;
+  if ((pConf->Intervals == NULL) && (pConf->MaxIntervals > 0)) return ERR__PARAMETER_ERROR;
+  if ((pConf->Masks == NULL) && (pConf->MaxMasks > 0)) return ERR__PARAMETER_ERROR;
+#endif
+  memset(&pFilter->SIDBitmap[0], 0, sizeof(pFilter->SIDBitmap));
+  pFilter->Intervals     = pConf->Intervals;
+  pFilter->IntervalCount = 0;
+  pFilter->Masks         = pConf->Masks;
+  pFilter->MaskCount     = 0;
+
+  //--- Fill the bitmap and collect the extended IDs intervals ---
+  for (size_t zSub = 0; zSub < pConf->SubscriptionCount; ++zSub)
+  {
+    const XCAN_RxSubscription* pSub = &pConf->Subscriptions[zSub];
+    if (pSub->BlackList) continue;                                                         // Only the accepted IDs are in the software filter
+    const uint32_t IDMax = (pSub->Extended ? XCAN_RX_FILTER_EID_MAX : XCAN_RX_FILTER_SID_MAX);
+    if (pSub->ID1 > IDMax) return ERR__OUT_OF_RANGE;
+    if ((pSub->Type == XCAN_RX_FILTER_RANGE) && ((pSub->ID2 > IDMax) || (pSub->ID2 < pSub->ID1))) return ERR__OUT_OF_RANGE;
+    if ((pSub->Type != XCAN_RX_FILTER_EXACT) && (pSub->Type != XCAN_RX_FILTER_RANGE) && (pSub->Type != XCAN_RX_FILTER_MASK)) return ERR__PARAMETER_ERROR;
+    if (pSub->Extended == false) { __XCAN_AddSoftFilterSID(pFilter, pSub); continue; }
+
+    XCAN_SoftFilterInterval Interval = { pSub->ID1, (pSub->Type == XCAN_RX_FILTER_RANGE ? pSub->ID2 : pSub->ID1) };
+    if (pSub->Type == XCAN_RX_FILTER_MASK)
+    {
+      const uint32_t Mask = pSub->ID2 & IDMax;
+      const uint32_t Free = ~Mask & IDMax;                                                 // Bits of the ID not checked
+      if ((Free & (Free + 1u)) != 0)                                                       // The mask is not an interval
+      {
+        if (pFilter->MaskCount >= pConf->MaxMasks) return ERR__BUFFER_FULL;
+        pFilter->Masks[pFilter->MaskCount].ID   = pSub->ID1 & Mask;
+        pFilter->Masks[pFilter->MaskCount].Mask = Mask;
+        pFilter->MaskCount++;
+        continue;
+      }
+      Interval.First = pSub->ID1 & Mask;
+      Interval.Last  = Interval.First | Free;
+    }
+    if (pFilter->IntervalCount >= pConf->MaxIntervals) return ERR__BUFFER_FULL;
+    pFilter->Intervals[pFilter->IntervalCount++] = Interval;
+  }
+
+  //--- Sort and merge the intervals ---
+  if (pFilter->IntervalCount == 0) return ERR_OK;
+  qsort(pFilter->Intervals, pFilter->IntervalCount, sizeof(XCAN_SoftFilterInterval), __XCAN_CompareSoftFilterIntervals);
+  size_t Count = 1;
+  for (size_t zInt = 1; zInt < pFilter->IntervalCount; ++zInt)
+  {
+    XCAN_SoftFilterInterval* pPrevious = &pFilter->Intervals[Count - 1u];
+    const XCAN_SoftFilterInterval* pInterval = &pFilter->Intervals[zInt];
+    if (pInterval->First <= (pPrevious->Last + 1u))                                        // Overlapping or adjacent
+    {
+      if (pInterval->Last > pPrevious->Last) pPrevious->Last = pInterval->Last;
+    }
+    else pFilter->Intervals[Count++] = *pInterval;
+  }
+  pFilter->IntervalCount = Count;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// [STATIC] Check if an extended ID is accepted by a software RX filter
+//=============================================================================
+static inline bool __XCAN_SoftFilterMatchEID(const XCAN_SoftFilter* pFilter, uint32_t id)
+{
+  //--- Branchless binary search of the last interval starting at or before the ID ---
+  const XCAN_SoftFilterInterval* pBase = pFilter->Intervals;
+  size_t Count = pFilter->IntervalCount;
+  if (Count > 0)
+  {
+    while (Count > 1)
+    {
+      const size_t Half = Count / 2u;
+      pBase = (pBase[Half].First <= id ? &pBase[Half] : pBase);
+      Count -= Half;
+    }
+    if ((id >= pBase->First) & (id <= pBase->Last)) return true;
+  }
+
+  //--- Then the masks ---
+  for (size_t zMask = 0; zMask < pFilter->MaskCount; ++zMask)
+    if ((id & pFilter->Masks[zMask].Mask) == pFilter->Masks[zMask].ID) return true;
+  return false;
+}
+
+
+
+//=============================================================================
+// [STATIC] Check if a standard ID is accepted by a software RX filter
+//=============================================================================
+static inline bool __XCAN_SoftFilterMatchSID(const XCAN_SoftFilter* pFilter, uint32_t id)
+{
+  id &= XCAN_RX_FILTER_SID_MAX;
+  return ((pFilter->SIDBitmap[id >> 5] >> (id & 0x1Fu)) & 1u) > 0;
+}
+
+
+
+//=============================================================================
+// Check if a message ID is accepted by a software RX filter
+//=============================================================================
+bool XCAN_SoftFilterMatch(const XCAN_SoftFilter* pFilter, bool extended, uint32_t id)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pFilter == NULL) return false;
+#endif
+  return (extended ? __XCAN_SoftFilterMatchEID(pFilter, id) : __XCAN_SoftFilterMatchSID(pFilter, id));
+}
+
+
+
+//=============================================================================
+// Check a batch of decoded RX message headers with a software RX filter
+//=============================================================================
+eERRORRESULT XCAN_SoftFilterBatch(const XCAN_SoftFilter* pFilter, const uint32_t* pIDs, const uint16_t* pFlags, size_t count, uint8_t* pAccepted, size_t* pAcceptedCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pFilter == NULL) || (pIDs == NULL) || (pFlags == NULL) || (pAccepted == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  size_t Accepted = 0;
+  for (size_t zMsg = 0; zMsg < count; ++zMsg)
+  {
+    const uint32_t Id = pIDs[zMsg];
+    uint8_t Match = (uint8_t)__XCAN_SoftFilterMatchSID(pFilter, Id);                       // Always done, it is only a load
+    if ((pFlags[zMsg] & XCAN_RXH_EXTENDED_ID) > 0) Match = (uint8_t)__XCAN_SoftFilterMatchEID(pFilter, Id);
+    pAccepted[zMsg] = Match;
+    Accepted += Match;
+  }
+  if (pAcceptedCount != NULL) *pAcceptedCount = Accepted;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Keep only the RX messages accepted by a software RX filter
+//=============================================================================
+eERRORRESULT XCAN_SoftFilterRxMessages(const XCAN_SoftFilter* pFilter, XCAN_RxMessageView* pViews, size_t count, size_t* pKeptCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pFilter == NULL) || (pViews == NULL) || (pKeptCount == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  size_t Kept = 0;
+  for (size_t zMsg = 0; zMsg < count; ++zMsg)
+  {
+    const bool Extended = ((pViews[zMsg].ControlFlags & XCAN_EXTENDED_MESSAGE_ID) > 0);
+    if (XCAN_SoftFilterMatch(pFilter, Extended, pViews[zMsg].MessageID) == false) continue;
+    if (Kept != zMsg) pViews[Kept] = pViews[zMsg];
+    ++Kept;
+  }
+  *pKeptCount = Kept;
+  return ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
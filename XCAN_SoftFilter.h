@@ -0,0 +1,155 @@
+/*!*****************************************************************************
+ * @file    XCAN_SoftFilter.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Software RX filter for the subscriptions beyond the X_CAN filters
+ * @details
+ * When the subscriptions do not fit in the RX filter elements (NB_FE is 255 at
+ *   most), the non matching messages are accepted (ANMF) in the default RX FIFO
+ *   Queue and this filter rejects the ones not subscribed, in software.
+ * The lookup of an ID does not use any hash:
+ *   - standard IDs (and CAN-XL priority IDs): one bit of a 2048-bits bitmap
+ *   - extended IDs: a binary search without branch in the sorted disjoint
+ *     intervals of the subscriptions, then the masks that are not intervals
+ *     (expected to be few) are checked one by one
+ ******************************************************************************/
+/* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#ifndef XCAN_SOFTFILTER_H_INC
+#define XCAN_SOFTFILTER_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include "XCAN_FilterCompiler.h"
+#include "XCAN_HeaderDecoder.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+  extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define XCAN_SOFT_FILTER_SID_WORDS  ( (XCAN_RX_FILTER_SID_MAX + 1u) / 32u ) //!< Count of 32-bits words of the standard IDs bitmap
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// XCAN Software RX Filter
+//********************************************************************************************************************
+
+//! Extended IDs interval structure
+typedef struct XCAN_SoftFilterInterval
+{
+  uint32_t First; //!< First ID of the interval
+  uint32_t Last;  //!< Last ID of the interval
+} XCAN_SoftFilterInterval;
+
+//! Extended IDs mask structure
+typedef struct XCAN_SoftFilterMask
+{
+  uint32_t ID;   //!< ID bits checked
+  uint32_t Mask; //!< Bits of the ID checked
+} XCAN_SoftFilterMask;
+
+//! Software RX filter configuration structure
+typedef struct XCAN_SoftFilterConfig
+{
+  const XCAN_RxSubscription* Subscriptions; //!< Subscriptions to accept. The RX FIFO Queue of the subscriptions is not used, the black list subscriptions are ignored
+  size_t SubscriptionCount;                 //!< Count of subscriptions
+  XCAN_SoftFilterInterval* Intervals;       //!< Memory of the extended IDs intervals, MaxIntervals elements
+  size_t MaxIntervals;                      //!< Count of elements of the Intervals array
+  XCAN_SoftFilterMask* Masks;               //!< Memory of the extended IDs masks that are not intervals, MaxMasks elements. Can be NULL if not used
+  size_t MaxMasks;                          //!< Count of elements of the Masks array
+} XCAN_SoftFilterConfig;
+
+//! Software RX filter structure
+typedef struct XCAN_SoftFilter
+{
+  uint32_t SIDBitmap[XCAN_SOFT_FILTER_SID_WORDS]; //!< Accepted standard IDs, one bit per ID
+  XCAN_SoftFilterInterval* Intervals;             //!< Accepted extended IDs intervals, sorted and disjoint
+  size_t IntervalCount;                           //!< Count of intervals
+  XCAN_SoftFilterMask* Masks;                     //!< Accepted extended IDs masks
+  size_t MaskCount;                               //!< Count of masks
+} XCAN_SoftFilter;
+
+//-----------------------------------------------------------------------------
+
+
+
+/*! @brief Build a software RX filter
+ *
+ * @param[out] *pFilter Is the filter to build
+ * @param[in] *pConf Is the configuration of the filter
+ * @return Returns an #eERRORRESULT value enum, ERR__BUFFER_FULL if the intervals or the masks do not fit
+ */
+eERRORRESULT XCAN_BuildSoftFilter(XCAN_SoftFilter* pFilter, const XCAN_SoftFilterConfig* pConf);
+
+/*! @brief Check if a message ID is accepted by a software RX filter
+ *
+ * @param[in] *pFilter Is the filter to use
+ * @param[in] extended Is 'true' for an extended ID
+ * @param[in] id Is the message ID (right aligned)
+ * @return Returns 'true' if the ID is accepted, else 'false'
+ */
+bool XCAN_SoftFilterMatch(const XCAN_SoftFilter* pFilter, bool extended, uint32_t id);
+
+/*! @brief Check a batch of decoded RX message headers with a software RX filter
+ *
+ * The IDs and flags are the ones decoded by XCAN_DecodeRxHeaders()
+ * @param[in] *pFilter Is the filter to use
+ * @param[in] *pIDs Is the message IDs
+ * @param[in] *pFlags Is the flags of the messages (only XCAN_RXH_EXTENDED_ID is used)
+ * @param[in] count Is the count of messages
+ * @param[out] *pAccepted Is where the result of each message will be stored: 1 if accepted, else 0
+ * @param[out] *pAcceptedCount Is where the count of messages accepted will be stored. Can be NULL
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_SoftFilterBatch(const XCAN_SoftFilter* pFilter, const uint32_t* pIDs, const uint16_t* pFlags, size_t count, uint8_t* pAccepted, size_t* pAcceptedCount);
+
+/*! @brief Keep only the RX messages accepted by a software RX filter
+ *
+ * The accepted message views are moved at the beginning of the pViews array, in order. The messages shall still be released to the driver, all of them
+ * @param[in] *pFilter Is the filter to use
+ * @param[in,out] *pViews Is the messages to filter
+ * @param[in] count Is the count of messages
+ * @param[out] *pKeptCount Is where the count of messages accepted will be stored
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_SoftFilterRxMessages(const XCAN_SoftFilter* pFilter, XCAN_RxMessageView* pViews, size_t count, size_t* pKeptCount);
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* XCAN_SOFTFILTER_H_INC */
@@ -0,0 +1,241 @@
+/*!*****************************************************************************
+ * @file    XCAN_TimeSync.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN timestamps to host clock correlation
+ * @details
+ * The conversion factor Mult is a fixed point value with XCAN_TIME_SYNC_SHIFT
+ *   fractional bits, computed with a long division once per sample, so a
+ *   conversion close to the reference is only one 64-bits multiply and one shift. Farther timestamps use a 64x64 to 128-bits multiply
+ *   made of 4 32x32 to 64-bits multiplies.
+ ******************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "XCAN_TimeSync.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#if (XCAN_TIME_SYNC_SHIFT < 1) || (XCAN_TIME_SYNC_SHIFT > 63)
+#  error XCAN_TIME_SYNC_SHIFT shall be between 1 and 63
+#endif
+
+#define XCAN_TIME_SYNC_MAX_SCALED  ( UINT64_MAX >> XCAN_TIME_SYNC_SHIFT ) //!< Maximum value that can be shifted by XCAN_TIME_SYNC_SHIFT without overflow
+#define XCAN_PPB_PER_UNIT          ( 1000000000ll )                      //!< Parts per billion in a unit
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// [STATIC] Compute the fixed point factor (host / timestamp) << XCAN_TIME_SYNC_SHIFT
+//=============================================================================
+static uint64_t __XCAN_TimeSyncFactor(uint64_t host, uint64_t timestamp)
+{
+  if (timestamp == 0) return 0;
+  uint64_t Factor    = host / timestamp;
+  uint64_t Remainder = host % timestamp;
+  if (Factor > XCAN_TIME_SYNC_MAX_SCALED) return 0;                                        // The factor does not fit with XCAN_TIME_SYNC_SHIFT
+  for (size_t zBit = 0; zBit < XCAN_TIME_SYNC_SHIFT; ++zBit)                               // Binary long division of the remainder for the fractional bits
+  {
+    const bool Carry = ((Remainder >> 63) > 0);
+    Remainder <<= 1;
+    Factor    <<= 1;
+    if (Carry || (Remainder >= timestamp)) { Remainder -= timestamp; Factor |= 1u; }
+  }
+  return Factor;
+}
+
+
+
+//=============================================================================
+// [STATIC] Scale a timestamp distance to host ticks
+//=============================================================================
+static inline uint64_t __XCAN_TimeSyncScale(const XCAN_TimeSync* pSync, uint64_t delta)
+{
+  if (delta <= pSync->MaxFastDelta) return (delta * pSync->Mult) >> XCAN_TIME_SYNC_SHIFT;  // Fast path: the product fits in 64-bits
+
+  //--- 64x64 to 128-bits multiply ---
+  const uint64_t DeltaLo = delta & 0xFFFFFFFFu, DeltaHi = delta >> 32;
+  const uint64_t MultLo = pSync->Mult & 0xFFFFFFFFu, MultHi = pSync->Mult >> 32;
+  const uint64_t LoLo = DeltaLo * MultLo;
+  const uint64_t LoHi = DeltaLo * MultHi;
+  const uint64_t HiLo = DeltaHi * MultLo;
+  const uint64_t Mid  = (LoLo >> 32) + (LoHi & 0xFFFFFFFFu) + (HiLo & 0xFFFFFFFFu);
+  const uint64_t Lo   = (Mid << 32) | (LoLo & 0xFFFFFFFFu);
+  const uint64_t Hi   = (DeltaHi * MultHi) + (LoHi >> 32) + (HiLo >> 32) + (Mid >> 32);
+  return (Hi << (64 - XCAN_TIME_SYNC_SHIFT)) | (Lo >> XCAN_TIME_SYNC_SHIFT);              // The result wraps like the host clock if it does not fit in 64-bits
+}
+
+
+
+//=============================================================================
+// [STATIC] Convert one X_CAN timestamp to the host clock
+//=============================================================================
+static inline uint64_t __XCAN_TimestampToHost(const XCAN_TimeSync* pSync, uint64_t timestamp)
+{
+  if (timestamp >= pSync->RefTimestamp) return pSync->RefHost + __XCAN_TimeSyncScale(pSync, timestamp - pSync->RefTimestamp);
+  return pSync->RefHost - __XCAN_TimeSyncScale(pSync, pSync->RefTimestamp - timestamp);
+}
+
+
+
+//=============================================================================
+// [STATIC] Estimate the conversion factor and the reference from the samples window
+//=============================================================================
+static void __XCAN_UpdateTimeSync(XCAN_TimeSync* pSync)
+{
+  const XCAN_TimeSyncSample* pNewest = &pSync->Samples[pSync->Newest];
+  const size_t Oldest = ((size_t)pSync->Newest + pSync->WindowSize + 1u - pSync->Count) % pSync->WindowSize;
+
+  //--- Estimate the drift with the oldest and newest samples ---
+  if (pSync->Count >= XCAN_TIME_SYNC_WINDOW_MIN)
+  {
+    const uint64_t Mult = __XCAN_TimeSyncFactor(pNewest->Host - pSync->Samples[Oldest].Host, pNewest->Timestamp - pSync->Samples[Oldest].Timestamp);
+    if (Mult > 0) pSync->Mult = Mult;                                                      // Else keep the previous estimation
+  }
+  else pSync->Mult = pSync->NominalMult;
+  pSync->MaxFastDelta = UINT64_MAX / pSync->Mult;
+
+  //--- Filter the offset with the mean of the samples errors ---
+  pSync->RefTimestamp = pNewest->Timestamp;
+  pSync->RefHost      = pNewest->Host;
+  int64_t ErrorSum = 0;
+  for (size_t zSample = 0, Index = Oldest; zSample < pSync->Count; ++zSample, Index = (Index + 1u) % pSync->WindowSize)
+    ErrorSum += (int64_t)(pSync->Samples[Index].Host - __XCAN_TimestampToHost(pSync, pSync->Samples[Index].Timestamp));
+  pSync->RefHost += (uint64_t)(ErrorSum / (int64_t)pSync->Count);
+}
+
+
+
+//=============================================================================
+// Initialize a time synchronization
+//=============================================================================
+eERRORRESULT XCAN_InitTimeSync(XCAN_TimeSync* pSync, const XCAN_TimeSyncConfig* pConf)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pSync == NULL) || (pConf == NULL)) return ERR__PARAMETER_ERROR;
+  if (pConf->Samples == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (pConf->WindowSize < XCAN_TIME_SYNC_WINDOW_MIN) return ERR__PARAMETER_ERROR;
+  if ((pConf->TimestampHz == 0) || (pConf->HostHz == 0)) return ERR__PARAMETER_ERROR;
+  pSync->NominalMult = __XCAN_TimeSyncFactor(pConf->HostHz, pConf->TimestampHz);
+  if (pSync->NominalMult == 0) return ERR__CONFIGURATION;                                  // The nominal factor does not fit with XCAN_TIME_SYNC_SHIFT
+  pSync->Samples          = pConf->Samples;
+  pSync->WindowSize       = pConf->WindowSize;
+  pSync->Count            = 0;
+  pSync->Newest           = 0;
+  pSync->MaxSampleLatency = pConf->MaxSampleLatency;
+  pSync->Rejected         = 0;
+  pSync->Mult             = pSync->NominalMult;
+  pSync->MaxFastDelta     = UINT64_MAX / pSync->Mult;
+  pSync->RefTimestamp     = 0;
+  pSync->RefHost          = 0;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Add a paired sample to a time synchronization
+//=============================================================================
+eERRORRESULT XCAN_AddTimeSyncSample(XCAN_TimeSync* pSync, uint64_t hostBefore, uint64_t timestamp, uint64_t hostAfter)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pSync == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (pSync->Samples == NULL) return ERR__CONFIGURATION;
+  if (hostAfter < hostBefore) return ERR__PARAMETER_ERROR;
+  const uint64_t Latency = hostAfter - hostBefore;
+  if ((pSync->MaxSampleLatency > 0) && (Latency > pSync->MaxSampleLatency))               // The sample was interrupted, its host time is not accurate
+  {
+    pSync->Rejected++;
+    return ERR__OUT_OF_RANGE;
+  }
+  if (pSync->Count > 0)
+  {
+    const XCAN_TimeSyncSample* pNewest = &pSync->Samples[pSync->Newest];
+    if ((timestamp <= pNewest->Timestamp) || (hostBefore < pNewest->Host))                 // Both clocks shall be monotonic
+    {
+      pSync->Rejected++;
+      return ERR__OUT_OF_RANGE;
+    }
+    pSync->Newest = (uint8_t)((pSync->Newest + 1u) % pSync->WindowSize);
+  }
+  pSync->Samples[pSync->Newest].Timestamp = timestamp;
+  pSync->Samples[pSync->Newest].Host      = hostBefore + (Latency / 2u);
+  if (pSync->Count < pSync->WindowSize) pSync->Count++;
+  __XCAN_UpdateTimeSync(pSync);
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Convert a batch of X_CAN timestamps to the host clock
+//=============================================================================
+eERRORRESULT XCAN_ConvertTimestampsToHost(const XCAN_TimeSync* pSync, const uint64_t* pTimestamps, uint64_t* pHost, size_t count)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pSync == NULL) || (pTimestamps == NULL) || (pHost == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (pSync->Count == 0) return ERR__NOT_READY;
+  for (size_t zTs = 0; zTs < count; ++zTs) pHost[zTs] = __XCAN_TimestampToHost(pSync, pTimestamps[zTs]);
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Convert the timestamps of RX messages to the host clock
+//=============================================================================
+eERRORRESULT XCAN_ConvertRxTimestampsToHost(const XCAN_TimeSync* pSync, XCAN_RxMessageView* pViews, size_t count)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pSync == NULL) || (pViews == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (pSync->Count == 0) return ERR__NOT_READY;
+  for (size_t zView = 0; zView < count; ++zView) pViews[zView].Timestamp = __XCAN_TimestampToHost(pSync, pViews[zView].Timestamp);
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Get the estimated drift of the X_CAN timestamp source
+//=============================================================================
+eERRORRESULT XCAN_GetTimeSyncDrift(const XCAN_TimeSync* pSync, int32_t* pDriftPpb)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pSync == NULL) || (pDriftPpb == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (pSync->Count < XCAN_TIME_SYNC_WINDOW_MIN) return ERR__NOT_READY;
+  const int64_t Diff = (int64_t)(pSync->Mult - pSync->NominalMult);
+  const int64_t DiffLimit = INT64_MAX / XCAN_PPB_PER_UNIT;
+  int64_t Drift;
+  if (Diff > DiffLimit) Drift = INT32_MAX;                                                 // Saturate the drift, the timestamp source is far from its nominal frequency
+  else if (Diff < -DiffLimit) Drift = INT32_MIN;
+  else Drift = (Diff * XCAN_PPB_PER_UNIT) / (int64_t)pSync->NominalMult;
+  if (Drift > INT32_MAX) Drift = INT32_MAX;
+  if (Drift < INT32_MIN) Drift = INT32_MIN;
+  *pDriftPpb = (int32_t)Drift;
+  return ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
@@ -0,0 +1,171 @@
+/*!*****************************************************************************
+ * @file    XCAN_TimeSync.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN timestamps to host clock correlation
+ * @details
+ * Estimate the offset and the drift between the 64-bits timestamp of the
+ *   X_CAN descriptors (TS1:TS0) and a host monotonic clock, and convert the
+ *   timestamps to the host clock so that the messages of several devices can
+ *   be compared between them and with the application events.
+ * The application periodically gives a pair of samples (X_CAN timestamp
+ *   source, host clock) taken as close as possible. The drift is estimated
+ *   from the oldest and newest samples of a window, the offset is the mean of
+ *   all samples of the window to filter the sampling jitter.
+ * The conversion is: Host = RefHost + ((Timestamp - RefTimestamp) * Mult) >> XCAN_TIME_SYNC_SHIFT
+ *   with a 64-bits multiply when the timestamp is close enough to the reference.
+ * The compared devices shall capture the timestamps on the same frame event
+ *   (MODE.SFS: start of frame or end of frame).
+ * Configuration (in Conf_XCAN.h):
+ *   - XCAN_TIME_SYNC_SHIFT: fractional bits of the conversion factor (default 24)
+ ******************************************************************************/
+/* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#ifndef XCAN_TIMESYNC_H_INC
+#define XCAN_TIMESYNC_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include "XCAN.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+  extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+//! Count of fractional bits of the conversion factor (1 to 63). Can be overridden in Conf_XCAN.h. More bits give a better resolution of the drift but a shorter fast conversion range
+#ifndef XCAN_TIME_SYNC_SHIFT
+#  define XCAN_TIME_SYNC_SHIFT  ( 24 )
+#endif
+
+#define XCAN_TIME_SYNC_WINDOW_MIN  ( 2u ) //!< Minimum count of samples in the window to estimate the drift
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// XCAN Time synchronization
+//********************************************************************************************************************
+
+//! Paired sample of the X_CAN timestamp and the host clock
+typedef struct XCAN_TimeSyncSample
+{
+  uint64_t Timestamp; //!< X_CAN timestamp source value
+  uint64_t Host;      //!< Host clock value at the same time
+} XCAN_TimeSyncSample;
+
+//! Time synchronization configuration structure
+typedef struct XCAN_TimeSyncConfig
+{
+  uint32_t TimestampHz;         //!< Nominal frequency of the X_CAN timestamp source in Hz
+  uint32_t HostHz;              //!< Nominal frequency of the host clock in Hz (1000000000 for a clock in nanoseconds)
+  uint64_t MaxSampleLatency;    //!< Maximum time in host ticks between the host clock reads before and after the timestamp read of a sample. Samples taken slower are rejected. 0 to accept all samples
+  XCAN_TimeSyncSample* Samples; //!< Samples window ring, WindowSize elements
+  uint8_t WindowSize;           //!< Count of samples of the window (XCAN_TIME_SYNC_WINDOW_MIN or more)
+} XCAN_TimeSyncConfig;
+
+//! Time synchronization state (Managed by the driver)
+typedef struct XCAN_TimeSync
+{
+  XCAN_TimeSyncSample* Samples; //!< Samples window ring
+  uint8_t WindowSize;           //!< Count of samples of the window
+  uint8_t Count;                //!< Count of samples in the window
+  uint8_t Newest;               //!< Index of the newest sample in the window
+  uint64_t MaxSampleLatency;    //!< Maximum time in host ticks to take a sample. 0 to accept all samples
+  uint32_t Rejected;            //!< Count of samples rejected because taken too slowly
+  uint64_t NominalMult;         //!< Nominal conversion factor (HostHz / TimestampHz) << XCAN_TIME_SYNC_SHIFT
+  uint64_t Mult;                //!< Estimated conversion factor, host ticks per timestamp tick << XCAN_TIME_SYNC_SHIFT
+  uint64_t MaxFastDelta;        //!< Maximum timestamp distance to the reference converted with a 64-bits multiply
+  uint64_t RefTimestamp;        //!< Reference timestamp of the conversion
+  uint64_t RefHost;             //!< Host clock value of the reference timestamp
+} XCAN_TimeSync;
+
+//-----------------------------------------------------------------------------
+
+
+
+/*! @brief Initialize a time synchronization
+ *
+ * @param[out] *pSync Is the time synchronization to initialize
+ * @param[in] *pConf Is the configuration of the time synchronization
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_InitTimeSync(XCAN_TimeSync* pSync, const XCAN_TimeSyncConfig* pConf);
+
+/*! @brief Add a paired sample to a time synchronization
+ *
+ * Read the host clock, then the X_CAN timestamp source, then the host clock again. The host time of the sample is the middle of both host reads.
+ * The first sample sets the offset with the nominal frequencies, the next samples estimate the drift and filter the offset over the window
+ * @param[in] *pSync Is the time synchronization to update
+ * @param[in] hostBefore Is the host clock value read just before the timestamp
+ * @param[in] timestamp Is the X_CAN timestamp source value
+ * @param[in] hostAfter Is the host clock value read just after the timestamp
+ * @return Returns an #eERRORRESULT value enum, ERR__OUT_OF_RANGE if the sample is rejected (taken too slowly or older than the newest sample)
+ */
+eERRORRESULT XCAN_AddTimeSyncSample(XCAN_TimeSync* pSync, uint64_t hostBefore, uint64_t timestamp, uint64_t hostAfter);
+
+/*! @brief Convert a batch of X_CAN timestamps to the host clock
+ *
+ * The timestamps closer than XCAN_TimeSync.MaxFastDelta to the reference only need one 64-bits multiply and one shift
+ * @param[in] *pSync Is the time synchronization to use
+ * @param[in] *pTimestamps Is the X_CAN timestamps to convert
+ * @param[out] *pHost Is where the host clock values will be stored. Can be the same array as pTimestamps
+ * @param[in] count Is the count of timestamps to convert
+ * @return Returns an #eERRORRESULT value enum, ERR__NOT_READY if no sample has been added yet
+ */
+eERRORRESULT XCAN_ConvertTimestampsToHost(const XCAN_TimeSync* pSync, const uint64_t* pTimestamps, uint64_t* pHost, size_t count);
+
+/*! @brief Convert the timestamps of RX messages to the host clock
+ *
+ * The XCAN_RxMessageView.Timestamp of each message is replaced by its host clock value
+ * @param[in] *pSync Is the time synchronization to use
+ * @param[in,out] *pViews Is the RX messages to convert
+ * @param[in] count Is the count of messages to convert
+ * @return Returns an #eERRORRESULT value enum, ERR__NOT_READY if no sample has been added yet
+ */
+eERRORRESULT XCAN_ConvertRxTimestampsToHost(const XCAN_TimeSync* pSync, XCAN_RxMessageView* pViews, size_t count);
+
+/*! @brief Get the estimated drift of the X_CAN timestamp source
+ *
+ * @param[in] *pSync Is the time synchronization to use
+ * @param[out] *pDriftPpb Is where the drift of the timestamp source against the host clock in parts per billion will be stored. Positive if the timestamp source is slower than its nominal frequency
+ * @return Returns an #eERRORRESULT value enum, ERR__NOT_READY if less than XCAN_TIME_SYNC_WINDOW_MIN samples have been added
+ */
+eERRORRESULT XCAN_GetTimeSyncDrift(const XCAN_TimeSync* pSync, int32_t* pDriftPpb);
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* XCAN_TIMESYNC_H_INC */
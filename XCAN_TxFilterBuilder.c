@@ -0,0 +1,196 @@
+/*!*****************************************************************************
+ * @file    XCAN_TxFilterBuilder.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN CAN-XL TX filter builder
+ * @details
+ * A pair of elements without MASK[n] nor COMB[n] is used as 2 independent
+ *   elements, the XCAN_TX_FILTER_EQUAL rules fill them after the pair rules
+ ******************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "XCAN_TxFilterBuilder.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define XCAN_TX_FILTER_ELEMENTS_PER_REFVAL  ( 4u ) //!< Count of reference values in a TX_FILTER_REFVALn register
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// [STATIC] Set a TX filter element
+//=============================================================================
+static void __XCAN_SetTxFilterElement(XCAN_TxFilterConfig* pConf, size_t element, eXCAN_TxFilterField field, uint8_t value)
+{
+  const size_t Shift = (element % XCAN_TX_FILTER_ELEMENTS_PER_REFVAL) * XCAN_TX_FILTER_REFVAL1_Pos;
+  pConf->RefVal[element / XCAN_TX_FILTER_ELEMENTS_PER_REFVAL] |= ((uint32_t)value << Shift);
+  pConf->Ctrl1 |= XCAN_TX_FILTER_CTRL1_VALID_SET(1u << element);
+  if (field == XCAN_TX_FILTER_SDT) pConf->Ctrl1 |= XCAN_TX_FILTER_CTRL1_FIELD_SET(1u << element);
+}
+
+
+
+//=============================================================================
+// [STATIC] Check if an equal rule is a duplicate of a previous rule
+//=============================================================================
+static bool __XCAN_IsTxFilterRuleDuplicate(const XCAN_TxFilterRule* pRules, size_t index)
+{
+  for (size_t zRule = 0; zRule < index; ++zRule)
+  {
+    const bool IsEqual = (pRules[zRule].Type == XCAN_TX_FILTER_EQUAL) || ((pRules[zRule].Type == XCAN_TX_FILTER_MASKED) && (pRules[zRule].Mask == 0xFF));
+    if (IsEqual && (pRules[zRule].Field == pRules[index].Field) && (pRules[zRule].Value == pRules[index].Value)) return true;
+  }
+  return false;
+}
+
+
+
+//=============================================================================
+// Compile a TX filter policy in the TX filter registers values
+//=============================================================================
+eERRORRESULT XCAN_BuildTxFilter(const XCAN_TxFilterPolicy* pPolicy, XCAN_TxFilterConfig* pConf, size_t* pElementCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pPolicy == NULL) || (pConf == NULL)) return ERR__PARAMETER_ERROR;
+  if ((pPolicy->Rules == NULL) && (pPolicy->RuleCount > 0)) return ERR__PARAMETER_ERROR;
+#endif
+  const XCAN_TxFilterRule* pRules = pPolicy->Rules;
+  size_t PairCount = 0, SingleCount = 0;
+
+  //--- Count the elements needed ---
+  for (size_t zRule = 0; zRule < pPolicy->RuleCount; ++zRule)
+  {
+    if (pRules[zRule].Type > XCAN_TX_FILTER_BOTH) return ERR__PARAMETER_ERROR;
+    const bool IsEqual = (pRules[zRule].Type == XCAN_TX_FILTER_EQUAL) || ((pRules[zRule].Type == XCAN_TX_FILTER_MASKED) && (pRules[zRule].Mask == 0xFF)); // A full mask is an equal rule
+    if (IsEqual == false) ++PairCount;
+    else if (__XCAN_IsTxFilterRuleDuplicate(pRules, zRule) == false) ++SingleCount;
+  }
+  const size_t ElementCount = (PairCount * 2u) + SingleCount;
+  if (pElementCount != NULL) *pElementCount = ElementCount;
+  if (ElementCount > XCAN_TX_FILTER_ELEMENT_COUNT) return ERR__BUFFER_FULL;
+
+  //--- Fill the elements ---
+  pConf->Ctrl0 = XCAN_TX_FILTER_CTRL0_ENABLE_TX_FILTER;
+  pConf->Ctrl1 = 0;
+  for (size_t zReg = 0; zReg < XCAN_TX_FILTER_REFVAL_COUNT; ++zReg) pConf->RefVal[zReg] = 0;
+  size_t Pair = 0, Element = PairCount * 2u;
+  for (size_t zRule = 0; zRule < pPolicy->RuleCount; ++zRule)
+  {
+    const XCAN_TxFilterRule* pRule = &pRules[zRule];
+    if ((pRule->Type == XCAN_TX_FILTER_MASKED) && (pRule->Mask != 0xFF))
+    {
+      __XCAN_SetTxFilterElement(pConf, (Pair * 2u) + 0u, pRule->Field, pRule->Value);
+      __XCAN_SetTxFilterElement(pConf, (Pair * 2u) + 1u, pRule->Field, pRule->Mask);
+      pConf->Ctrl0 |= XCAN_TX_FILTER_CTRL0_MASK_SET(1u << Pair);
+      ++Pair;
+    }
+    else if (pRule->Type == XCAN_TX_FILTER_BOTH)
+    {
+      __XCAN_SetTxFilterElement(pConf, (Pair * 2u) + 0u, pRule->Field , pRule->Value );
+      __XCAN_SetTxFilterElement(pConf, (Pair * 2u) + 1u, pRule->Field2, pRule->Value2);
+      pConf->Ctrl0 |= XCAN_TX_FILTER_CTRL0_COMB_SET(1u << Pair);
+      ++Pair;
+    }
+    else if (__XCAN_IsTxFilterRuleDuplicate(pRules, zRule) == false)
+    {
+      __XCAN_SetTxFilterElement(pConf, Element, pRule->Field, pRule->Value);
+      ++Element;
+    }
+  }
+
+  //--- Set the policy ---
+  if (pPolicy->AcceptOnMatch)    pConf->Ctrl0 |= XCAN_TX_FILTER_CTRL0_ACCEPT_ON_MATCH;
+  if (pPolicy->RejectCANFD)      pConf->Ctrl0 |= XCAN_TX_FILTER_CTRL0_REJECT_CANFD_MSG;
+  if (pPolicy->RejectClassicCAN) pConf->Ctrl0 |= XCAN_TX_FILTER_CTRL0_REJECT_CAN20_MSG;
+  if (pPolicy->IrqOnReject)      pConf->Ctrl0 |= XCAN_TX_FILTER_CTRL0_ENABLE_FILTER_INT;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// [STATIC] Get the value of a TX filter element
+//=============================================================================
+static inline uint8_t __XCAN_GetTxFilterElement(const XCAN_TxFilterConfig* pConf, size_t element)
+{
+  const size_t Shift = (element % XCAN_TX_FILTER_ELEMENTS_PER_REFVAL) * XCAN_TX_FILTER_REFVAL1_Pos;
+  return (uint8_t)(pConf->RefVal[element / XCAN_TX_FILTER_ELEMENTS_PER_REFVAL] >> Shift);
+}
+
+
+
+//=============================================================================
+// [STATIC] Check if a TX filter element matches a CAN-XL message
+//=============================================================================
+static bool __XCAN_TxFilterElementMatch(const XCAN_TxFilterConfig* pConf, size_t element, const XCAN_CANMessage* pMessage)
+{
+  const bool IsSDT = ((XCAN_TX_FILTER_CTRL1_FIELD_GET(pConf->Ctrl1) & (1u << element)) > 0);
+  return ((IsSDT ? pMessage->SDT : pMessage->VCID) == __XCAN_GetTxFilterElement(pConf, element));
+}
+
+
+
+//=============================================================================
+// Check if a TX message passes a TX filter configuration, as the X_CAN does
+//=============================================================================
+eERRORRESULT XCAN_CheckTxFilter(const XCAN_TxFilterConfig* pConf, const XCAN_CANMessage* pMessage, bool* pAccepted)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pConf == NULL) || (pMessage == NULL) || (pAccepted == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  *pAccepted = true;
+  if ((pConf->Ctrl0 & XCAN_TX_FILTER_CTRL0_ENABLE_TX_FILTER) == 0) return ERR_OK;          // The TX filter is disabled
+  if ((pMessage->ControlFlags & XCAN_CANXL_FRAME) == 0)                                    // Only the CAN-XL messages are compared with the elements
+  {
+    if ((pMessage->ControlFlags & XCAN_CANFD_FRAME) > 0) *pAccepted = ((pConf->Ctrl0 & XCAN_TX_FILTER_CTRL0_REJECT_CANFD_MSG) == 0);
+    else *pAccepted = ((pConf->Ctrl0 & XCAN_TX_FILTER_CTRL0_REJECT_CAN20_MSG) == 0);
+    return ERR_OK;
+  }
+
+  //--- Compare the elements ---
+  const uint32_t Valid = XCAN_TX_FILTER_CTRL1_VALID_GET(pConf->Ctrl1);
+  const uint32_t Mask  = XCAN_TX_FILTER_CTRL0_MASK_GET(pConf->Ctrl0);
+  const uint32_t Comb  = XCAN_TX_FILTER_CTRL0_COMB_GET(pConf->Ctrl0);
+  bool Match = false;
+  for (size_t zPair = 0; (zPair < XCAN_TX_FILTER_PAIR_COUNT) && (Match == false); ++zPair)
+  {
+    const size_t Element0 = (zPair * 2u), Element1 = (zPair * 2u) + 1u;
+    const bool Valid0 = ((Valid & (1u << Element0)) > 0), Valid1 = ((Valid & (1u << Element1)) > 0);
+    if ((Mask & (1u << zPair)) > 0)                                                        // Value and mask
+    {
+      if ((Valid0 == false) || (Valid1 == false)) continue;
+      const bool IsSDT = ((XCAN_TX_FILTER_CTRL1_FIELD_GET(pConf->Ctrl1) & (1u << Element0)) > 0);
+      const uint8_t FieldMask = __XCAN_GetTxFilterElement(pConf, Element1);
+      Match = ((((IsSDT ? pMessage->SDT : pMessage->VCID) ^ __XCAN_GetTxFilterElement(pConf, Element0)) & FieldMask) == 0);
+    }
+    else if ((Comb & (1u << zPair)) > 0)                                                   // Both comparisons required
+    {
+      if ((Valid0 == false) || (Valid1 == false)) continue;
+      Match = __XCAN_TxFilterElementMatch(pConf, Element0, pMessage) && __XCAN_TxFilterElementMatch(pConf, Element1, pMessage);
+    }
+    else Match = (Valid0 && __XCAN_TxFilterElementMatch(pConf, Element0, pMessage)) || (Valid1 && __XCAN_TxFilterElementMatch(pConf, Element1, pMessage));
+  }
+  *pAccepted = (((pConf->Ctrl0 & XCAN_TX_FILTER_CTRL0_ACCEPT_ON_MATCH) > 0) == Match);
+  return ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
@@ -0,0 +1,135 @@
+/*!*****************************************************************************
+ * @file    XCAN_TxFilterBuilder.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN CAN-XL TX filter builder
+ * @details
+ * Compile a TX filter policy on the SDT and VCID of the CAN-XL messages in
+ *   the values of the TX_FILTER_CTRL0/1 and TX_FILTER_REFVAL0-3 registers.
+ * The X_CAN has 16 reference values (elements), grouped by pairs: a pair
+ *   can be a value and a mask (MASK[n]), or 2 comparisons both required
+ *   (COMB[n]). The element n is in TX_FILTER_REFVAL(n/4).REF_VAL(n%4), the
+ *   pair n is made of the elements 2n and 2n+1.
+ * The CAN-FD and Classic CAN messages are not compared with the elements,
+ *   they are only accepted or rejected by type
+ ******************************************************************************/
+/* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#ifndef XCAN_TXFILTERBUILDER_H_INC
+#define XCAN_TXFILTERBUILDER_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include "XCAN.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+  extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define XCAN_TX_FILTER_PAIR_COUNT  ( XCAN_TX_FILTER_ELEMENT_COUNT / 2 ) //!< Count of TX filter elements pairs (MASK[n] and COMB[n])
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// XCAN TX Filter builder
+//********************************************************************************************************************
+
+//! CAN-XL field compared by a TX filter element
+typedef enum
+{
+  XCAN_TX_FILTER_VCID = 0b0, //!< Compare the VCID (Virtual CAN Network ID)
+  XCAN_TX_FILTER_SDT  = 0b1, //!< Compare the SDT (SDU Type)
+} eXCAN_TxFilterField;
+
+//! TX filter rule type
+typedef enum
+{
+  XCAN_TX_FILTER_EQUAL  = 0, //!< Field is equal to Value. Uses one element
+  XCAN_TX_FILTER_MASKED = 1, //!< The bits of Field set in Mask are equal to the ones of Value. Uses a pair of elements, or one element if Mask is 0xFF
+  XCAN_TX_FILTER_BOTH   = 2, //!< Field is equal to Value and Field2 is equal to Value2. Uses a pair of elements
+} eXCAN_TxFilterRuleType;
+
+//! TX filter rule structure
+typedef struct XCAN_TxFilterRule
+{
+  eXCAN_TxFilterRuleType Type; //!< Type of the rule
+  eXCAN_TxFilterField Field;   //!< Field compared with Value
+  uint8_t Value;               //!< Reference value of Field
+  uint8_t Mask;                //!< XCAN_TX_FILTER_MASKED: bits of Field compared. Not used else
+  eXCAN_TxFilterField Field2;  //!< XCAN_TX_FILTER_BOTH: field compared with Value2. Not used else
+  uint8_t Value2;              //!< XCAN_TX_FILTER_BOTH: reference value of Field2. Not used else
+} XCAN_TxFilterRule;
+
+//! TX filter policy structure
+typedef struct XCAN_TxFilterPolicy
+{
+  const XCAN_TxFilterRule* Rules; //!< Rules on the CAN-XL messages, RuleCount elements
+  size_t RuleCount;               //!< Count of rules
+  bool AcceptOnMatch;             //!< 'true' to send only the CAN-XL messages that match a rule, 'false' to reject the CAN-XL messages that match a rule
+  bool RejectCANFD;               //!< 'true' to reject all the CAN-FD messages
+  bool RejectClassicCAN;          //!< 'true' to reject all the Classic CAN messages
+  bool IrqOnReject;               //!< 'true' to trigger the MH_TX_FILTER_IRQ interrupt when a message is rejected (IRQ_EN)
+} XCAN_TxFilterPolicy;
+
+//-----------------------------------------------------------------------------
+
+
+
+/*! @brief Compile a TX filter policy in the TX filter registers values
+ *
+ * The pairs are given to the XCAN_TX_FILTER_MASKED and XCAN_TX_FILTER_BOTH rules first, the XCAN_TX_FILTER_EQUAL rules use the remaining elements.
+ * The duplicated rules use only one element. The configuration is ready to be used with XCAN_ConfigureTxFilter()
+ * @param[in] *pPolicy Is the TX filter policy to compile
+ * @param[out] *pConf Is where the TX filter registers values will be stored, the filter is enabled
+ * @param[out] *pElementCount Is where the count of elements used will be stored, or the count needed if the policy does not fit. Can be NULL
+ * @return Returns an #eERRORRESULT value enum, ERR__BUFFER_FULL if the policy needs more than XCAN_TX_FILTER_ELEMENT_COUNT elements
+ */
+eERRORRESULT XCAN_BuildTxFilter(const XCAN_TxFilterPolicy* pPolicy, XCAN_TxFilterConfig* pConf, size_t* pElementCount);
+
+/*! @brief Check if a TX message passes a TX filter configuration, as the X_CAN does
+ *
+ * @param[in] *pConf Is the TX filter configuration
+ * @param[in] *pMessage Is the message to check
+ * @param[out] *pAccepted Is where 'true' will be stored if the message is sent, 'false' if it is rejected
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_CheckTxFilter(const XCAN_TxFilterConfig* pConf, const XCAN_CANMessage* pMessage, bool* pAccepted);
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* XCAN_TXFILTERBUILDER_H_INC */
@@ -0,0 +1,220 @@
+/*!*****************************************************************************
+ * @file    XCAN_TxScheduler.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN TX traffic classes scheduler
+ * @details
+ * Map the application traffic classes onto the TX FIFO Queues and the TX
+ *   Priority Queue with a Deficit Weighted Round Robin
+ ******************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "XCAN_TxScheduler.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//**********************************************************************************************************************************************************
+//=============================================================================
+// [STATIC] Get the cost of a message for the scheduler
+//=============================================================================
+static uint32_t __XCAN_TxMessageCost(const XCAN_CANMessage* pMessage)
+{
+  size_t PayloadSize;
+  if ((pMessage->ControlFlags & XCAN_CANXL_FRAME) > 0) PayloadSize = pMessage->PayloadSize;
+  else if ((pMessage->ControlFlags & XCAN_REMOTE_TRANSMISSION_REQUEST) > 0) PayloadSize = 0;
+  else PayloadSize = XCAN_DLCToByte(pMessage->DLC, ((pMessage->ControlFlags & XCAN_CANFD_FRAME) > 0));
+  return (uint32_t)PayloadSize + XCAN_TX_SCHED_MESSAGE_OVERHEAD;
+}
+
+
+
+//=============================================================================
+// Initialize the TX scheduler
+//=============================================================================
+eERRORRESULT XCAN_InitTxScheduler(XCAN_TxScheduler* pSched, XCAN *pComp, const XCAN_TxClassConfig* pConf)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pSched == NULL) || (pComp == NULL) || (pConf == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  uint32_t QueuesUsed = 0;
+  eERRORRESULT Error;
+
+  pSched->pComp = pComp;
+  for (size_t zClass = 0; zClass < XCAN_TRAFFIC_CLASS_COUNT; ++zClass)
+  {
+    const XCAN_TxClassConfig* pClassConf = &pConf[zClass];
+    XCAN_TxClass* pClass = &pSched->Class[zClass];
+    pClass->Backlog = NULL;
+    if (pClassConf->Backlog == NULL) continue;                                             // Class not used
+    if ((pClassConf->BacklogSize == 0) || ((pClassConf->BacklogSize & (pClassConf->BacklogSize - 1u)) != 0)) return ERR__PARAMETER_ERROR; // The backlog size shall be a power of 2
+    if (pClassConf->Weight == 0) return ERR__PARAMETER_ERROR;
+
+    //--- Configure the dedicated TX FIFO Queue ---
+    if (pClassConf->UsePriorityQueue == false)
+    {
+      if (pClassConf->FIFOQueue.Queue >= XCAN_FIFO_QUEUE_COUNT) return ERR__PARAMETER_ERROR;
+      const uint32_t QueueMask = XCAN_FIFO_QUEUE_MASK(pClassConf->FIFOQueue.Queue);
+      if ((QueuesUsed & QueueMask) > 0) return ERR__CONFIGURATION;                         // A TX FIFO Queue can only be used by one class
+      QueuesUsed |= QueueMask;
+      Error = XCAN_ConfigureTxFIFOQueue(pComp, &pClassConf->FIFOQueue);
+      if (Error != ERR_OK) return Error;                                                   // If there is an error while calling XCAN_ConfigureTxFIFOQueue() then return the error
+    }
+
+    //--- Initialize the class ---
+    pClass->UsePriorityQueue = pClassConf->UsePriorityQueue;
+    pClass->Queue            = pClassConf->FIFOQueue.Queue;
+    pClass->Weight           = pClassConf->Weight;
+    pClass->IrqWhenSent      = pClassConf->IrqWhenSent;
+    pClass->Backlog          = pClassConf->Backlog;
+    pClass->BacklogMask      = pClassConf->BacklogSize - 1u;
+    pClass->Head             = 0;
+    pClass->Tail             = 0;
+    pClass->Deficit          = 0;
+  }
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// Enqueue a message in the backlog of a traffic class
+//=============================================================================
+eERRORRESULT XCAN_EnqueueTxMessage(XCAN_TxScheduler* pSched, eXCAN_TrafficClass trafficClass, const XCAN_CANMessage* pMessage)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pSched == NULL) || (pMessage == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (trafficClass >= XCAN_TRAFFIC_CLASS_COUNT) return ERR__PARAMETER_ERROR;
+  XCAN_TxClass* pClass = &pSched->Class[trafficClass];
+  if (pClass->Backlog == NULL) return ERR__CONFIGURATION;
+  if ((uint16_t)(pClass->Head - pClass->Tail) > pClass->BacklogMask) return ERR__BUFFER_FULL;
+  pClass->Backlog[pClass->Head & pClass->BacklogMask] = *pMessage;
+  pClass->Head++;
+  return ERR_OK;
+}
+
+
+
+//=============================================================================
+// [STATIC] Send the messages of a class that fit in its credit
+//=============================================================================
+static eERRORRESULT __XCAN_RunTxClass(XCAN *pComp, XCAN_TxClass* pClass, size_t* pSentCount)
+{
+  eERRORRESULT Error = ERR_OK;
+  size_t TotalSent = 0;
+  pClass->Deficit += pClass->Weight;
+
+  while (pClass->Head != pClass->Tail)
+  {
+    //--- Count the contiguous messages that fit in the credit ---
+    const size_t First = pClass->Tail & pClass->BacklogMask;
+    const size_t Pending = (uint16_t)(pClass->Head - pClass->Tail);
+    const size_t Contiguous = ((size_t)pClass->BacklogMask + 1u) - First;                  // Up to the end of the backlog ring
+    const size_t MaxCount = (Pending < Contiguous ? Pending : Contiguous);
+    uint32_t Cost = 0;
+    size_t Count = 0;
+    while (Count < MaxCount)
+    {
+      const uint32_t MessageCost = __XCAN_TxMessageCost(&pClass->Backlog[First + Count]);
+      if ((Cost + MessageCost) > pClass->Deficit) break;
+      Cost += MessageCost;
+      ++Count;
+    }
+    if (Count == 0) break;                                                                 // Not enough credit for the next message, wait the next run
+
+    //--- Send them in one burst ---
+    size_t Sent = 0;
+    if (pClass->UsePriorityQueue)
+    {
+      while (Sent < Count)
+      {
+        Error = XCAN_TransmitMessageToTxPQ(pComp, &pClass->Backlog[First + Sent], pClass->IrqWhenSent, NULL);
+        if (Error != ERR_OK) break;                                                        // If there is an error while calling XCAN_TransmitMessageToTxPQ() then stop here
+        ++Sent;
+      }
+    }
+    else Error = XCAN_TransmitMessagesToTxFIFOQueue(pComp, pClass->Queue, &pClass->Backlog[First], Count, &Sent, pClass->IrqWhenSent);
+    if (Sent < Count)                                                                      // Only the cost of the messages sent is used
+      for (size_t z = Sent; z < Count; ++z) Cost -= __XCAN_TxMessageCost(&pClass->Backlog[First + z]);
+    pClass->Deficit -= Cost;
+    pClass->Tail    += (uint16_t)Sent;
+    TotalSent       += Sent;
+    if (Error != ERR_OK) break;
+  }
+
+  //--- Update the credit ---
+  if (pClass->Head == pClass->Tail) pClass->Deficit = 0;                                   // An empty class does not keep credit
+  else if ((Error == ERR__BUFFER_FULL) && (pClass->Deficit > pClass->Weight)) pClass->Deficit = pClass->Weight; // A class blocked by its hardware queue shall not accumulate credit
+  *pSentCount += TotalSent;
+  return (Error == ERR__BUFFER_FULL ? ERR_OK : Error);                                     // A full hardware queue is not an error, the messages stay in the backlog
+}
+
+
+
+//=============================================================================
+// Run the TX scheduler
+//=============================================================================
+eERRORRESULT XCAN_RunTxScheduler(XCAN_TxScheduler* pSched, size_t* pSentCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pSched == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  eERRORRESULT Error = ERR_OK;
+  size_t Sent = 0;
+  for (size_t zClass = 0; zClass < XCAN_TRAFFIC_CLASS_COUNT; ++zClass)                     // The classes are served by order of importance
+  {
+    XCAN_TxClass* pClass = &pSched->Class[zClass];
+    if ((pClass->Backlog == NULL) || (pClass->Head == pClass->Tail)) continue;
+    Error = __XCAN_RunTxClass(pSched->pComp, pClass, &Sent);
+    if (Error != ERR_OK) break;                                                            // If there is an error while calling __XCAN_RunTxClass() then stop here
+  }
+  if (pSentCount != NULL) *pSentCount = Sent;
+  return Error;
+}
+
+
+
+//=============================================================================
+// Get the backlog of a traffic class
+//=============================================================================
+eERRORRESULT XCAN_GetTxClassBacklog(XCAN_TxScheduler* pSched, eXCAN_TrafficClass trafficClass, size_t* pSoftware, size_t* pHardware)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pSched == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (trafficClass >= XCAN_TRAFFIC_CLASS_COUNT) return ERR__PARAMETER_ERROR;
+  XCAN_TxClass* pClass = &pSched->Class[trafficClass];
+  if (pClass->Backlog == NULL) return ERR__CONFIGURATION;
+  if (pSoftware != NULL) *pSoftware = (uint16_t)(pClass->Head - pClass->Tail);
+  if (pHardware != NULL)
+  {
+    if (pClass->UsePriorityQueue)
+    {
+      size_t Count = 0;
+      for (uint32_t Pending = pSched->pComp->TxPQ.PendingMask; Pending != 0; Pending &= (Pending - 1u)) ++Count; // Count the pending slots
+      *pHardware = Count;
+    }
+    else *pHardware = pSched->pComp->TxFIFO[pClass->Queue].InFlight;
+  }
+  return ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
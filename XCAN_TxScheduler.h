@@ -0,0 +1,162 @@
+/*!*****************************************************************************
+ * @file    XCAN_TxScheduler.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    01/04/2023
+ * @brief   Bosch X_CAN TX traffic classes scheduler
+ * @details
+ * Map the application traffic classes (safety-critical, periodic, diagnostic,
+ *   bulk) onto dedicated TX FIFO Queues or onto the TX Priority Queue so that
+ *   a long transfer of a class never delays the frames of another class.
+ * Each class has a software backlog ring. The backlogs are moved to the
+ *   hardware queues with a Deficit Weighted Round Robin: at each scheduler run,
+ *   a class receives its weight in bytes of credit and sends the messages that
+ *   fit in its credit in one burst (one START). A message costs its payload
+ *   size plus XCAN_TX_SCHED_MESSAGE_OVERHEAD bytes
+ ******************************************************************************/
+/* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#ifndef XCAN_TXSCHEDULER_H_INC
+#define XCAN_TXSCHEDULER_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include "XCAN.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+  extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define XCAN_TX_SCHED_MESSAGE_OVERHEAD  ( 8u ) //!< Cost in bytes of a message added to its payload size (header), so that messages without payload have a cost
+
+
+
+
+
+//********************************************************************************************************************
+// XCAN TX Scheduler
+//********************************************************************************************************************
+
+//! Traffic class enumerator. The classes are served in this order at each scheduler run
+typedef enum
+{
+  XCAN_TRAFFIC_SAFETY     = 0, //!< Safety-critical messages
+  XCAN_TRAFFIC_PERIODIC   = 1, //!< Periodic control messages
+  XCAN_TRAFFIC_DIAGNOSTIC = 2, //!< Diagnostic messages
+  XCAN_TRAFFIC_BULK       = 3, //!< Bulk transfers
+  XCAN_TRAFFIC_CLASS_COUNT,    // Keep last
+} eXCAN_TrafficClass;
+
+//-----------------------------------------------------------------------------
+
+
+
+//! Traffic class configuration structure
+typedef struct XCAN_TxClassConfig
+{
+  bool UsePriorityQueue;            //!< 'true' to send the messages of this class through the TX Priority Queue (configured with XCAN_ConfigureTxPriorityQueue()), 'false' to use FIFOQueue
+  XCAN_TxFIFOQueueConfig FIFOQueue; //!< TX FIFO Queue dedicated to this class and its depth (MaxDesc). Not used with the TX Priority Queue
+  uint16_t Weight;                  //!< Credit in bytes given to the class at each scheduler run (1 or more). A message is sent when the credit reaches its cost
+  bool IrqWhenSent;                 //!< Set to 'true' to trigger an interrupt when each message of this class has been sent
+  XCAN_CANMessage* Backlog;         //!< Software backlog ring of the class, BacklogSize elements
+  uint16_t BacklogSize;             //!< Count of messages of the backlog ring, must be a power of 2
+} XCAN_TxClassConfig;
+
+//! Traffic class state (Managed by the scheduler)
+typedef struct XCAN_TxClass
+{
+  bool UsePriorityQueue;    //!< The messages are sent through the TX Priority Queue
+  eXCAN_FIFOQueue Queue;    //!< TX FIFO Queue of the class
+  uint16_t Weight;          //!< Credit in bytes given to the class at each scheduler run
+  bool IrqWhenSent;         //!< Trigger an interrupt when each message has been sent
+  XCAN_CANMessage* Backlog; //!< Software backlog ring of the class. NULL if the class is not configured
+  uint16_t BacklogMask;     //!< Backlog ring size - 1
+  uint16_t Head;            //!< Free running index of the next message to enqueue
+  uint16_t Tail;            //!< Free running index of the next message to send
+  uint32_t Deficit;         //!< Credit in bytes of the class not yet used
+} XCAN_TxClass;
+
+//! TX scheduler structure
+typedef struct XCAN_TxScheduler
+{
+  XCAN* pComp;                                    //!< Device used by the scheduler
+  XCAN_TxClass Class[XCAN_TRAFFIC_CLASS_COUNT];   //!< Traffic classes states
+} XCAN_TxScheduler;
+
+//-----------------------------------------------------------------------------
+
+
+
+/*! @brief Initialize the TX scheduler
+ *
+ * Configure the TX FIFO Queue of each class with its depth. A TX FIFO Queue can only be used by one class
+ * @param[out] *pSched Is the scheduler to initialize
+ * @param[in] *pComp Is the pointed structure of the device to be used
+ * @param[in] *pConf Is the configuration of each class (XCAN_TRAFFIC_CLASS_COUNT elements). A class with a NULL Backlog is not used
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_InitTxScheduler(XCAN_TxScheduler* pSched, XCAN *pComp, const XCAN_TxClassConfig* pConf);
+
+/*! @brief Enqueue a message in the backlog of a traffic class
+ *
+ * The message structure is copied, the payload data shall stay untouched until the message is sent
+ * @param[in] *pSched Is the scheduler to use
+ * @param[in] trafficClass Is the traffic class of the message
+ * @param[in] *pMessage Is the message to enqueue
+ * @return Returns an #eERRORRESULT value enum, ERR__BUFFER_FULL if the backlog is full
+ */
+eERRORRESULT XCAN_EnqueueTxMessage(XCAN_TxScheduler* pSched, eXCAN_TrafficClass trafficClass, const XCAN_CANMessage* pMessage);
+
+/*! @brief Run the TX scheduler
+ *
+ * Each class with a backlog receives its weight of credit and sends as many messages as its credit and its hardware queue allow, in one burst per class.
+ * An empty class loses its credit, a class blocked by its full hardware queue keeps at most its weight of credit
+ * @param[in] *pSched Is the scheduler to run
+ * @param[out] *pSentCount Is where the count of messages moved to the hardware queues will be stored. Can be NULL
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_RunTxScheduler(XCAN_TxScheduler* pSched, size_t* pSentCount);
+
+/*! @brief Get the backlog of a traffic class
+ *
+ * @param[in] *pSched Is the scheduler to use
+ * @param[in] trafficClass Is the traffic class to check
+ * @param[out] *pSoftware Is where the count of messages waiting in the software backlog will be stored. Can be NULL
+ * @param[out] *pHardware Is where the count of messages in flight in the hardware queue will be stored (TX Priority Queue pending slots are shared by all classes using it). Can be NULL
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT XCAN_GetTxClassBacklog(XCAN_TxScheduler* pSched, eXCAN_TrafficClass trafficClass, size_t* pSoftware, size_t* pHardware);
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* XCAN_TXSCHEDULER_H_INC */
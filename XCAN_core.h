@@ -102,7 +102,7 @@ typedef enum
 
 static const uint8_t XCAN20_DLC_TO_VALUE[XCAN_DLC_COUNT] = {0, 1, 2, 3, 4, 5, 6, 7, 8,  8,  8,  8,  8,  8,  8,  8};
 static const uint8_t XCANFD_DLC_TO_VALUE[XCAN_DLC_COUNT] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64};
-#define XCAN_DLCToByte(dlc, isCANFD)  ( ((isCANFD) ? CANFD_DLC_TO_VALUE[(size_t)(dlc) & 0xF] : CAN20_DLC_TO_VALUE[(size_t)(dlc) & 0xF] )
+#define XCAN_DLCToByte(dlc, isCANFD)  ( (isCANFD) ? XCANFD_DLC_TO_VALUE[(size_t)(dlc) & 0xF] : XCAN20_DLC_TO_VALUE[(size_t)(dlc) & 0xF] )
 
 //-----------------------------------------------------------------------------
 
@@ -279,61 +279,6 @@ XCAN_CONTROL_ITEM_SIZE(XCAN_TxDMAinfoCtrl2, 4);
 
 //-----------------------------------------------------------------------------
 
-//! Tx messages descriptor overview enumerator
-typedef enum eXCAN_TxStatus
-{
-  XCAN_CAN_TXDESC_TIC1,                        //!< CAN Tx DMA info control 1 (DMA Info Ctrl 1)
-  XCAN_CAN_TXDESC_TIC2,                        //!< CAN Tx DMA info control 2 (DMA Info Ctrl 2)
-  XCAN_CAN_TXDESC_TS0,                         //!< TimeStamp [31:0]
-  XCAN_CAN_TXDESC_TS1,                         //!< TimeStamp [63:32]
-  XCAN_CAN_TXDESC_T0,                          //!< TX Message Header Information 0
-  XCAN_CAN_TXDESC_T1,                          //!< TX Message Header Information 1
-  XCAN_CAN_TXDESC_T2,                          //!< TX Message Header Information 2 (CAN-XL)
-  XCAN_CAN_TXDESC_TD0 = XCAN_CAN_TXDESC_T2,    //!< First TX Data Payload 0
-  XCAN_CAN_TXDESC_TD1,                         //!< First TX Data Payload 1
-  XCAN_CAN_TXDESC_TX_AP = XCAN_CAN_TXDESC_TD1, //!< TX Payload Data Address Pointer
-  XCAN_CAN_TXDESC_COUNT,                       // KEEP LAST!
-} eXCAN_TxDescriptor;
-
-//! TX Queue Descriptor Overview (TX Queue, and TX FIFO)
-XCAN_PACKITEM
-typedef union __XCAN_PACKED__ XCAN_CAN_TxMessage
-{
-  uint32_t Word[XCAN_CAN_TXDESC_COUNT];
-  uint8_t Bytes[XCAN_CAN_TXDESC_COUNT * sizeof(uint32_t)];
-  struct
-  {
-    XCAN_TxDMAinfoCtrl1 TIC1; //!< CAN Tx DMA info control 1 (TIC1)
-    XCAN_TxDMAinfoCtrl2 TIC2; //!< CAN Tx DMA info control 2 (TIC2)
-    uint32_t TS0;             //!< Timestamp 0: LSB of the 64bits timestamp of the successfully sent TX message (only valid when HD bit is set to 1)
-    uint32_t TS1;             //!< Timestamp 1: MSB of the 64bits timestamp of the successfully sent TX message (only valid when HD bit is set to 1)
-    XCAN_TxMessageHeader0 T0; //!< CAN Transmit Message Header 0 (T0)
-    XCAN_TxMessageHeader1 T1; //!< CAN Transmit Message Header 1 (T1)
-    union
-    {
-      uint32_t TD0;           //!< Classical CAN and CAN FD: define the first payload of the TX message
-      uint32_t T2;            //!< CAN-XL Acceptance Field
-    };
-    union
-    {
-      uint32_t TD1;           //!< Classical CAN with payload greater equal to 4byte: define the last payload data of the TX message for the Classical CAN (in case payload data is greater than 4bytes)
-      uint32_t TX_AP;         /*!< CAN XL and CAN FD (with payload greater than 4bytes): Address pointer to fetch the TX message payload data for CAN FD and CAN XL frames.
-                               *     For CAN FD frames with more than 4 bytes this bit field is, nevertheless, mandatory.
-                               *     As the address pointer must be 32bit aligned the two LSB will not be considered and so must be set to 0 all time.
-                               *     In case the TX_AP is not used it must be set to 0
-                               */
-    };
-  };
-} XCAN_CAN_TxMessage;
-XCAN_UNPACKITEM;
-XCAN_CONTROL_ITEM_SIZE(XCAN_CAN_TxMessage, 32);
-
-//-----------------------------------------------------------------------------
-
-#define XCAN_CAN_TX_MESSAGE_SIZE  ( sizeof(XCAN_CAN_TxMessage) )
-
-//-----------------------------------------------------------------------------
-
 //! CAN Transmit Message Header 1 (T0)
 XCAN_PACKITEM
 typedef union __XCAN_PACKED__ XCAN_TxMessageHeader0
@@ -382,6 +327,19 @@ XCAN_CONTROL_ITEM_SIZE(XCAN_TxMessageHeader0, 4);
 #define XCAN_T0_SID_Mask         (0x7FFu << XCAN_T0_SID_Pos)
 #define XCAN_T0_SID_SET(value)   (((uint32_t)(value) << XCAN_T0_SID_Pos) & XCAN_T0_SID_Mask) //!< Set Standard Identifier filter
 
+#define XCAN_T0_SDT_Pos          0
+#define XCAN_T0_SDT_Mask         (0xFFu << XCAN_T0_SDT_Pos)
+#define XCAN_T0_SDT_SET(value)   (((uint32_t)(value) << XCAN_T0_SDT_Pos) & XCAN_T0_SDT_Mask) //!< Set SDU Type (CAN-XL only)
+#define XCAN_T0_VCID_Pos         8
+#define XCAN_T0_VCID_Mask        (0xFFu << XCAN_T0_VCID_Pos)
+#define XCAN_T0_VCID_SET(value)  (((uint32_t)(value) << XCAN_T0_VCID_Pos) & XCAN_T0_VCID_Mask) //!< Set Virtual CAN Network ID (CAN-XL only)
+#define XCAN_T0_SEC_Pos          16
+#define XCAN_T0_SEC_Mask         (0x1u << XCAN_T0_SEC_Pos)
+#define XCAN_T0_SEC_SET(value)   (((uint32_t)(value) << XCAN_T0_SEC_Pos) & XCAN_T0_SEC_Mask) //!< Set Simple Extended Content (CAN-XL only)
+#define XCAN_T0_RRS_Pos          17
+#define XCAN_T0_RRS_Mask         (0x1u << XCAN_T0_RRS_Pos)
+#define XCAN_T0_RRS_SET(value)   (((uint32_t)(value) << XCAN_T0_RRS_Pos) & XCAN_T0_RRS_Mask) //!< Set Remote Request Substitution (CAN-XL only)
+
 #define XCAN_T0_XTD_EXTENDED_ID  (0x1u << 29) //!< 29-bit extended identifier
 #define XCAN_T0_XTD_STANDARD_ID  (0x0u << 29) //!< 11-bit standard identifier
 #define XCAN_T0_XTD              (0x1u << 29) //!< XL Format
@@ -439,6 +397,7 @@ XCAN_CONTROL_ITEM_SIZE(XCAN_TxMessageHeader1, 4);
 #define XCAN_T1_DLC_Pos               16
 #define XCAN_T1_DLC_Mask              (0xFu << XCAN_T1_DLC_Pos)
 #define XCAN_T1_DLC_SET(value)        (((uint32_t)(value) << XCAN_T1_DLC_Pos) & XCAN_T1_DLC_Mask) //!< Set Data Length Code for CAN2.0 and CAN-FD
+#define XCAN_T1_DLC_GET(value)        (((uint32_t)(value) & XCAN_T1_DLC_Mask) >> XCAN_T1_DLC_Pos) //!< Get Data Length Code for CAN2.0 and CAN-FD
 #define XCAN_T1_ESI                   (0x1u << 20) //!< Error State Indicator
 #define XCAN_T1_BRS                   (0x1u << 25) //!< Bit Rate Switch
 #define XCAN_T1_RTR                   (0x1u << 26) //!< Remote Transmission Request
@@ -446,6 +405,61 @@ XCAN_CONTROL_ITEM_SIZE(XCAN_TxMessageHeader1, 4);
 
 //-----------------------------------------------------------------------------
 
+//! Tx messages descriptor overview enumerator
+typedef enum eXCAN_TxDescriptor
+{
+  XCAN_CAN_TXDESC_TIC1,                        //!< CAN Tx DMA info control 1 (DMA Info Ctrl 1)
+  XCAN_CAN_TXDESC_TIC2,                        //!< CAN Tx DMA info control 2 (DMA Info Ctrl 2)
+  XCAN_CAN_TXDESC_TS0,                         //!< TimeStamp [31:0]
+  XCAN_CAN_TXDESC_TS1,                         //!< TimeStamp [63:32]
+  XCAN_CAN_TXDESC_T0,                          //!< TX Message Header Information 0
+  XCAN_CAN_TXDESC_T1,                          //!< TX Message Header Information 1
+  XCAN_CAN_TXDESC_T2,                          //!< TX Message Header Information 2 (CAN-XL)
+  XCAN_CAN_TXDESC_TD0 = XCAN_CAN_TXDESC_T2,    //!< First TX Data Payload 0
+  XCAN_CAN_TXDESC_TD1,                         //!< First TX Data Payload 1
+  XCAN_CAN_TXDESC_TX_AP = XCAN_CAN_TXDESC_TD1, //!< TX Payload Data Address Pointer
+  XCAN_CAN_TXDESC_COUNT,                       // KEEP LAST!
+} eXCAN_TxDescriptor;
+
+//! TX Queue Descriptor Overview (TX Queue, and TX FIFO)
+XCAN_PACKITEM
+typedef union __XCAN_PACKED__ XCAN_CAN_TxMessage
+{
+  uint32_t Word[XCAN_CAN_TXDESC_COUNT];
+  uint8_t Bytes[XCAN_CAN_TXDESC_COUNT * sizeof(uint32_t)];
+  struct
+  {
+    XCAN_TxDMAinfoCtrl1 TIC1; //!< CAN Tx DMA info control 1 (TIC1)
+    XCAN_TxDMAinfoCtrl2 TIC2; //!< CAN Tx DMA info control 2 (TIC2)
+    uint32_t TS0;             //!< Timestamp 0: LSB of the 64bits timestamp of the successfully sent TX message (only valid when HD bit is set to 1)
+    uint32_t TS1;             //!< Timestamp 1: MSB of the 64bits timestamp of the successfully sent TX message (only valid when HD bit is set to 1)
+    XCAN_TxMessageHeader0 T0; //!< CAN Transmit Message Header 0 (T0)
+    XCAN_TxMessageHeader1 T1; //!< CAN Transmit Message Header 1 (T1)
+    union
+    {
+      uint32_t TD0;           //!< Classical CAN and CAN FD: define the first payload of the TX message
+      uint32_t T2;            //!< CAN-XL Acceptance Field
+    };
+    union
+    {
+      uint32_t TD1;           //!< Classical CAN with payload greater equal to 4byte: define the last payload data of the TX message for the Classical CAN (in case payload data is greater than 4bytes)
+      uint32_t TX_AP;         /*!< CAN XL and CAN FD (with payload greater than 4bytes): Address pointer to fetch the TX message payload data for CAN FD and CAN XL frames.
+                               *     For CAN FD frames with more than 4 bytes this bit field is, nevertheless, mandatory.
+                               *     As the address pointer must be 32bit aligned the two LSB will not be considered and so must be set to 0 all time.
+                               *     In case the TX_AP is not used it must be set to 0
+                               */
+    };
+  };
+} XCAN_CAN_TxMessage;
+XCAN_UNPACKITEM;
+XCAN_CONTROL_ITEM_SIZE(XCAN_CAN_TxMessage, 32);
+
+//-----------------------------------------------------------------------------
+
+#define XCAN_CAN_TX_MESSAGE_SIZE  ( sizeof(XCAN_CAN_TxMessage) )
+
+//-----------------------------------------------------------------------------
+
 
 
 
@@ -520,6 +534,10 @@ typedef enum eXCAN_RxStatus
 #define XCAN_RxDMA1_RC_Mask                         (0x1Fu << XCAN_RxDMA1_RC_Pos)
 #define XCAN_RxDMA1_RC_SET(value)                   (((uint32_t)(value) << XCAN_RxDMA1_RC_Pos) & XCAN_RxDMA1_RC_Mask) //!< Set Rolling Counter
 #define XCAN_RxDMA1_RC_GET(value)                   (((uint32_t)(value) & XCAN_RxDMA1_RC_Mask) >> XCAN_RxDMA1_RC_Pos) //!< Get Rolling Counter
+#define XCAN_RxDMA1_IN_Pos                          9
+#define XCAN_RxDMA1_IN_Mask                         (0x7u << XCAN_RxDMA1_IN_Pos)
+#define XCAN_RxDMA1_IN_SET(value)                   (((uint32_t)(value) << XCAN_RxDMA1_IN_Pos) & XCAN_RxDMA1_IN_Mask) //!< Set Instance Number
+#define XCAN_RxDMA1_IN_GET(value)                   (((uint32_t)(value) & XCAN_RxDMA1_IN_Mask) >> XCAN_RxDMA1_IN_Pos) //!< Get Instance Number
 #define XCAN_RxDMA1_FQN_Pos                         12
 #define XCAN_RxDMA1_FQN_Mask                        (0xFu << XCAN_RxDMA1_FQN_Pos)
 #define XCAN_RxDMA1_FQN_SET(value)                  (((uint32_t)(value) << XCAN_RxDMA1_FQN_Pos) & XCAN_RxDMA1_FQN_Mask) //!< Set RX FIFO Queue number allocated to this RX descriptor
@@ -539,7 +557,7 @@ typedef enum eXCAN_RxStatus
 //-----------------------------------------------------------------------------
 
 //! Rx messages descriptor overview enumerator
-typedef enum eXCAN_RxStatus
+typedef enum eXCAN_RxDescriptor
 {
   XCAN_CAN_RXDESC_RIC1,  //!< CAN Rx DMA info control 1 (DMA Info Ctrl 1)
   XCAN_CAN_RXDESC_RX_AP, //!< RX Payload Data Address Pointer
@@ -556,7 +574,7 @@ typedef union __XCAN_PACKED__ XCAN_CAN_RxMessage
   uint8_t Bytes[XCAN_CAN_RXDESC_COUNT * sizeof(uint32_t)];
   struct
   {
-    XCAN_TxDMAinfoCtrl1 RIC1; //!< CAN Rx DMA info control 1 (RIC1)
+    XCAN_RxDMAinfoCtrl1 RIC1; //!< CAN Rx DMA info control 1 (RIC1)
     uint32_t RX_AP;           /*!< Normal Mode: the SW defines the address of the RX data container to write RX data.
                                *   Continuous Mode: The SW must set this bit field to 0 as default value.
                                *     The MH writes this field with the address pointer to find the RX message attached to the RX descriptor.
@@ -623,6 +641,18 @@ XCAN_CONTROL_ITEM_SIZE(XCAN_RxMessageHeader0, 4);
 #define XCAN_R0_SID_Pos          18
 #define XCAN_R0_SID_Mask         (0x7FFu << XCAN_R0_SID_Pos)
 #define XCAN_R0_SID_GET(value)   (((uint32_t)(value) & XCAN_R0_SID_Mask) >> XCAN_R0_SID_Pos) //!< Get Standard Identifier filter
+#define XCAN_R0_SDT_Pos          0
+#define XCAN_R0_SDT_Mask         (0xFFu << XCAN_R0_SDT_Pos)
+#define XCAN_R0_SDT_GET(value)   (((uint32_t)(value) & XCAN_R0_SDT_Mask) >> XCAN_R0_SDT_Pos) //!< Get SDU Type (CAN-XL only)
+#define XCAN_R0_VCID_Pos         8
+#define XCAN_R0_VCID_Mask        (0xFFu << XCAN_R0_VCID_Pos)
+#define XCAN_R0_VCID_GET(value)  (((uint32_t)(value) & XCAN_R0_VCID_Mask) >> XCAN_R0_VCID_Pos) //!< Get Virtual CAN Network ID (CAN-XL only)
+#define XCAN_R0_SEC_Pos          16
+#define XCAN_R0_SEC_Mask         (0x1u << XCAN_R0_SEC_Pos)
+#define XCAN_R0_SEC_GET(value)   (((uint32_t)(value) & XCAN_R0_SEC_Mask) >> XCAN_R0_SEC_Pos) //!< Get Simple Extended Content (CAN-XL only)
+#define XCAN_R0_RRS_Pos          17
+#define XCAN_R0_RRS_Mask         (0x1u << XCAN_R0_RRS_Pos)
+#define XCAN_R0_RRS_GET(value)   (((uint32_t)(value) & XCAN_R0_RRS_Mask) >> XCAN_R0_RRS_Pos) //!< Get Remote Request Substitution (CAN-XL only)
 
 #define XCAN_T0_XTD_EXTENDED_ID  (0x1u << 29) //!< 29-bit extended identifier
 #define XCAN_T0_XTD_STANDARD_ID  (0x0u << 29) //!< 11-bit standard identifier
@@ -683,8 +713,8 @@ XCAN_CONTROL_ITEM_SIZE(XCAN_RxMessageHeader1, 4);
 #define XCAN_R1_FIDX_Pos              0
 #define XCAN_R1_FIDX_Mask             (0xFFu << XCAN_R1_FIDX_Pos)
 #define XCAN_R1_FIDX_SET(value)       (((uint32_t)(value) & XCAN_R1_FIDX_Mask) >> XCAN_R1_FIDX_Pos) //!< Get Filter index
-#define XCAN_R1_FM                    (0x1u << 08) //!< Filter Match
-#define XCAN_R1_BLK                   (0x1u << 09) //!< Black List
+#define XCAN_R1_FM                    (0x1u <<  8) //!< Filter Match
+#define XCAN_R1_BLK                   (0x1u <<  9) //!< Black List
 #define XCAN_R1_FAB                   (0x1u << 10) //!< Filter Aborted
 #define XCAN_R1_CANXL_DLC_Pos         16
 #define XCAN_R1_CANXL_DLC_Mask        (0x7FFu << XCAN_R1_CANXL_DLC_Pos)
@@ -866,7 +896,7 @@ typedef enum
   RegXCAN_TX_FILTER_ERR_INFO     = 0x728u, //!< (Offset: 0x728) TX Filter Error Information
                                            //   (Offset: 0x72C..0x7FC) Reserved
   // Misc Registers
-  RegXCAN_TX_FQ_INT_STS          = 0x800u, //!< (Offset: 0x800) Integration/Debug control and status Registers
+  RegXCAN_MiscRegisters          = 0x800u, //!< (Offset: 0x800) Integration/Debug control and status Registers
   RegXCAN_DEBUG_TEST_CTRL        = 0x800u, //!< (Offset: 0x800) Debug Control register
   RegXCAN_INT_TEST0              = 0x804u, //!< (Offset: 0x804) Interrupt Test register 0
   RegXCAN_INT_TEST1              = 0x808u, //!< (Offset: 0x808) Interrupt Test register 1
@@ -928,6 +958,21 @@ typedef enum
                                            //   (Offset: 0xA44..0xAFC) Reserved
 } eXCAN_Registers;
 
+//! TX FIFO Queue n registers (n = 0 to 7)
+#define RegXCAN_TX_FQ_ADD_PTn(n)        ( (eXCAN_Registers)(RegXCAN_TX_FQ_ADD_PT0    + ((uint16_t)(n) * 0x10u)) ) //!< TX FIFO Queue n Current Address Pointer register
+#define RegXCAN_TX_FQ_START_ADDn(n)     ( (eXCAN_Registers)(RegXCAN_TX_FQ_START_ADD0 + ((uint16_t)(n) * 0x10u)) ) //!< TX FIFO Queue n Start Address register
+#define RegXCAN_TX_FQ_SIZEn(n)          ( (eXCAN_Registers)(RegXCAN_TX_FQ_SIZE0      + ((uint16_t)(n) * 0x10u)) ) //!< TX FIFO Queue n Size register
+
+//! RX FIFO Queue n registers (n = 0 to 7)
+#define RegXCAN_RX_FQ_ADD_PTn(n)        ( (eXCAN_Registers)(RegXCAN_RX_FQ_ADD_PT0       + ((uint16_t)(n) * 0x18u)) ) //!< RX FIFO Queue n Current Address Pointer
+#define RegXCAN_RX_FQ_START_ADDn(n)     ( (eXCAN_Registers)(RegXCAN_RX_FQ_START_ADD0    + ((uint16_t)(n) * 0x18u)) ) //!< RX FIFO Queue n link list Start Address
+#define RegXCAN_RX_FQ_SIZEn(n)          ( (eXCAN_Registers)(RegXCAN_RX_FQ_SIZE0         + ((uint16_t)(n) * 0x18u)) ) //!< RX FIFO Queue n link list and data container Size
+#define RegXCAN_RX_FQ_DC_START_ADDn(n)  ( (eXCAN_Registers)(RegXCAN_RX_FQ_DC_START_ADD0 + ((uint16_t)(n) * 0x18u)) ) //!< RX FIFO Queue n Data Container Start Address
+#define RegXCAN_RX_FQ_RD_ADD_PTn(n)     ( (eXCAN_Registers)(RegXCAN_RX_FQ_RD_ADD_PT0    + ((uint16_t)(n) * 0x18u)) ) //!< RX FIFO Queue n Read Address Pointer
+
+//! TX Filter Reference Value n registers (n = 0 to 3)
+#define RegXCAN_TX_FILTER_REFVALn(n)    ( (eXCAN_Registers)(RegXCAN_TX_FILTER_REFVAL0   + ((uint16_t)(n) * 0x4u)) ) //!< TX Filter Reference Value register n
+
 
 
 
@@ -1148,7 +1193,7 @@ typedef enum
 
 #define XCAN_MH_SFTY_CFG_PRESCALER_Pos         30
 #define XCAN_MH_SFTY_CFG_PRESCALER_Mask        (3 << XCAN_MH_SFTY_CFG_PRESCALER_Pos)
-#define XCAN_MH_SFTY_CFG_PRESCALER_GET(value)  (eXCAN_Prescaler)((uint32_t)(value) & XCAN_MH_SFTY_CFG_PRESCALER_Mask) >> XCAN_MH_SFTY_CFG_PRESCALER_Pos) //!< Get prescaler used to generate the timer ticks for the watchdogs
+#define XCAN_MH_SFTY_CFG_PRESCALER_GET(value)  (eXCAN_Prescaler)(((uint32_t)(value) & XCAN_MH_SFTY_CFG_PRESCALER_Mask) >> XCAN_MH_SFTY_CFG_PRESCALER_Pos) //!< Get prescaler used to generate the timer ticks for the watchdogs
 #define XCAN_MH_SFTY_CFG_PRESCALER_SET(value)  (((uint32_t)(value) << XCAN_MH_SFTY_CFG_PRESCALER_Pos) & XCAN_MH_SFTY_CFG_PRESCALER_Mask) //!< Set prescaler used to generate the timer ticks for the watchdogs
 
 //-----------------------------------------------------------------------------
@@ -1158,9 +1203,9 @@ typedef enum
  * This register is protected by a register bank CRC defined in CRC_REG register
  */
 XCAN_PACKITEM
-typedef union __XCAN_PACKED__ XCAN_RX_FILTER_MEM_ADD_Register
+typedef union __XCAN_PACKED__ XCAN_MH_SFTY_CTRL_Register
 {
-  uint32_t RX_FILTER_MEM_ADD;
+  uint32_t MH_SFTY_CTRL;
   uint8_t Bytes[sizeof(uint32_t)];
   struct
   {
@@ -1175,11 +1220,11 @@ typedef union __XCAN_PACKED__ XCAN_RX_FILTER_MEM_ADD_Register
     uint32_t DMA_TO_EN      :  1; //!<  8    - When set to 1, the watchdog for the DMA_AXI interface is enabled, otherwise disabled. This bit field register is only accessible in write mode if the MH is not started, see MH_CTRL.START = 0
     uint32_t MEM_TO_EN      :  1; //!<  9    - When set to 1, the watchdog for the MEM_AXI interface is enabled, otherwise disabled. This bit field register is only accessible in write mode if the MH is not started, see MH_CTRL.START = 0
     uint32_t PRT_TO_EN      :  1; //!< 10    - When set to 1, the watchdogs for the internal RX_MSG and TX_MSG interfaces are enabled, otherwise disabled. This bit field register is only accessible in write mode if the MH is not started, see MH_CTRL.START = 0
-    uint32_t                : 21; //!< 16-31
+    uint32_t                : 21; //!< 11-31
   } Bits;
-} XCAN_RX_FILTER_MEM_ADD_Register;
+} XCAN_MH_SFTY_CTRL_Register;
 XCAN_UNPACKITEM;
-XCAN_CONTROL_ITEM_SIZE(XCAN_RX_FILTER_MEM_ADD_Register, 4);
+XCAN_CONTROL_ITEM_SIZE(XCAN_MH_SFTY_CTRL_Register, 4);
 
 #define XCAN_RX_FILTER_MEM_ADD_CRC_CHECK_TX_DESC_EN         (1u <<  0) //!< CRC check for the TX descriptors is enabled
 #define XCAN_RX_FILTER_MEM_ADD_CRC_CHECK_RX_DESC_EN         (1u <<  1) //!< CRC check for the RX descriptors is enabled
@@ -1277,7 +1322,7 @@ XCAN_CONTROL_ITEM_SIZE(XCAN_AXI_ADD_EXT_Register, 4);
 #define XCAN_AXI_ADD_EXT_Pos         0
 #define XCAN_AXI_ADD_EXT_Mask        (0xFFFFFFFFu << XCAN_AXI_ADD_EXT_Pos)
 #define XCAN_AXI_ADD_EXT_GET(value)  (((uint32_t)(value) & XCAN_AXI_ADD_EXT_Mask) >> XCAN_AXI_ADD_EXT_Pos) //!< Get the MSB of the read/write AXI address bus used on the DMA_AXI interface
-#define XCAN_AXI_ADD_EXT_GET(value)  (((uint32_t)(value) << XCAN_AXI_ADD_EXT_Pos) & XCAN_AXI_ADD_EXT_Mask) //!< Get the MSB of the read/write AXI address bus used on the DMA_AXI interface
+#define XCAN_AXI_ADD_EXT_SET(value)  (((uint32_t)(value) << XCAN_AXI_ADD_EXT_Pos) & XCAN_AXI_ADD_EXT_Mask) //!< Set the MSB of the read/write AXI address bus used on the DMA_AXI interface
 
 //-----------------------------------------------------------------------------
 
@@ -1616,9 +1661,9 @@ XCAN_UNPACKITEM;
 XCAN_CONTROL_ITEM_SIZE(XCAN_TX_FQ_SIZE_Register, 4);
 
 #define XCAN_TX_FQ_SIZE_MAX_DESC_Pos         0
-#define XCAN_TX_FQ_SIZE_MAX_DESC_Mask        (0x3Fu << XCAN_RX_FQ_SIZE_MAX_DESC_Pos)
-#define XCAN_TX_FQ_SIZE_MAX_DESC_GET(value)  (((uint32_t)(value) & XCAN_RX_FQ_SIZE_MAX_DESC_Mask) >> XCAN_RX_FQ_SIZE_MAX_DESC_Pos) //!< Get the maximum number of TX descriptors in the TX FIFO Queue link list descriptors
-#define XCAN_TX_FQ_SIZE_MAX_DESC_SET(value)  (((uint32_t)(value) << XCAN_RX_FQ_SIZE_MAX_DESC_Pos) & XCAN_RX_FQ_SIZE_MAX_DESC_Mask) //!< Set the maximum number of TX descriptors in the TX FIFO Queue link list descriptors
+#define XCAN_TX_FQ_SIZE_MAX_DESC_Mask        (0x3FFu << XCAN_TX_FQ_SIZE_MAX_DESC_Pos)
+#define XCAN_TX_FQ_SIZE_MAX_DESC_GET(value)  (((uint32_t)(value) & XCAN_TX_FQ_SIZE_MAX_DESC_Mask) >> XCAN_TX_FQ_SIZE_MAX_DESC_Pos) //!< Get the maximum number of TX descriptors in the TX FIFO Queue link list descriptors
+#define XCAN_TX_FQ_SIZE_MAX_DESC_SET(value)  (((uint32_t)(value) << XCAN_TX_FQ_SIZE_MAX_DESC_Pos) & XCAN_TX_FQ_SIZE_MAX_DESC_Mask) //!< Set the maximum number of TX descriptors in the TX FIFO Queue link list descriptors
 
 //-----------------------------------------------------------------------------
 
@@ -1634,9 +1679,13 @@ typedef union __XCAN_PACKED__ XCAN_TX_PQ_STS0_Register
 XCAN_UNPACKITEM;
 XCAN_CONTROL_ITEM_SIZE(XCAN_TX_PQ_STS0_Register, 4);
 
-#define XCAN_TX_PQ_STS0_SENT_Pos         0
-#define XCAN_TX_PQ_STS0_SENT_Mask        (0xFFFFFFFFu << XCAN_TX_PQ_STS0_SENT_Pos)
-#define XCAN_TX_PQ_STS0_SENT_GET(value)  (((uint32_t)(value) & XCAN_TX_PQ_STS0_SENT_Mask) >> XCAN_TX_PQ_STS0_SENT_Pos) //!< Get the TX Priority Queue slot n busy
+#define XCAN_TX_PQ_STS0_BUSY_Pos         0
+#define XCAN_TX_PQ_STS0_BUSY_Mask        (0xFFFFFFFFu << XCAN_TX_PQ_STS0_BUSY_Pos)
+#define XCAN_TX_PQ_STS0_BUSY_GET(value)  (((uint32_t)(value) & XCAN_TX_PQ_STS0_BUSY_Mask) >> XCAN_TX_PQ_STS0_BUSY_Pos) //!< Get the TX Priority Queue slot n busy
+//! @deprecated The STS0 field was wrongly named SENT (the SENT field is in TX_PQ_STS1), use XCAN_TX_PQ_STS0_BUSY_* instead. Kept as aliases for compatibility
+#define XCAN_TX_PQ_STS0_SENT_Pos         XCAN_TX_PQ_STS0_BUSY_Pos
+#define XCAN_TX_PQ_STS0_SENT_Mask        XCAN_TX_PQ_STS0_BUSY_Mask
+#define XCAN_TX_PQ_STS0_SENT_GET(value)  XCAN_TX_PQ_STS0_BUSY_GET(value)
 
 //-----------------------------------------------------------------------------
 
@@ -2027,7 +2076,7 @@ typedef union __XCAN_PACKED__ XCAN_RX_FQ_SIZE_Register
                             *           The size to be allocated to the link list must be equal to MAX_DESC * 16bytes for MAX_DESC >= 1.
                             *           This register is only accessible in write mode if the RX FIFO Queue 0 is not busy, see BUSY flag in RX_FQ_STS0 register
                             */
-    uint32_t         :  8; //!< 10-15
+    uint32_t         :  6; //!< 10-15
     uint32_t DC_SIZE : 12; /*!< 16-27 - In Normal mode only the DC_SIZE[6:0] is used to define the maximum size of an RX data container for the RX FIFO Queue.
                             *           The data container size is DC_SIZE[6:0] * 32bytes and one is attached to every RX descriptor.
                             *           In continuous mode, it defines the size of the single data container used to write all RX messages. The overall data container size is DC_SIZE[11:0] * 32bytes for MAX_DESC > = 1.
@@ -2040,7 +2089,7 @@ XCAN_UNPACKITEM;
 XCAN_CONTROL_ITEM_SIZE(XCAN_RX_FQ_SIZE_Register, 4);
 
 #define XCAN_RX_FQ_SIZE_MAX_DESC_Pos         0
-#define XCAN_RX_FQ_SIZE_MAX_DESC_Mask        (0x3Fu << XCAN_RX_FQ_SIZE_MAX_DESC_Pos)
+#define XCAN_RX_FQ_SIZE_MAX_DESC_Mask        (0x3FFu << XCAN_RX_FQ_SIZE_MAX_DESC_Pos)
 #define XCAN_RX_FQ_SIZE_MAX_DESC_GET(value)  (((uint32_t)(value) & XCAN_RX_FQ_SIZE_MAX_DESC_Mask) >> XCAN_RX_FQ_SIZE_MAX_DESC_Pos) //!< Get the maximum number of descriptors in the RX FIFO Queue link list
 #define XCAN_RX_FQ_SIZE_MAX_DESC_SET(value)  (((uint32_t)(value) << XCAN_RX_FQ_SIZE_MAX_DESC_Pos) & XCAN_RX_FQ_SIZE_MAX_DESC_Mask) //!< Set the maximum number of descriptors in the RX FIFO Queue link list
 #define XCAN_RX_FQ_SIZE_DC_SIZE_Pos          16
@@ -2110,6 +2159,7 @@ XCAN_CONTROL_ITEM_SIZE(XCAN_RX_FQ_RD_ADD_PT_Register, 4);
 #define XCAN_RX_FQ_RD_ADD_PT_Mask        (0xFFFFFFFCu << XCAN_RX_FQ_RD_ADD_PT_Pos)
 #define XCAN_RX_FQ_RD_ADD_PT_GET(value)  (((uint32_t)(value) & XCAN_RX_FQ_RD_ADD_PT_Mask) >> XCAN_RX_FQ_RD_ADD_PT_Pos) //!< Get the Data Read Address of the RX message being read to the MH
 #define XCAN_RX_FQ_RD_ADD_PT_SET(value)  (((uint32_t)(value) << XCAN_RX_FQ_RD_ADD_PT_Pos) & XCAN_RX_FQ_RD_ADD_PT_Mask) //!< Set the Data Read Address of the RX message being read to the MH
+#define XCAN_RX_FQ_RD_ADD_PT_VAL_INITIAL   (0x3u) //!< VAL[1:0] value mandatory for the initial start of the RX FIFO Queue
 
 //-----------------------------------------------------------------------------
 
@@ -2124,10 +2174,10 @@ typedef union __XCAN_PACKED__ XCAN_TX_FILTER_CTRL0_Register
   uint8_t Bytes[sizeof(uint32_t)];
   struct
   {
-    uint32_t COMB  :  8; /*!<  0-15 - When COMB[n] =1 the comparison attached to the reference values (REF_VAL0 and REF_VAL1) or (REF_VAL2 and REF_VAL3) are required to accept a TX message.
+    uint32_t COMB  :  8; /*!<  0- 7 - When COMB[n] =1 the comparison attached to the reference values (REF_VAL0 and REF_VAL1) or (REF_VAL2 and REF_VAL3) are required to accept a TX message.
                           *           This bit field register is only accessible in write mode if the MH is not busy, see BUSY flag in MH_STS register
                           */
-    uint32_t MASK  :  8; /*!< 16-31 - When MASK[n] =1 the reference values REF_VAL0/1 or REF_VAL2/3 are combined to define a value (REF_VAL0 or REF_VAL2) and a mask (REF_VAL1 or REF_VAL3).
+    uint32_t MASK  :  8; /*!<  8-15 - When MASK[n] =1 the reference values REF_VAL0/1 or REF_VAL2/3 are combined to define a value (REF_VAL0 or REF_VAL2) and a mask (REF_VAL1 or REF_VAL3).
                           *           Otherwise, the comparison uses the REF_VAL0/1/2/3 bit field as reference value only.
                           *           This bit field register is only accessible in write mode if the MH is not busy, see BUSY flag in MH_STS register
                           */
@@ -2152,11 +2202,11 @@ XCAN_CONTROL_ITEM_SIZE(XCAN_TX_FILTER_CTRL0_Register, 4);
 #define XCAN_TX_FILTER_CTRL0_MASK_Mask          (0xFFu << XCAN_TX_FILTER_CTRL0_MASK_Pos)
 #define XCAN_TX_FILTER_CTRL0_MASK_GET(value)    (((uint32_t)(value) & XCAN_TX_FILTER_CTRL0_MASK_Mask) >> XCAN_TX_FILTER_CTRL0_MASK_Pos) //!< Get the reference values REF_VAL0/1 or REF_VAL2/3 are combined to define a value and a mask
 #define XCAN_TX_FILTER_CTRL0_MASK_SET(value)    (((uint32_t)(value) << XCAN_TX_FILTER_CTRL0_MASK_Pos) & XCAN_TX_FILTER_CTRL0_MASK_Mask) //!< Set the reference values REF_VAL0/1 or REF_VAL2/3 are combined to define a value and a mask
-#define XCAN_RX_FILTER_CTRL0_ACCEPT_ON_MATCH    (1u << 16) //!< Accept on match
-#define XCAN_RX_FILTER_CTRL0_REJECT_CANFD_MSG   (1u << 17) //!< Reject CAN-FD messages
-#define XCAN_RX_FILTER_CTRL0_REJECT_CAN20_MSG   (1u << 18) //!< Reject Classic CAN messages
-#define XCAN_RX_FILTER_CTRL0_ENABLE_TX_FILTER   (1u << 19) //!< Enable the TX filter for all TX message to be sent
-#define XCAN_RX_FILTER_CTRL0_ENABLE_FILTER_INT  (1u << 20) //!< Enable the interrupt tx_filter_irq to be triggered
+#define XCAN_TX_FILTER_CTRL0_ACCEPT_ON_MATCH    (1u << 16) //!< Accept on match
+#define XCAN_TX_FILTER_CTRL0_REJECT_CANFD_MSG   (1u << 17) //!< Reject CAN-FD messages
+#define XCAN_TX_FILTER_CTRL0_REJECT_CAN20_MSG   (1u << 18) //!< Reject Classic CAN messages
+#define XCAN_TX_FILTER_CTRL0_ENABLE_TX_FILTER   (1u << 19) //!< Enable the TX filter for all TX message to be sent
+#define XCAN_TX_FILTER_CTRL0_ENABLE_FILTER_INT  (1u << 20) //!< Enable the interrupt tx_filter_irq to be triggered
 
 //-----------------------------------------------------------------------------
 
@@ -2221,7 +2271,7 @@ typedef union __XCAN_PACKED__ XCAN_TX_FILTER_REFVAL_Register
     uint32_t REF_VAL0: 8; //!<  0- 7 - Define the reference value 0. This bit field register is only accessible in write mode if the MH is not busy, see BUSY flag in MH_STS register
     uint32_t REF_VAL1: 8; //!<  8-15 - Define the reference value 1. This bit field register is only accessible in write mode if the MH is not busy, see BUSY flag in MH_STS register
     uint32_t REF_VAL2: 8; //!< 16-23 - Define the reference value 2. This bit field register is only accessible in write mode if the MH is not busy, see BUSY flag in MH_STS register
-    uint32_t REF_VAL3: 8; //!< 54-31 - Define the reference value 3. This bit field register is only accessible in write mode if the MH is not busy, see BUSY flag in MH_STS register
+    uint32_t REF_VAL3: 8; //!< 24-31 - Define the reference value 3. This bit field register is only accessible in write mode if the MH is not busy, see BUSY flag in MH_STS register
   } Bits;
 } XCAN_TX_FILTER_REFVAL_Register;
 XCAN_UNPACKITEM;
@@ -2241,8 +2291,8 @@ XCAN_CONTROL_ITEM_SIZE(XCAN_TX_FILTER_REFVAL_Register, 4);
 #define XCAN_TX_FILTER_REFVAL2_SET(value)  (((uint32_t)(value) << XCAN_TX_FILTER_REFVAL2_Pos) & XCAN_TX_FILTER_REFVAL2_Mask) //!< Set the reference value 2
 #define XCAN_TX_FILTER_REFVAL3_Pos         24
 #define XCAN_TX_FILTER_REFVAL3_Mask        (0xFFu << XCAN_TX_FILTER_REFVAL3_Pos)
-#define XCAN_TX_FILTER_REFVAL3_GET(value)  ((uint32_t)(value) & XCAN_TX_FILTER_REFVAL3_Mask) >> XCAN_TX_FILTER_REFVAL3_Pos) //!< Get the reference value 3
-#define XCAN_TX_FILTER_REFVAL3_SET(value)  ((uint32_t)(value) << XCAN_TX_FILTER_REFVAL3_Pos) & XCAN_TX_FILTER_REFVAL3_Mask) //!< Set the reference value 3
+#define XCAN_TX_FILTER_REFVAL3_GET(value)  (((uint32_t)(value) & XCAN_TX_FILTER_REFVAL3_Mask) >> XCAN_TX_FILTER_REFVAL3_Pos) //!< Get the reference value 3
+#define XCAN_TX_FILTER_REFVAL3_SET(value)  (((uint32_t)(value) << XCAN_TX_FILTER_REFVAL3_Pos) & XCAN_TX_FILTER_REFVAL3_Mask) //!< Set the reference value 3
 
 //-----------------------------------------------------------------------------
 
@@ -3784,9 +3834,9 @@ typedef union __XCAN_PACKED__ XCAN_IC_FR_Register
     uint32_t PRT_RX_EVT      : 1; //!< 27    - PRT received a valid CAN message: '1' = Interrupt event
     uint32_t                 : 3; //!< 28-31
   } Bits;
-} XCAN_IC_FC_Register;
+} XCAN_IC_FR_Register;
 XCAN_UNPACKITEM;
-XCAN_CONTROL_ITEM_SIZE(XCAN_IC_FC_Register, 4);
+XCAN_CONTROL_ITEM_SIZE(XCAN_IC_FR_Register, 4);
 
 #define XCAN_IC_FR_MH_TX_FQ0_IRQ_EVENT     (1u <<  0) //!< Event MH interrupt of the TX FIFO Queue 0 interrupt
 #define XCAN_IC_FR_MH_TX_FQ1_IRQ_EVENT     (1u <<  1) //!< Event MH interrupt of the TX FIFO Queue 1 interrupt